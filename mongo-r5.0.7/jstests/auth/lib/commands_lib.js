@@ -307,6 +307,33 @@ var authCommandsLib = {
           }]
         },
 
+        {
+          testname: "analyze",
+          command: {analyze: "x"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.x.save({}));
+          },
+          teardown: function(db) {
+              db.x.drop();
+              db.getCollection("system.statistics.x").drop();
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+          ]
+        },
+
         {
           testname: "applyOps_empty",
           command: {applyOps: []},
@@ -0,0 +1,114 @@
+/**
+ * Tests that version 4 text indexes, which also store term positions, return the same results as
+ * version 3 text indexes for phrase queries, while skipping the documents whose term positions do
+ * not contain the phrases.
+ * @tags: [
+ *   assumes_read_concern_local,
+ *   assumes_unsharded_collection,
+ *   featureFlagTextIndexPositions,
+ *   requires_fcv_50,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
+
+const collV3 = db.fts_index_version4_v3;
+const collV4 = db.fts_index_version4_v4;
+collV3.drop();
+collV4.drop();
+
+const docs = [
+    {_id: 0, a: "the quick brown fox jumps over the lazy dog"},
+    {_id: 1, a: "the brown quick fox", b: "lazy dog"},
+    {_id: 2, a: "quick brown", b: "fox jumps"},
+    {_id: 3, a: ["a lazy cat", "the quick brown foxes"]},
+    {_id: 4, a: "Jumping over the lazy dogs is quick work for a brown fox"},
+    {_id: 5, a: "dog lazy the over jumps fox brown quick the"},
+    {_id: 6, a: "over the lazy dog, over the lazy dog"},
+];
+for (let i = 7; i < 200; ++i) {
+    docs.push({_id: i, a: "quick fox number " + i, b: "brown dog"});
+}
+assert.commandWorked(collV3.insert(docs));
+assert.commandWorked(collV4.insert(docs));
+assert.commandWorked(collV3.createIndex({a: "text", b: "text"}, {textIndexVersion: 3}));
+assert.commandWorked(collV4.createIndex({a: "text", b: "text"}, {textIndexVersion: 4}));
+
+function queryIds(coll, search) {
+    return coll.find({$text: {$search: search}}, {_id: 1})
+        .sort({_id: 1})
+        .toArray()
+        .map(doc => doc._id);
+}
+
+for (let search of ["\"quick brown\"",
+                    "\"brown fox\"",
+                    "\"quick brown fox\" dog",
+                    "\"over the lazy dog\"",
+                    "\"the lazy\"",
+                    "\"lazy dog\" \"quick brown\"",
+                    "\"brown dog\"",
+                    "\"fox jumps\"",
+                    "\"quick fox\" -\"brown fox\"",
+                    "\"the\" fox",
+                    "\"lazy cat the quick\""]) {
+    assert.eq(queryIds(collV3, search), queryIds(collV4, search), search);
+}
+
+// The terms of a phrase must be in consecutive positions of the same string.
+assert.eq([], queryIds(collV4, "\"dog fox\""));
+assert.eq([], queryIds(collV4, "\"brown fox jumps\" \"missing\""));
+
+// The terms of documents in a language other than the default language of the index are stemmed
+// differently from those of the query, so such documents are never rejected by their positions.
+const langCollV3 = db.fts_index_version4_language_v3;
+const langCollV4 = db.fts_index_version4_language_v4;
+langCollV3.drop();
+langCollV4.drop();
+const langDocs = [
+    {_id: 0, a: "he was running quickly home", language: "none"},
+    {_id: 1, a: "he was running quickly home"},
+    {_id: 2, a: "he was walking quickly home"},
+    {_id: 3, a: "corría rápidamente a casa", language: "spanish"},
+];
+assert.commandWorked(langCollV3.insert(langDocs));
+assert.commandWorked(langCollV4.insert(langDocs));
+assert.commandWorked(langCollV3.createIndex({a: "text"}, {textIndexVersion: 3}));
+assert.commandWorked(langCollV4.createIndex({a: "text"}, {textIndexVersion: 4}));
+
+function queryIdsInLanguage(coll, search, language) {
+    return coll.find({$text: {$search: search, $language: language}}, {_id: 1})
+        .sort({_id: 1})
+        .toArray()
+        .map(doc => doc._id);
+}
+
+for (let [search, language] of [["\"was running quickly\" home", "english"],
+                                ["\"was running quickly\" home", "none"],
+                                ["\"he was running\"", "none"],
+                                ["\"corría rápidamente a\" casa", "spanish"],
+                                ["\"corría rápidamente a\" casa", "english"]]) {
+    assert.eq(queryIdsInLanguage(langCollV3, search, language),
+              queryIdsInLanguage(langCollV4, search, language),
+              {search: search, language: language});
+}
+assert.eq([0, 1], queryIdsInLanguage(langCollV4, "\"was running quickly\" home", "english"));
+
+// The slot-based engine evaluates TEXT_OR as a plain OR and does not check positions.
+if (checkSBEEnabled(db)) {
+    return;
+}
+
+// Only the documents that contain the inner words of the phrase are fetched. The first and last
+// words may be parts of longer words, such as "10" for "1", so they are not checked.
+const explain =
+    collV4.find({$text: {$search: "\"quick fox number 1\""}}).explain("executionStats");
+assert.eq(111, explain.executionStats.nReturned, explain);
+const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert.eq(193, textOr.docsExamined, textOr);
+assert.eq(6, textOr.docsRejectedByPhrase, textOr);
+})();
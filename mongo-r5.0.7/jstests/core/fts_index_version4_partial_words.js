@@ -0,0 +1,57 @@
+/**
+ * Tests that version 4 text indexes return the same results as version 3 text indexes for phrases
+ * whose first or last words only match parts of the words of a document.
+ * @tags: [
+ *   assumes_read_concern_local,
+ *   assumes_unsharded_collection,
+ *   featureFlagTextIndexPositions,
+ *   requires_fcv_50,
+ * ]
+ */
+(function() {
+"use strict";
+
+const collV3 = db.fts_index_version4_partial_words_v3;
+const collV4 = db.fts_index_version4_partial_words_v4;
+collV3.drop();
+collV4.drop();
+
+const docs = [
+    {_id: 0, a: "the cat sat on the mat"},
+    {_id: 1, a: "a bobcat sat on a doormat"},
+    {_id: 2, a: "the cat saturated the mat"},
+    {_id: 3, a: "bobcats sat on mats"},
+    {_id: 4, a: "The CAT Sat on the Matting"},
+    {_id: 5, a: "the cat, sat on the mat"},
+    {_id: 6, a: ["the bob", "cat sat"]},
+    {_id: 7, a: "concatenated satellites on the mat"},
+];
+assert.commandWorked(collV3.insert(docs));
+assert.commandWorked(collV4.insert(docs));
+assert.commandWorked(collV3.createIndex({a: "text"}, {textIndexVersion: 3}));
+assert.commandWorked(collV4.createIndex({a: "text"}, {textIndexVersion: 4}));
+
+function queryIds(coll, search) {
+    return coll.find({$text: {$search: search}}, {_id: 1})
+        .sort({_id: 1})
+        .toArray()
+        .map(doc => doc._id);
+}
+
+for (let search of ["\"cat sat\"",
+                    "\"cat sat on\"",
+                    "\"cat sat on the mat\"",
+                    "\"at sat on the ma\"",
+                    "\"cat sat on a\" doormat",
+                    "\"t sat on\"",
+                    "\"sat on the\" \"cat sat\"",
+                    "\"cat sat\" -\"bobcat\"",
+                    "\"at\"",
+                    "\"bob cat\""]) {
+    assert.eq(queryIds(collV3, search), queryIds(collV4, search), search);
+}
+
+// Documents in which the first or last word of a phrase is part of a longer word still match.
+assert.eq([0, 1, 4], queryIds(collV4, "\"cat sat on\""));
+assert.eq([0, 4], queryIds(collV4, "\"cat sat on the mat\""));
+})();
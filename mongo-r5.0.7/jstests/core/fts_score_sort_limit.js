@@ -0,0 +1,95 @@
+/**
+ * Tests that a $text query sorted by text score with a limit returns the same top scoring documents,
+ * with the same scores, as the unlimited query, while the TEXT_OR stage only reads the postings it
+ * needs.
+ * @tags: [
+ *   assumes_read_concern_local,
+ *   assumes_unsharded_collection,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
+
+const coll = db.fts_score_sort_limit;
+coll.drop();
+
+const words = ["alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"];
+const docs = [];
+for (let i = 0; i < 1000; ++i) {
+    // Vary both the number of distinct words and their frequencies across documents.
+    const text = [];
+    for (let j = 0; j < words.length; ++j) {
+        const repeat = (i * (j + 3) + j) % 7;
+        for (let k = 0; k < repeat; ++k) {
+            text.push(words[j]);
+        }
+    }
+    text.push("filler" + i);
+    docs.push({_id: i, body: text.join(" "), other: "padding text " + (i % 13)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({body: "text", other: "text"}, {weights: {body: 5}}));
+
+function runQuery(search, limit, skip) {
+    let cursor = coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+                     .sort({score: {$meta: "textScore"}});
+    if (skip) {
+        cursor = cursor.skip(skip);
+    }
+    if (limit) {
+        cursor = cursor.limit(limit);
+    }
+    return cursor.toArray();
+}
+
+function assertSameTopScores(search, limit, skip) {
+    const all = runQuery(search);
+    const scoreById = {};
+    all.forEach(doc => {
+        scoreById[doc._id] = doc.score;
+    });
+
+    const top = runQuery(search, limit, skip);
+    const expectedScores = all.slice(skip || 0, (skip || 0) + limit).map(doc => doc.score);
+    assert.eq(expectedScores, top.map(doc => doc.score), {search, limit, skip});
+    top.forEach(doc => assert.eq(scoreById[doc._id], doc.score, {search, doc}));
+}
+
+for (let search of ["alpha", "alpha bravo", "charlie delta echo", "golf hotel padding", "filler7"]) {
+    for (let limit of [1, 5, 20, 200]) {
+        assertSameTopScores(search, limit);
+    }
+    assertSameTopScores(search, 10, 15);
+}
+
+// The slot-based engine evaluates TEXT_OR as a plain OR and does not use the limit.
+if (checkSBEEnabled(db)) {
+    return;
+}
+
+// The limit is pushed down to the TEXT_OR stage, which stops before reading every posting.
+let explain = coll.find({$text: {$search: "alpha bravo charlie"}}, {score: {$meta: "textScore"}})
+                  .sort({score: {$meta: "textScore"}})
+                  .limit(5)
+                  .explain("executionStats");
+let textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert.eq(5, textOr.limitAmount, textOr);
+assert(textOr.stoppedEarly, textOr);
+assert.lt(textOr.docsExamined, coll.count(), textOr);
+
+// Negated terms and phrases are checked after scoring, so the limit is not pushed down for them.
+for (let search of ["alpha -bravo", "\"alpha alpha\" bravo"]) {
+    explain = coll.find({$text: {$search: search}}, {score: {$meta: "textScore"}})
+                  .sort({score: {$meta: "textScore"}})
+                  .limit(5)
+                  .explain("executionStats");
+    textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, explain);
+    assert(!textOr.hasOwnProperty("limitAmount"), textOr);
+    assertSameTopScores(search, 5);
+}
+})();
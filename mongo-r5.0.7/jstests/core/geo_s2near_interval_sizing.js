@@ -0,0 +1,59 @@
+/**
+ * Tests that a 2dsphere $geoNear search returns the documents in distance order when the annuli it
+ * scans are sized from the density of the results, across a dense cluster, a sparse gap and a
+ * second dense cluster.
+ * @tags: [
+ *   assumes_read_concern_local,
+ *   assumes_unsharded_collection,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const coll = db.geo_s2near_interval_sizing;
+coll.drop();
+
+const docs = [];
+let id = 0;
+// A dense cluster around the origin and a second one about 500 km away.
+for (let center of [[0, 0], [4.5, 0]]) {
+    for (let i = 0; i < 40; ++i) {
+        for (let j = 0; j < 40; ++j) {
+            const coordinates = [center[0] + i * 0.001, center[1] + j * 0.001];
+            docs.push({_id: id++, loc: {type: "Point", coordinates: coordinates}});
+        }
+    }
+}
+// A few isolated points in between.
+for (let i = 1; i < 10; ++i) {
+    docs.push({_id: id++, loc: {type: "Point", coordinates: [i * 0.4, 0.5]}});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+const results = coll.aggregate([
+                        {
+                            $geoNear: {
+                                near: {type: "Point", coordinates: [0.02, 0.02]},
+                                distanceField: "dist",
+                                spherical: true,
+                            }
+                        },
+                        {$project: {dist: 1}}
+                    ])
+                    .toArray();
+assert.eq(docs.length, results.length);
+for (let i = 1; i < results.length; ++i) {
+    assert.lte(results[i - 1].dist, results[i].dist, {prev: results[i - 1], next: results[i]});
+}
+
+// The search takes few passes, even to cross the sparse area between the clusters.
+const explain = coll.find({loc: {$near: {$geometry: {type: "Point", coordinates: [0.02, 0.02]}}}})
+                    .explain("executionStats");
+assert.eq(docs.length, explain.executionStats.nReturned, explain);
+const nearStage = getPlanStage(explain.executionStats.executionStages, "GEO_NEAR_2DSPHERE");
+assert.neq(null, nearStage, explain);
+assert.lt(nearStage.inputStages.length, docs.length / 10, nearStage);
+})();
@@ -0,0 +1,43 @@
+/**
+ * Tests that a compound index can be skip-scanned to answer a query with no predicate on the
+ * leading field of the index.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan and getPlanStage.
+
+const coll = db.index_skip_scan;
+coll.drop();
+
+const kNumTenants = 5;
+const kDocsPerTenant = 1000;
+const docs = [];
+for (let tenant = 0; tenant < kNumTenants; ++tenant) {
+    for (let i = 0; i < kDocsPerTenant; ++i) {
+        docs.push({tenant: tenant, status: i % 100 === 0 ? "failed" : "ok", i: i});
+    }
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({tenant: 1, status: 1}));
+
+const expectedCount = kNumTenants * kDocsPerTenant / 100;
+assert.eq(expectedCount, coll.find({status: "failed"}).itcount());
+assert.eq(expectedCount, coll.find({status: {$lt: "ok"}}).itcount());
+assert.eq(kNumTenants * kDocsPerTenant - expectedCount, coll.find({status: "ok"}).itcount());
+
+// The winning plan seeks from each tenant to its failed documents rather than scanning the whole
+// index or collection.
+const explain = coll.find({status: "failed"}).explain("executionStats");
+const ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert.neq(null, ixscan, explain);
+assert.eq({tenant: 1, status: 1}, ixscan.keyPattern, explain);
+assert.eq(["[MinKey, MaxKey]"], ixscan.indexBounds.tenant, explain);
+assert.eq(['["failed", "failed"]'], ixscan.indexBounds.status, explain);
+assert.eq(expectedCount, explain.executionStats.nReturned, explain);
+assert.lt(explain.executionStats.totalKeysExamined, 2 * expectedCount + 2 * kNumTenants, explain);
+})();
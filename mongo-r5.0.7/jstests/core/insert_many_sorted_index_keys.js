@@ -0,0 +1,73 @@
+/**
+ * Multi-document inserts may generate the keys of a whole batch and insert them into each index in
+ * key order. Verifies that indexes, multikey metadata and duplicate key errors are unaffected.
+ *
+ * @tags: [
+ *   assumes_unsharded_collection,
+ *   requires_fastcount,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStages.
+
+const coll = db.insert_many_sorted_index_keys;
+coll.drop();
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: -1, c: 1}));
+assert.commandWorked(coll.createIndex({"arr.x": 1}));
+assert.commandWorked(coll.createIndex({"w.$**": 1}));
+assert.commandWorked(coll.createIndex({u: 1}, {unique: true, sparse: true}));
+assert.commandWorked(coll.createIndex({p: 1}, {partialFilterExpression: {q: {$exists: true}}}));
+
+const numDocs = 500;
+let docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    // Insert the documents in an order unrelated to the order of their keys.
+    const v = (i * 7919) % numDocs;
+    let doc = {_id: i, a: v, b: numDocs - v, c: i % 10, w: {k: v}, p: v};
+    if (i % 50 === 0) {
+        doc.arr = [{x: v}, {x: v + 1}];
+    } else {
+        doc.arr = {x: v};
+    }
+    if (i % 2 === 0) {
+        doc.q = 1;
+    }
+    doc.u = i;
+    docs.push(doc);
+}
+assert.commandWorked(coll.insertMany(docs));
+assert.eq(numDocs, coll.count());
+
+const all = coll.find().sort({_id: 1}).toArray();
+for (let keyPattern of [{a: 1}, {b: -1, c: 1}, {"arr.x": 1}, {u: 1}]) {
+    assert.eq(all, coll.find().sort({_id: 1}).hint(keyPattern).toArray(), keyPattern);
+}
+assert.eq(numDocs, coll.find({"w.k": {$gte: 0}}).hint({"w.$**": 1}).itcount());
+assert.eq(numDocs / 2, coll.find({p: {$gte: 0}, q: {$exists: true}}).hint({p: 1}).itcount());
+
+// Only some of the documents produce several keys for {"arr.x": 1}, which must still make the
+// index multikey.
+const explain = coll.find({"arr.x": {$gte: 0}}).hint({"arr.x": 1}).explain();
+const ixscans = getPlanStages(getWinningPlan(explain.queryPlanner), "IXSCAN");
+assert.gt(ixscans.length, 0, explain);
+assert(ixscans[0].isMultiKey, explain);
+
+// A duplicate within an ordered batch is reported against the offending document, and the
+// documents before it are inserted.
+let dupDocs = [];
+for (let i = 0; i < 10; ++i) {
+    dupDocs.push({_id: numDocs + i, a: i, u: numDocs + (i === 7 ? 3 : i)});
+}
+let res = coll.insert(dupDocs);
+assert.eq(1, res.getWriteErrors().length, tojson(res));
+assert.eq(7, res.getWriteErrors()[0].index, tojson(res));
+assert.eq(ErrorCodes.DuplicateKey, res.getWriteErrors()[0].code, tojson(res));
+assert.eq(numDocs + 7, coll.count());
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+}());
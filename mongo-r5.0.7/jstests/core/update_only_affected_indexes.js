@@ -0,0 +1,95 @@
+/**
+ * Operator-style updates only maintain the indexes whose paths overlap a modified path. Verifies
+ * that every index remains consistent with the documents across updates which touch some, but not
+ * all, of the indexed paths.
+ *
+ * @tags: [
+ *   requires_multi_updates,
+ *   requires_non_retryable_writes,
+ * ]
+ */
+(function() {
+"use strict";
+
+const coll = db.update_only_affected_indexes;
+coll.drop();
+
+const indexes = [
+    {a: 1},
+    {"b.c": 1},
+    {d: 1, "e.f": 1},
+    {"$**": 1},
+];
+for (let keyPattern of indexes) {
+    assert.commandWorked(coll.createIndex(keyPattern));
+}
+assert.commandWorked(
+    coll.createIndex({g: 1}, {name: "g_partial", partialFilterExpression: {h: {$gt: 0}}}));
+assert.commandWorked(coll.createIndex({t: "text"}));
+
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({
+        _id: i,
+        a: i,
+        b: {c: [i, i + 1]},
+        d: i % 3,
+        e: [{f: i}],
+        g: i,
+        h: i % 2,
+        t: "word" + i,
+        unindexed: "x".repeat(100),
+    }));
+}
+
+// Checks that each index holds exactly the keys generated from the current documents, by comparing
+// hinted results against a collection scan.
+function assertIndexesConsistent() {
+    const expected = coll.find().sort({_id: 1}).hint({$natural: 1}).toArray();
+    for (let keyPattern of [{a: 1}, {"b.c": 1}, {d: 1, "e.f": 1}]) {
+        assert.eq(expected, coll.find().sort({_id: 1}).hint(keyPattern).toArray(), keyPattern);
+    }
+    assert.eq(coll.find({h: {$gt: 0}, g: {$gte: 0}}).hint({$natural: 1}).itcount(),
+              coll.find({h: {$gt: 0}, g: {$gte: 0}}).hint("g_partial").itcount());
+    for (let doc of expected) {
+        if (doc.unindexed !== undefined) {
+            const query = {unindexed: doc.unindexed, _id: doc._id};
+            assert.eq(1, coll.find(query).hint({"$**": 1}).itcount(), doc);
+        }
+        assert.eq(1, coll.find({$text: {$search: doc.t}, _id: doc._id}).itcount(), doc);
+    }
+    const res = assert.commandWorked(coll.validate({full: true}));
+    assert(res.valid, tojson(res));
+}
+
+assertIndexesConsistent();
+
+// Updates of an unindexed path, apart from the wildcard index.
+assert.commandWorked(coll.update({}, {$set: {unindexed: "y".repeat(100)}}, {multi: true}));
+assertIndexesConsistent();
+
+// Updates touching a single index each.
+assert.commandWorked(coll.update({}, {$inc: {a: 100}}, {multi: true}));
+assert.commandWorked(coll.update({_id: 1}, {$push: {"b.c": 42}}));
+assert.commandWorked(coll.update({_id: 2}, {$set: {"e.0.f": -1}}));
+assert.commandWorked(coll.update({_id: 3}, {$set: {"e.1.f": 7}}));
+assert.commandWorked(coll.update({_id: 4}, {$set: {t: "replaced"}}));
+assertIndexesConsistent();
+
+// Updates changing partial index membership without touching the indexed field.
+assert.commandWorked(coll.update({h: 0}, {$set: {h: 1}}, {multi: true}));
+assert.commandWorked(coll.update({_id: {$lt: 5}}, {$set: {h: -1}}, {multi: true}));
+assertIndexesConsistent();
+
+// Renames, unsets and array filters.
+assert.commandWorked(coll.update({_id: 5}, {$rename: {a: "z"}}));
+assert.commandWorked(coll.update({_id: 6}, {$unset: {b: ""}}));
+assert.commandWorked(
+    coll.update({_id: 7}, {$set: {"b.c.$[el]": 0}}, {arrayFilters: [{el: {$gte: 0}}]}));
+assert.commandWorked(coll.update({_id: 8, "e.f": 8}, {$set: {"e.$.f": 80}}));
+assertIndexesConsistent();
+
+// Replacement and pipeline updates maintain all indexes.
+assert.commandWorked(coll.update({_id: 9}, {a: 1, d: 2, t: "replacement"}));
+assert.commandWorked(coll.update({_id: 10}, [{$set: {"b.c": "$a", h: 1}}]));
+assertIndexesConsistent();
+}());
@@ -179,30 +179,46 @@ function runWildcardIndexTest(keyPattern, pathProjection, expectedPaths) {
         // Perform an $and for this operation across all indexed fields; for instance:
         // {$and: [{a: {$gte: 50}}, {'b.c': {$gte: 50}}, {'b.d.e': {$gte: 50}}]}.
         const explainedAnd = coll.find({$and: multiFieldPreds}).explain();
-        const winningIxScan = getPlanStages(getWinningPlan(explainedAnd.queryPlanner), "IXSCAN");
+        const winningPlan = getWinningPlan(explainedAnd.queryPlanner);
+        const winningAndSorted = getPlanStages(winningPlan, "AND_SORTED");
+        let allIxScans = getPlanStages(winningPlan, "IXSCAN");
 
         // Extract information about the rejected plans. We should have one IXSCAN for each $**
-        // candidate that wasn't the winner. Before SERVER-36521 banned them for $** indexes, a
-        // number of AND_SORTED plans would also be generated here; we search for these in order
-        // to verify that no such plans now exist.
+        // candidate that wasn't the winner. The scans of several paths are also intersected by
+        // AND_SORTED plans, but only when each of them scans a single point and so returns
+        // RecordIds in order.
         let rejectedIxScans = [], rejectedAndSorted = [];
         const rejectedPlans = getRejectedPlans(explainedAnd);
         for (let rejectedPlan of rejectedPlans) {
             rejectedPlan = getRejectedPlan(rejectedPlan);
-            rejectedAndSorted = rejectedAndSorted.concat(getPlanStages(rejectedPlan, "AND_SORTED"));
-            rejectedIxScans = rejectedIxScans.concat(getPlanStages(rejectedPlan, "IXSCAN"));
+            const ixScans = getPlanStages(rejectedPlan, "IXSCAN");
+            allIxScans = allIxScans.concat(ixScans);
+            const andSorted = getPlanStages(rejectedPlan, "AND_SORTED");
+            if (andSorted.length > 0) {
+                rejectedAndSorted = rejectedAndSorted.concat(andSorted);
+            } else {
+                rejectedIxScans = rejectedIxScans.concat(ixScans);
+            }
         }
 
-        // Confirm that no AND_SORTED plans were generated.
-        assert.eq(rejectedAndSorted.length, 0);
+        const isPointScan = op.bounds.length === 1 && !op.subpathBounds &&
+            op.bounds[0].startsWith("[") && op.bounds[0].endsWith("]") &&
+            op.bounds[0].slice(1, -1).split(", ").every((bound, i, bounds) => bound === bounds[0]);
+        if (expectedPaths.length > 1 && isPointScan) {
+            assert.gt(winningAndSorted.length + rejectedAndSorted.length, 0, explainedAnd);
+        } else {
+            assert.eq(winningAndSorted.length + rejectedAndSorted.length, 0, explainedAnd);
+        }
 
-        // We should find that one of the available $** subindexes has been chosen as the
-        // winner, and all other candidate $** indexes are present in 'rejectedPlans'.
-        assert.eq(winningIxScan.length, numShards);
-        assert.eq(rejectedIxScans.length, numShards * (expectedPaths.length - 1));
+        // Every candidate $** index has a plan of its own, which is either the winner or one of
+        // the rejected plans.
+        const numWinningIxScans = numShards - winningAndSorted.length;
+        assert.eq(numWinningIxScans + rejectedIxScans.length,
+                  numShards * expectedPaths.length,
+                  explainedAnd);
 
         // Verify that each of the IXSCANs have the expected bounds and $_path key.
-        for (let ixScan of winningIxScan.concat(rejectedIxScans)) {
+        for (let ixScan of allIxScans) {
             // {$_path: ["['path.to.field', 'path.to.field']"], path.to.field: [[bounds]]}
             const ixScanPath = JSON.parse(ixScan.indexBounds.$_path[0])[0];
             assert.eq(ixScan.indexBounds[ixScanPath], op.bounds);
@@ -0,0 +1,82 @@
+/**
+ * Tests that the 'analyze' command persists index statistics, and that once every candidate plan
+ * can be costed from them the planner picks the cheapest plan instead of running the candidates
+ * against each other.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.analyze_cost_based_ranking;
+coll.drop();
+
+// Almost every document has a = 0, while b is unique.
+const docs = Array.from({length: 1000}, (_, i) => ({a: i < 990 ? 0 : i, b: i}));
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+
+function assertWinningIndex(query, indexName, expectRejectedPlans) {
+    const explain = coll.find(query).explain();
+    const ixscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+    assert.neq(null, ixscan, explain);
+    assert.eq(indexName, ixscan.indexName, explain);
+    assert.eq(expectRejectedPlans,
+              explain.queryPlanner.rejectedPlans.length > 0,
+              explain.queryPlanner.rejectedPlans);
+}
+
+// Without statistics the candidate plans are raced.
+assertWinningIndex({a: 0, b: 5}, "b_1", true);
+
+assert.commandFailedWithCode(db.runCommand({analyze: "does_not_exist"}),
+                             ErrorCodes.NamespaceNotFound);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), buckets: 0}),
+                             ErrorCodes.BadValue);
+
+const res = assert.commandWorked(db.runCommand({analyze: coll.getName()}));
+assert.eq(3, res.indexes.length, res);
+
+const statsColl = db.getCollection("system.statistics." + coll.getName());
+assert.eq(3, statsColl.find().itcount());
+const aStats = statsColl.findOne({_id: "a_1"});
+assert.eq(1000, aStats.numKeys, aStats);
+assert.eq(11, aStats.numDistinct, aStats);
+const collUUID = db.getCollectionInfos({name: coll.getName()})[0].info.uuid;
+assert.eq(collUUID, aStats.collectionUUID, aStats);
+
+// With statistics the cheapest plan is picked without racing the candidates, including when the
+// skewed value makes the index on 'a' the better choice.
+assertWinningIndex({a: 0, b: 5}, "b_1", false);
+assertWinningIndex({a: 995, b: {$gte: 0}}, "a_1", false);
+
+// Re-analyzing after an index is dropped removes its statistics.
+assert.commandWorked(coll.dropIndex({b: 1}));
+assert.commandWorked(db.runCommand({analyze: coll.getName()}));
+assert.eq(2, statsColl.find().itcount());
+assert.commandWorked(coll.createIndex({b: 1}));
+
+// An index without statistics falls back to multi-planning.
+assertWinningIndex({a: 0, b: 5}, "b_1", true);
+
+// So does disabling cost-based ranking.
+assert.commandWorked(db.runCommand({analyze: coll.getName()}));
+assertWinningIndex({a: 0, b: 5}, "b_1", false);
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerEnableCostBasedRanking: false}));
+assertWinningIndex({a: 0, b: 5}, "b_1", true);
+
+// The statistics of a dropped collection are not applied to a new collection with the same name.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerEnableCostBasedRanking: true}));
+assert.commandWorked(db.runCommand({analyze: coll.getName()}));
+assert(coll.drop());
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+assert.eq(3, statsColl.find().itcount());
+assertWinningIndex({a: 0, b: 5}, "b_1", true);
+
+MongoRunner.stopMongod(conn);
+})();
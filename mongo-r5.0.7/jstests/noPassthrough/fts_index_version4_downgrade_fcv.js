@@ -0,0 +1,57 @@
+/**
+ * Text indexes which store term positions (textIndexVersion 4) can only be created when
+ * featureFlagTextIndexPositions is enabled and in FCV 5.0, and a downgrade request is rejected
+ * while any of them is present.
+ *
+ * TODO (SERVER-56171): Remove this test once 5.0 is last-lts.
+ *
+ * @tags: [
+ *     requires_fcv_50,
+ * ]
+ */
+(function() {
+"use strict";
+
+// Earlier 5.0 binaries cannot read these indexes, so they must be opted into.
+let conn = MongoRunner.runMongod({setParameter: {featureFlagTextIndexPositions: false}});
+assert.commandFailedWithCode(
+    conn.getDB(jsTestName()).t.createIndex({a: "text"}, {textIndexVersion: 4}),
+    ErrorCodes.CannotCreateIndex);
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({setParameter: {featureFlagTextIndexPositions: true}});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.getCollection('t');
+assert.commandWorked(coll.insert({_id: 0, a: "the cat sat on the mat"}));
+
+function getTextIndexVersion(name) {
+    const index = coll.getIndexes().find(index => index.name === name);
+    assert.neq(undefined, index, coll.getIndexes());
+    return index.textIndexVersion;
+}
+
+// Version 3 remains the default.
+assert.commandWorked(coll.createIndex({a: "text"}, {name: "default"}));
+assert.eq(3, getTextIndexVersion("default"));
+assert.commandWorked(coll.dropIndex("default"));
+
+assert.commandWorked(coll.createIndex({a: "text"}, {name: "positions", textIndexVersion: 4}));
+assert.eq(4, getTextIndexVersion("positions"));
+
+// The downgrade is rejected while the index is present, and it cannot be recreated while the
+// cluster is downgrading.
+assert.commandFailedWithCode(testDB.adminCommand({setFeatureCompatibilityVersion: lastLTSFCV}),
+                             ErrorCodes.CannotDowngrade);
+assert.commandWorked(coll.dropIndex("positions"));
+assert.commandFailedWithCode(coll.createIndex({a: "text"}, {textIndexVersion: 4}),
+                             ErrorCodes.CannotCreateIndex);
+
+// The downgrade completes once the index has been removed.
+assert.commandWorked(testDB.adminCommand({setFeatureCompatibilityVersion: lastLTSFCV}));
+assert.commandFailedWithCode(coll.createIndex({a: "text"}, {textIndexVersion: 4}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandWorked(coll.createIndex({a: "text"}, {name: "default"}));
+assert.eq(3, getTextIndexVersion("default"));
+
+MongoRunner.stopMongod(conn);
+})();
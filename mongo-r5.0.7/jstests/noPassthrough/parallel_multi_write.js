@@ -0,0 +1,69 @@
+/**
+ * Test that multi-document updates and deletes answered by a collection scan of a large enough
+ * collection are split among parallel workers, and that their results match those of a serial
+ * write.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter:
+        {internalMultiWriteMaxParallelWorkers: 4, internalMultiWriteParallelMinRecords: 1000}
+});
+const db = conn.getDB("test");
+const coll = db.parallel_multi_write;
+coll.drop();
+
+const numDocs = 6000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, a: i % 3, b: 0});
+}
+assert.commandWorked(bulk.execute());
+
+function getNumParallelMultiWrites() {
+    return assert.commandWorked(db.serverStatus()).metrics.query.parallelMultiWrites;
+}
+
+// A multi-document update visits every matching document exactly once.
+let numParallel = getNumParallelMultiWrites();
+let res = assert.commandWorked(coll.updateMany({a: 1}, {$inc: {b: 1}}));
+assert.eq(numParallel + 1, getNumParallelMultiWrites());
+assert.eq(numDocs / 3, res.matchedCount);
+assert.eq(numDocs / 3, res.modifiedCount);
+assert.eq(numDocs / 3, coll.find({b: 1}).itcount());
+assert.eq(0, coll.find({a: 1, b: {$ne: 1}}).itcount());
+
+// A multi-document delete removes every matching document.
+numParallel = getNumParallelMultiWrites();
+res = assert.commandWorked(coll.deleteMany({a: 2}));
+assert.eq(numParallel + 1, getNumParallelMultiWrites());
+assert.eq(numDocs / 3, res.deletedCount);
+assert.eq(0, coll.find({a: 2}).itcount());
+const numRemaining = coll.find().itcount();
+assert.eq(numDocs - res.deletedCount, numRemaining);
+
+// The error of a worker fails the write. Documents written by other workers stay written.
+assert.commandWorked(coll.update({_id: 0}, {$set: {b: "notANumber"}}));
+numParallel = getNumParallelMultiWrites();
+assert.commandFailedWithCode(coll.updateMany({}, {$inc: {b: 1}}), ErrorCodes.TypeMismatch);
+assert.eq(numParallel + 1, getNumParallelMultiWrites());
+assert.commandWorked(coll.update({_id: 0}, {$set: {b: 0}}));
+
+// Writes which the query planner answers with an index scan are applied serially.
+assert.commandWorked(coll.createIndex({a: 1}));
+numParallel = getNumParallelMultiWrites();
+res = assert.commandWorked(coll.updateMany({a: 1}, {$set: {c: 1}}));
+assert.eq(numParallel, getNumParallelMultiWrites());
+assert.eq(coll.find({a: 1}).itcount(), res.modifiedCount);
+
+// As are all writes once the number of workers is set back to 1.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalMultiWriteMaxParallelWorkers: 1}));
+numParallel = getNumParallelMultiWrites();
+res = assert.commandWorked(coll.deleteMany({c: {$exists: false}}));
+assert.eq(numParallel, getNumParallelMultiWrites());
+assert.eq(numRemaining - coll.find({a: 1}).itcount(), res.deletedCount);
+assert.eq(0, coll.find({c: {$exists: false}}).itcount());
+
+MongoRunner.stopMongod(conn);
+})();
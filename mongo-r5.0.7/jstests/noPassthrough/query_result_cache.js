@@ -0,0 +1,71 @@
+/**
+ * Test that find command results over the collections opted in to the query result cache are
+ * served from the cache, and that writes to those collections invalidate the cached results.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({});
+const db = conn.getDB("test");
+const coll = db.query_result_cache;
+const otherColl = db.query_result_cache_other;
+coll.drop();
+otherColl.drop();
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({_id: i, a: i % 2}));
+    assert.commandWorked(otherColl.insert({_id: i, a: i % 2}));
+}
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryResultCacheNamespaces: [coll.getFullName()]}));
+
+function getResultCacheMetrics() {
+    return assert.commandWorked(db.serverStatus()).metrics.query.resultCache;
+}
+
+function findIds(collection, filter) {
+    return collection.find(filter).sort({_id: 1}).toArray().map(doc => doc._id);
+}
+
+// The first execution populates the cache, and the second one is answered from it.
+let metrics = getResultCacheMetrics();
+assert.eq([1, 3, 5, 7, 9], findIds(coll, {a: 1}));
+assert.eq(metrics.hits, getResultCacheMetrics().hits);
+assert.eq([1, 3, 5, 7, 9], findIds(coll, {a: 1}));
+assert.eq(metrics.hits + 1, getResultCacheMetrics().hits);
+assert.gt(getResultCacheMetrics().sizeBytes, 0);
+
+// Queries with different constants have their own entries.
+assert.eq([0, 2, 4, 6, 8], findIds(coll, {a: 0}));
+assert.eq(metrics.hits + 1, getResultCacheMetrics().hits);
+
+// Writes to the collection invalidate the cached results.
+assert.commandWorked(coll.insert({_id: 10, a: 1}));
+assert.eq([1, 3, 5, 7, 9, 10], findIds(coll, {a: 1}));
+assert.eq(metrics.hits + 1, getResultCacheMetrics().hits);
+assert.eq([1, 3, 5, 7, 9, 10], findIds(coll, {a: 1}));
+assert.eq(metrics.hits + 2, getResultCacheMetrics().hits);
+
+assert.commandWorked(coll.update({_id: 10}, {$set: {a: 0}}));
+assert.eq([1, 3, 5, 7, 9], findIds(coll, {a: 1}));
+assert.commandWorked(coll.remove({_id: 1}));
+assert.eq([3, 5, 7, 9], findIds(coll, {a: 1}));
+assert.gt(getResultCacheMetrics().invalidations, metrics.invalidations);
+
+// Results which do not fit in the first batch, and collections which have not been opted in, are
+// never cached.
+metrics = getResultCacheMetrics();
+assert.eq(coll.find().batchSize(2).itcount(), 10);
+assert.eq(coll.find().batchSize(2).itcount(), 10);
+assert.eq(findIds(otherColl, {a: 1}), [1, 3, 5, 7, 9]);
+assert.eq(findIds(otherColl, {a: 1}), [1, 3, 5, 7, 9]);
+assert.eq(metrics.hits, getResultCacheMetrics().hits);
+
+// Dropping the collection invalidates its results.
+assert.eq([3, 5, 7, 9], findIds(coll, {a: 1}));
+assert(coll.drop());
+assert.eq([], findIds(coll, {a: 1}));
+
+MongoRunner.stopMongod(conn);
+}());
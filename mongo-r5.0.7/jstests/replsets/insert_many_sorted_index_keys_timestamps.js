@@ -0,0 +1,71 @@
+/**
+ * On replica set primaries, each document of a multi-document insert is written at its own
+ * timestamp. Verifies that the keys of such a batch are still inserted in key order, and that each
+ * key becomes visible at the timestamp of its document.
+ *
+ * @tags: [
+ *   requires_majority_read_concern,
+ *   requires_persistence,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallel_shell_helpers.js");  // For funWithArgs.
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const dbName = "test";
+const collName = jsTestName();
+const testDB = primary.getDB(dbName);
+const coll = testDB.getCollection(collName);
+assert.commandWorked(coll.createIndex({a: 1}));
+
+const numDocs = 20;
+const fp = configureFailPoint(primary, "hangAfterSortingIndexKeysOfInsertBatch");
+function insertDocs(dbName, collName, numDocs) {
+    let docs = [];
+    for (let i = 0; i < numDocs; ++i) {
+        // Unrelated to the insertion order.
+        docs.push({_id: i, a: (i * 7) % numDocs});
+    }
+    assert.commandWorked(db.getSiblingDB(dbName).getCollection(collName).insertMany(docs));
+}
+const awaitInsert =
+    startParallelShell(funWithArgs(insertDocs, dbName, collName, numDocs), primary.port);
+
+// The batch takes the sorted path although its documents have distinct timestamps.
+fp.wait();
+fp.off();
+awaitInsert();
+rst.awaitLastOpCommitted();
+
+const oplogEntries = primary.getDB("local")
+                         .oplog.rs.find({ns: coll.getFullName(), op: "i"})
+                         .sort({ts: 1})
+                         .toArray();
+assert.eq(numDocs, oplogEntries.length, oplogEntries);
+
+// At the timestamp of each document, the index holds exactly the keys of the documents inserted
+// up to it. The query is covered, so that it reads the keys without fetching the documents.
+for (let i = 0; i < numDocs; ++i) {
+    const res = assert.commandWorked(testDB.runCommand({
+        find: collName,
+        filter: {a: {$gte: 0}},
+        hint: {a: 1},
+        projection: {_id: 0, a: 1},
+        readConcern: {level: "snapshot", atClusterTime: oplogEntries[i].ts},
+    }));
+    const expected = oplogEntries.slice(0, i + 1).map(entry => entry.o.a).sort((x, y) => x - y);
+    assert.eq(expected, res.cursor.firstBatch.map(doc => doc.a), {i: i, res: res});
+}
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+
+rst.stopSet();
+})();
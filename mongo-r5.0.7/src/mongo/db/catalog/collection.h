@@ -63,6 +63,7 @@ namespace mongo {
 
 class CappedCallback;
 class CollectionPtr;
+class FieldRefSetWithStorage;
 class IndexCatalog;
 class IndexCatalogEntry;
 class MatchExpression;
@@ -90,6 +91,10 @@ struct CollectionUpdateArgs {
     // Document containing the _id field of the doc being updated.
     BSONObj criteria;
 
+    // The paths modified by the update, if known. When set, only the indexes whose keys may depend
+    // on one of these paths are maintained. When null, every index is maintained.
+    const FieldRefSetWithStorage* modifiedPaths = nullptr;
+
     // Type of update. See OperationSource definition for more details.
     OperationSource source = OperationSource::kStandard;
 
@@ -1298,6 +1298,7 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                                     *args->preImageDoc,
                                                     newDoc,
                                                     oldLocation,
+                                                    args->modifiedPaths,
                                                     &keysInserted,
                                                     &keysDeleted));
 
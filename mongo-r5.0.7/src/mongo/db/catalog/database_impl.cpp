@@ -373,7 +373,7 @@ Status DatabaseImpl::dropCollection(OperationContext* opCtx,
         } else if (!(nss.isHealthlog() || nss == NamespaceString::kLogicalSessionsNamespace ||
                      nss == NamespaceString::kKeysCollectionNamespace ||
                      nss.isTemporaryReshardingCollection() ||
-                     nss.isTimeseriesBucketsCollection())) {
+                     nss.isTimeseriesBucketsCollection() || nss.isStatisticsCollection())) {
             return Status(ErrorCodes::IllegalOperation,
                           str::stream() << "can't drop system collection " << nss);
         }
@@ -46,6 +46,7 @@ namespace mongo {
 class Client;
 class Collection;
 class CollectionPtr;
+class FieldRefSetWithStorage;
 
 class IndexDescriptor;
 struct InsertDeleteOptions;
@@ -455,6 +456,9 @@ public:
      * Both 'keysInsertedOut' and 'keysDeletedOut' are required and will be set to the number of
      * index keys inserted and deleted by this operation, respectively.
      *
+     * If 'modifiedPaths' is not null, indexes whose keys cannot depend on any of those paths are
+     * left untouched.
+     *
      * This method may throw.
      */
     virtual Status updateRecord(OperationContext* const opCtx,
@@ -462,6 +466,7 @@ public:
                                 const BSONObj& oldDoc,
                                 const BSONObj& newDoc,
                                 const RecordId& recordId,
+                                const FieldRefSetWithStorage* modifiedPaths,
                                 int64_t* const keysInsertedOut,
                                 int64_t* const keysDeletedOut) const = 0;
 
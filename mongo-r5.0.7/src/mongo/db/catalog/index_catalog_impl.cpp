@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -64,6 +65,7 @@
 #include "mongo/db/query/collection_index_usage_tracker_decoration.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl_set_member_in_standalone_mode.h"
 #include "mongo/db/server_options.h"
@@ -85,6 +87,7 @@ namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(skipUnindexingDocumentWhenDeleted);
 MONGO_FAIL_POINT_DEFINE(skipIndexNewRecords);
+MONGO_FAIL_POINT_DEFINE(hangAfterSortingIndexKeysOfInsertBatch);
 
 using std::endl;
 using std::string;
@@ -1369,6 +1372,11 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
                                                const IndexCatalogEntry* index,
                                                const std::vector<BsonRecord>& bsonRecords,
                                                int64_t* keysInsertedOut) const {
+    if (!index->isHybridBuilding() &&
+        bsonRecords.size() >= static_cast<size_t>(internalInsertSortIndexKeysMinBatchSize.load())) {
+        return _indexFilteredRecordsSorted(opCtx, coll, index, bsonRecords, keysInsertedOut);
+    }
+
     SharedBufferFragmentBuilder pooledBuilder(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
     auto& executionCtx = StorageExecutionContext::get(opCtx);
 
@@ -1416,6 +1424,109 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsSorted(OperationContext* opCtx,
+                                                     const CollectionPtr& coll,
+                                                     const IndexCatalogEntry* index,
+                                                     const std::vector<BsonRecord>& bsonRecords,
+                                                     int64_t* keysInsertedOut) const {
+    SharedBufferFragmentBuilder pooledBuilder(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    auto iam = index->accessMethod();
+
+    InsertDeleteOptions options;
+    prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
+
+    // Each key keeps the timestamp of its record, as it must become visible together with it. On
+    // replica set primaries every record of the batch has its own timestamp.
+    std::vector<std::pair<KeyString::Value, Timestamp>> batchKeys;
+    int64_t numMultikeyMetadataKeys = 0;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        iam->getKeys(pooledBuilder,
+                     *bsonRecord.docPtr,
+                     options.getKeysMode,
+                     IndexAccessMethod::GetKeysContext::kAddingKeys,
+                     keys.get(),
+                     multikeyMetadataKeys.get(),
+                     multikeyPaths.get(),
+                     bsonRecord.id,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        // Whether the index becomes multikey depends on the keys of each document on its own, so
+        // it cannot be decided from the keys of the whole batch.
+        if (iam->shouldMarkIndexAsMultikey(keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            index->setMultikey(opCtx, coll, *multikeyMetadataKeys, *multikeyPaths);
+        }
+        numMultikeyMetadataKeys += multikeyMetadataKeys->size();
+
+        for (const auto& key : *keys) {
+            batchKeys.emplace_back(key, bsonRecord.ts);
+        }
+    }
+
+    // Inserting the keys of the whole batch in key order, rather than document by document, turns
+    // the random descents of the index into a mostly sequential walk over its leaf pages. Each key
+    // already encodes its RecordId. Neighbouring keys written at the same timestamp are inserted
+    // together.
+    std::sort(batchKeys.begin(), batchKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    hangAfterSortingIndexKeysOfInsertBatch.pauseWhileSet(opCtx);
+
+    // The records were written in timestamp order, so the storage transaction already has the
+    // timestamp of the first record, and the others can be set in any order.
+    int64_t numInserted = 0;
+    Timestamp currentTs;
+    KeyStringSet run;
+    const auto insertRun = [&]() -> Status {
+        if (run.empty()) {
+            return Status::OK();
+        }
+        if (!currentTs.isNull()) {
+            Status status = opCtx->recoveryUnit()->setTimestamp(currentTs);
+            if (!status.isOK())
+                return status;
+        }
+
+        int64_t numRunInserted = 0;
+        Status status =
+            iam->insertKeys(opCtx, coll, run, RecordId(), options, nullptr, &numRunInserted);
+        numInserted += numRunInserted;
+        run.clear();
+        return status;
+    };
+    for (auto& [key, ts] : batchKeys) {
+        if (ts != currentTs) {
+            Status status = insertRun();
+            if (!status.isOK())
+                return status;
+            currentTs = ts;
+        }
+        run.insert(run.end(), std::move(key));
+    }
+    Status status = insertRun();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // Leave the timestamp of the last record set, as indexing the records one by one does.
+    if (const auto& lastTs = bsonRecords.back().ts; !lastTs.isNull() && lastTs != currentTs) {
+        status = opCtx->recoveryUnit()->setTimestamp(lastTs);
+        if (!status.isOK())
+            return status;
+    }
+
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted + numMultikeyMetadataKeys;
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        const IndexCatalogEntry* index,
@@ -1610,16 +1721,26 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
                                       const BSONObj& oldDoc,
                                       const BSONObj& newDoc,
                                       const RecordId& recordId,
+                                      const FieldRefSetWithStorage* modifiedPaths,
                                       int64_t* const keysInsertedOut,
                                       int64_t* const keysDeletedOut) const {
     *keysInsertedOut = 0;
     *keysDeletedOut = 0;
 
+    const auto& queryInfo = CollectionQueryInfo::get(coll);
+    auto updateMightAffectIndex = [&](const IndexCatalogEntry* entry) {
+        return !modifiedPaths ||
+            queryInfo.updateMightAffectIndex(entry->descriptor(), *modifiedPaths);
+    };
+
     // Ready indexes go directly through the IndexAccessMethod.
     for (IndexCatalogEntryContainer::const_iterator it = _readyIndexes.begin();
          it != _readyIndexes.end();
          ++it) {
         IndexCatalogEntry* entry = it->get();
+        if (!updateMightAffectIndex(entry)) {
+            continue;
+        }
         auto status = _updateRecord(
             opCtx, coll, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
         if (!status.isOK())
@@ -1631,6 +1752,9 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
          it != _buildingIndexes.end();
          ++it) {
         IndexCatalogEntry* entry = it->get();
+        if (!updateMightAffectIndex(entry)) {
+            continue;
+        }
         auto status = _updateRecord(
             opCtx, coll, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
         if (!status.isOK())
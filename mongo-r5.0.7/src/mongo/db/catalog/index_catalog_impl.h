@@ -269,6 +269,7 @@ public:
                         const BSONObj& oldDoc,
                         const BSONObj& newDoc,
                         const RecordId& recordId,
+                        const FieldRefSetWithStorage* modifiedPaths,
                         int64_t* const keysInsertedOut,
                         int64_t* const keysDeletedOut) const override;
     /**
@@ -335,6 +336,16 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut) const;
 
+    /**
+     * Generates the keys of all of 'bsonRecords' for 'index' and inserts them in key order. Each
+     * key is written at the timestamp of its record.
+     */
+    Status _indexFilteredRecordsSorted(OperationContext* opCtx,
+                                       const CollectionPtr& coll,
+                                       const IndexCatalogEntry* index,
+                                       const std::vector<BsonRecord>& bsonRecords,
+                                       int64_t* keysInsertedOut) const;
+
     Status _indexRecords(OperationContext* opCtx,
                          const CollectionPtr& coll,
                          const IndexCatalogEntry* index,
@@ -52,8 +52,11 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_conflict_info.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
@@ -83,6 +86,25 @@ size_t getEachIndexBuildMaxMemoryUsageBytes(size_t numIndexSpecs) {
         numIndexSpecs;
 }
 
+/**
+ * Has 'bulks' generate their keys from a single walk over each document when several indexes are
+ * built together. Returns the extractor to run on each document before inserting it into 'bulks',
+ * or nullptr if each index walks the documents itself.
+ */
+std::unique_ptr<SharedPathExtractor> makeSharedPathExtractor(
+    const std::vector<IndexAccessMethod::BulkBuilder*>& bulks) {
+    if (bulks.size() < 2 || !internalIndexBuildUseSharedPathExtraction.load()) {
+        return nullptr;
+    }
+
+    auto extractor = std::make_unique<SharedPathExtractor>();
+    bool isShared = false;
+    for (auto bulk : bulks) {
+        isShared = bulk->shareExtractedPaths(extractor.get()) || isShared;
+    }
+    return isShared ? std::move(extractor) : nullptr;
+}
+
 }  // namespace
 
 MultiIndexBlock::~MultiIndexBlock() {
@@ -322,6 +344,8 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
             index.filterExpression = indexCatalogEntry->getFilterExpression();
         }
 
+        _shareExtractedPaths();
+
         opCtx->recoveryUnit()->onCommit([ns = collection->ns(), this](auto commitTs) {
             if (!_buildUUID) {
                 return;
@@ -438,10 +462,13 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
         try {
             // Resumable index builds can only be resumed prior to the oplog recovery phase of
             // startup. When restarting the collection scan, any saved index build progress is lost.
-            _doCollectionScan(opCtx,
-                              collection,
-                              numScanRestarts == 0 ? resumeAfterRecordId : boost::none,
-                              &progress);
+            const auto resumeAfter = numScanRestarts == 0 ? resumeAfterRecordId : boost::none;
+            const auto numThreads = _getNumCollectionScanThreads(opCtx, collection, resumeAfter);
+            if (numThreads > 1) {
+                _doParallelCollectionScan(opCtx, collection, numThreads, &progress);
+            } else {
+                _doCollectionScan(opCtx, collection, resumeAfter, &progress);
+            }
 
             LOGV2(20391,
                   "Index build: collection scan done",
@@ -484,6 +511,7 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
                         /*stateInfo=*/boost::none,
                         collection->ns().db());
                 }
+                _shareExtractedPaths();
             } else {
                 if (ex.isA<ErrorCategory::Interruption>() ||
                     ex.isA<ErrorCategory::ShutdownError>() ||
@@ -635,6 +663,302 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
     }
 }
 
+size_t MultiIndexBlock::_getNumCollectionScanThreads(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const boost::optional<RecordId>& resumeAfterRecordId) const {
+    const auto maxThreads = maxNumIndexBuildCollectionScanThreads.load();
+    if (maxThreads <= 1 || !isBackgroundBuilding() || opCtx->lockState()->isNoop()) {
+        return 1;
+    }
+
+    // A resumed scan must continue in RecordId order from where it stopped. Capped cursors can
+    // lose their position between batches, and clustered collections do not have integer
+    // RecordIds to split into ranges.
+    if (resumeAfterRecordId || collection->isCapped() || collection->isClustered()) {
+        return 1;
+    }
+
+    if (collection->numRecords(opCtx) < internalIndexBuildParallelScanMinRecords.load()) {
+        return 1;
+    }
+
+    return static_cast<size_t>(maxThreads);
+}
+
+void MultiIndexBlock::_doParallelCollectionScan(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                size_t numThreads,
+                                                ProgressMeterHolder* progress) {
+    invariant(_phase == IndexBuildPhaseEnum::kInitialized ||
+                  _phase == IndexBuildPhaseEnum::kCollectionScan,
+              IndexBuildPhase_serializer(_phase).toString());
+    _phase = IndexBuildPhaseEnum::kCollectionScan;
+
+    // Split the RecordIds between the first and last record into ranges of equal width. The last
+    // range is unbounded so that the workers see the same records a serial scan would.
+    std::vector<RecordId> rangeStarts;
+    {
+        auto first = collection->getCursor(opCtx, /*forward=*/true)->next();
+        auto last = collection->getCursor(opCtx, /*forward=*/false)->next();
+        if (!first || !last) {
+            return;
+        }
+
+        const int64_t minId = first->id.getLong();
+        const int64_t maxId = last->id.getLong();
+        const int64_t width = (maxId - minId) / static_cast<int64_t>(numThreads) + 1;
+        for (size_t i = 0; i < numThreads && minId + width * static_cast<int64_t>(i) <= maxId;
+             ++i) {
+            rangeStarts.emplace_back(minId + width * static_cast<int64_t>(i));
+        }
+    }
+
+    // Each worker sorts the keys it generates with its own BulkBuilders, which split the memory
+    // budget of the build evenly.
+    const size_t maxMemoryUsageBytes =
+        getEachIndexBuildMaxMemoryUsageBytes(_indexes.size()) / rangeStarts.size();
+    std::vector<std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>>> workerBulks(
+        rangeStarts.size());
+    std::vector<std::unique_ptr<SharedPathExtractor>> workerExtractors;
+    for (auto& bulks : workerBulks) {
+        std::vector<IndexAccessMethod::BulkBuilder*> bulkPtrs;
+        for (const auto& index : _indexes) {
+            bulks.push_back(index.real->initiateBulk(
+                maxMemoryUsageBytes, /*stateInfo=*/boost::none, collection->ns().db()));
+            bulkPtrs.push_back(bulks.back().get());
+        }
+        workerExtractors.push_back(makeSharedPathExtractor(bulkPtrs));
+    }
+
+    const NamespaceStringOrUUID nsOrUUID(collection->ns().db().toString(), collection->uuid());
+    const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+    const bool readOnce = opCtx->recoveryUnit()->getReadOnce();
+    const auto prepareConflictBehavior = opCtx->recoveryUnit()->getPrepareConflictBehavior();
+
+    auto mutex = MONGO_MAKE_LATCH("MultiIndexBlock::_doParallelCollectionScan::mutex");
+    stdx::condition_variable workersDone;
+    size_t numRunning = rangeStarts.size();
+    Status workerStatus = Status::OK();
+    AtomicWord<bool> stopScan{false};
+    AtomicWord<unsigned long long> numScanned{0};
+    // The operations of the running workers, which are killed if this thread stops waiting for
+    // them, so that workers hanging on a failpoint or waiting for a lock do not block the join.
+    std::vector<OperationContext*> workerOpCtxs;
+
+    {
+        // The workers acquire their own locks, so release ours while they run. Otherwise a
+        // conflicting lock request queued behind ours would block the workers, and with them this
+        // thread.
+        collection.yield();
+        Locker::LockSnapshot lockInfo;
+        invariant(opCtx->lockState()->saveLockStateAndUnlock(&lockInfo));
+
+        std::vector<stdx::thread> workers;
+        ON_BLOCK_EXIT([&] {
+            stopScan.store(true);
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                for (auto workerOpCtx : workerOpCtxs) {
+                    stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                    workerOpCtx->getServiceContext()->killOperation(clientLock, workerOpCtx);
+                }
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            UninterruptibleLockGuard noInterrupt(opCtx->lockState());
+            opCtx->lockState()->restoreLockState(opCtx, lockInfo);
+            opCtx->recoveryUnit()->abandonSnapshot();
+            collection.restore();
+        });
+
+        for (size_t i = 0; i < rangeStarts.size(); ++i) {
+            workers.emplace_back([&, i] {
+                Status status = Status::OK();
+                try {
+                    ThreadClient tc(str::stream() << "IndexBuildCollectionScan-" << i,
+                                    opCtx->getServiceContext());
+                    auto workerOpCtx = tc->makeOperationContext();
+                    {
+                        stdx::lock_guard<Latch> lk(mutex);
+                        workerOpCtxs.push_back(workerOpCtx.get());
+                    }
+                    ON_BLOCK_EXIT([&] {
+                        stdx::lock_guard<Latch> lk(mutex);
+                        workerOpCtxs.erase(std::find(workerOpCtxs.begin(),
+                                                     workerOpCtxs.end(),
+                                                     workerOpCtx.get()));
+                    });
+
+                    workerOpCtx->recoveryUnit()->setTimestampReadSource(readSource);
+                    workerOpCtx->recoveryUnit()->setReadOnce(readOnce);
+                    workerOpCtx->recoveryUnit()->setPrepareConflictBehavior(
+                        prepareConflictBehavior);
+
+                    const auto end = i + 1 < rangeStarts.size()
+                        ? boost::make_optional(rangeStarts[i + 1])
+                        : boost::none;
+                    _scanRecordIdRange(workerOpCtx.get(),
+                                       nsOrUUID,
+                                       rangeStarts[i],
+                                       end,
+                                       workerBulks[i],
+                                       workerExtractors[i].get(),
+                                       stopScan,
+                                       &numScanned);
+                } catch (...) {
+                    status = exceptionToStatus();
+                }
+
+                stdx::lock_guard<Latch> lk(mutex);
+                if (!status.isOK() && workerStatus.isOK()) {
+                    workerStatus = status;
+                    stopScan.store(true);
+                }
+                if (--numRunning == 0) {
+                    workersDone.notify_all();
+                }
+            });
+        }
+
+        {
+            stdx::unique_lock<Latch> lk(mutex);
+            unsigned long long numReported = 0;
+            while (!opCtx->waitForConditionOrInterruptFor(
+                workersDone, lk, Milliseconds(500), [&] { return numRunning == 0; })) {
+                const auto numScannedNow = numScanned.load();
+                progress->hit(static_cast<int>(numScannedNow - numReported));
+                numReported = numScannedNow;
+            }
+            progress->hit(static_cast<int>(numScanned.load() - numReported));
+            uassertStatusOK(workerStatus);
+        }
+
+        // The keys of each worker form one sorted run per index. Merge them into the BulkBuilder
+        // of the index so that the rest of the build, including persisting its state for
+        // resuming, is unaware of the parallel scan.
+        for (size_t i = 0; i < _indexes.size(); ++i) {
+            std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>> bulks;
+            for (auto& workerBulk : workerBulks) {
+                bulks.push_back(std::move(workerBulk[i]));
+            }
+            _indexes[i].bulk->mergeFrom(std::move(bulks));
+        }
+    }
+
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nsOrUUID.toString()
+                          << " was dropped during the index build collection scan",
+            collection);
+}
+
+void MultiIndexBlock::_scanRecordIdRange(
+    OperationContext* opCtx,
+    const NamespaceStringOrUUID& nsOrUUID,
+    const RecordId& start,
+    const boost::optional<RecordId>& end,
+    const std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>>& bulks,
+    SharedPathExtractor* sharedPathExtractor,
+    const AtomicWord<bool>& stopScan,
+    AtomicWord<unsigned long long>* numScanned) const {
+    // The number of records scanned before releasing locks and the storage snapshot, similar to
+    // the yielding of the serial collection scan.
+    const size_t kRecordsPerBatch = 1000;
+
+    SharedBufferFragmentBuilder pooledBuilder(
+        gOperationMemoryPoolBlockInitialSizeKB.loadRelaxed() * static_cast<size_t>(1024),
+        SharedBufferFragmentBuilder::DoubleGrowStrategy(
+            gOperationMemoryPoolBlockMaxSizeKB.loadRelaxed() * static_cast<size_t>(1024)));
+
+    boost::optional<RecordId> lastRecordId;
+    bool rangeExhausted = false;
+    while (!rangeExhausted) {
+        {
+            AutoGetCollection collection(opCtx, nsOrUUID, MODE_IX);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nsOrUUID.toString()
+                                  << " was dropped during the index build collection scan",
+                    collection);
+
+            auto cursor = collection->getCursor(opCtx);
+            auto record = cursor->seekNear(lastRecordId ? *lastRecordId : start);
+            for (size_t numInBatch = 0; numInBatch < kRecordsPerBatch; record = cursor->next()) {
+                if (!record || (end && record->id >= *end)) {
+                    rangeExhausted = true;
+                    break;
+                }
+
+                // seekNear() may position the cursor before the first record of this batch.
+                if (record->id < start || (lastRecordId && record->id <= *lastRecordId)) {
+                    continue;
+                }
+
+                if (stopScan.load()) {
+                    return;
+                }
+                opCtx->checkForInterrupt();
+
+                BSONObj doc = record->data.releaseToBson();
+                const RecordId loc = record->id;
+                // The iteration passed to the failpoints counts the records scanned by all the
+                // workers, as the progress of a serial scan does.
+                const auto iteration = numScanned->fetchAndAdd(1);
+                uassertStatusOK(_failPointHangDuringBuild(
+                    opCtx,
+                    &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
+                    "before",
+                    doc,
+                    iteration));
+
+                if (sharedPathExtractor) {
+                    sharedPathExtractor->extract(doc);
+                }
+                for (size_t i = 0; i < _indexes.size(); ++i) {
+                    if (_indexes[i].filterExpression &&
+                        !_indexes[i].filterExpression->matchesBSON(doc)) {
+                        continue;
+                    }
+
+                    uassertStatusOK(bulks[i]->insert(
+                        opCtx,
+                        pooledBuilder,
+                        doc,
+                        loc,
+                        _indexes[i].options,
+                        /*saveCursorBeforeWrite*/
+                        [&] {
+                            doc = doc.getOwned();
+                            cursor->save();
+                            if (sharedPathExtractor) {
+                                sharedPathExtractor->extract(doc);
+                            }
+                        },
+                        /*restoreCursorAfterWrite*/
+                        [&] {
+                            uassert(ErrorCodes::CappedPositionLost,
+                                    "Cursor position lost during the index build collection scan",
+                                    cursor->restore());
+                        }));
+                }
+
+                _failPointHangDuringBuild(opCtx,
+                                          &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
+                                          "after",
+                                          doc,
+                                          iteration)
+                    .ignore();
+
+                lastRecordId = loc;
+                ++numInBatch;
+            }
+        }
+
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+}
+
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(
     OperationContext* opCtx,
     const BSONObj& doc,
@@ -650,6 +974,17 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
                                 const std::function<void()>& saveCursorBeforeWrite,
                                 const std::function<void()>& restoreCursorAfterWrite) {
     invariant(!_buildIsCleanedUp);
+
+    // The extracted values point into 'doc', which the caller replaces with an owned copy before
+    // releasing its cursor. Extract them again from that copy for the remaining indexes.
+    std::function<void()> saveCursorAndExtract = saveCursorBeforeWrite;
+    if (_sharedPathExtractor) {
+        _sharedPathExtractor->extract(doc);
+        saveCursorAndExtract = [&] {
+            saveCursorBeforeWrite();
+            _sharedPathExtractor->extract(doc);
+        };
+    }
     for (size_t i = 0; i < _indexes.size(); i++) {
         if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
             continue;
@@ -665,7 +1000,7 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
                                                  doc,
                                                  loc,
                                                  _indexes[i].options,
-                                                 saveCursorBeforeWrite,
+                                                 saveCursorAndExtract,
                                                  restoreCursorAfterWrite);
         } catch (...) {
             return exceptionToStatus();
@@ -680,6 +1015,14 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+void MultiIndexBlock::_shareExtractedPaths() {
+    std::vector<IndexAccessMethod::BulkBuilder*> bulks;
+    for (const auto& index : _indexes) {
+        bulks.push_back(index.bulk.get());
+    }
+    _sharedPathExtractor = makeSharedPathExtractor(bulks);
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
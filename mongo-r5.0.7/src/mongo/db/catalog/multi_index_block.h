@@ -46,8 +46,10 @@
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_build_interceptor.h"
+#include "mongo/db/index/shared_path_extractor.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/resumable_index_builds_gen.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
@@ -343,9 +345,56 @@ private:
                            boost::optional<RecordId> resumeAfterRecordId,
                            ProgressMeterHolder* progress);
 
+    /**
+     * Returns the number of threads that may scan the given collection. Returns 1 when the scan
+     * must be serial, such as when resuming from a RecordId or when the collection is small.
+     */
+    size_t _getNumCollectionScanThreads(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        const boost::optional<RecordId>& resumeAfterRecordId) const;
+
+    /**
+     * Has the BulkBuilders of '_indexes' share a single walk over each inserted document, if
+     * possible, by setting up '_sharedPathExtractor'. Must be called whenever the BulkBuilders are
+     * created.
+     */
+    void _shareExtractedPaths();
+
+    /**
+     * Performs the collection scan on up to 'numThreads' worker threads, each of which scans a
+     * separate range of RecordIds and inserts keys into BulkBuilders of its own. Once all ranges
+     * have been scanned, the keys of each index are merged into that index's BulkBuilder. The
+     * locks held by 'opCtx' are released while the workers run.
+     */
+    void _doParallelCollectionScan(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   size_t numThreads,
+                                   ProgressMeterHolder* progress);
+
+    /**
+     * Runs on a worker thread of a parallel collection scan. Inserts keys for each document with a
+     * RecordId in [start, end) into 'bulks', which holds one BulkBuilder per index being built. An
+     * 'end' of boost::none scans to the end of the collection. Returns early once 'stopScan' is
+     * set. If 'sharedPathExtractor' is non-null, it is run on each document before the document is
+     * inserted into 'bulks'.
+     */
+    void _scanRecordIdRange(
+        OperationContext* opCtx,
+        const NamespaceStringOrUUID& nsOrUUID,
+        const RecordId& start,
+        const boost::optional<RecordId>& end,
+        const std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>>& bulks,
+        SharedPathExtractor* sharedPathExtractor,
+        const AtomicWord<bool>& stopScan,
+        AtomicWord<unsigned long long>* numScanned) const;
+
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
 
+    // Extracts the paths indexed by '_indexes' from each inserted document, so that their keys are
+    // generated from one walk over the document. Null if each index walks the documents itself.
+    std::unique_ptr<SharedPathExtractor> _sharedPathExtractor;
+
     std::vector<IndexToBuild> _indexes;
 
     IndexBuildMethod _method = IndexBuildMethod::kHybrid;
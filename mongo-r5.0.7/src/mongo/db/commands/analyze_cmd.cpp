@@ -0,0 +1,253 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds the statistics for the leading field of the index in 'entry' by walking the index twice:
+ * once to count its keys, which sizes the histogram buckets, and once to fill them in.
+ */
+IndexStatistics buildIndexStatistics(OperationContext* opCtx,
+                                     const IndexCatalogEntry* entry,
+                                     long long numRecords,
+                                     size_t maxBuckets) {
+    const auto iam = entry->accessMethod();
+    const auto sdi = iam->getSortedDataInterface();
+    const auto& keyPattern = entry->descriptor()->keyPattern();
+
+    // The histogram is built from the leading field's values in ascending order, so walk an index
+    // which is descending on that field backwards.
+    const bool forward = keyPattern.firstElement().number() >= 0;
+    const auto startKey =
+        KeyString::Builder(sdi->getKeyStringVersion(),
+                           BSONObj(),
+                           sdi->getOrdering(),
+                           forward ? KeyString::Discriminator::kExclusiveBefore
+                                   : KeyString::Discriminator::kExclusiveAfter)
+            .getValueCopy();
+
+    long long numKeys = 0;
+    auto cursor = iam->newCursor(opCtx, forward);
+    for (auto keyString = cursor->seekForKeyString(startKey); keyString;
+         keyString = cursor->nextKeyString()) {
+        opCtx->checkForInterrupt();
+        ++numKeys;
+    }
+
+    IndexStatistics::Builder builder(numKeys, maxBuckets);
+    for (auto key = cursor->seek(startKey, SortedDataInterface::Cursor::kWantKey);
+         key;
+         key = cursor->next(SortedDataInterface::Cursor::kWantKey)) {
+        opCtx->checkForInterrupt();
+        builder.addValue(key->key.firstElement());
+    }
+    return builder.done(keyPattern, numRecords);
+}
+
+/**
+ * Replaces the documents in the statistics collection 'statsNss' with one per analyzed index of
+ * the collection 'collectionUUID', removing those left behind by indexes which no longer exist.
+ */
+void persistIndexStatistics(OperationContext* opCtx,
+                            const NamespaceString& statsNss,
+                            const UUID& collectionUUID,
+                            const CollectionStatistics::IndexStatisticsMap& indexStats) {
+    std::vector<write_ops::UpdateOpEntry> updates;
+    BSONArrayBuilder indexNames;
+    for (auto&& [indexName, stats] : indexStats) {
+        BSONObjBuilder statsBuilder(stats->toBSON());
+        statsBuilder.append("_id", indexName);
+        collectionUUID.appendToBuilder(&statsBuilder, CollectionStatistics::kCollectionUUIDField);
+
+        write_ops::UpdateOpEntry update;
+        update.setQ(BSON("_id" << indexName));
+        update.setU(write_ops::UpdateModification::parseFromClassicUpdate(statsBuilder.obj()));
+        update.setUpsert(true);
+        updates.push_back(std::move(update));
+        indexNames.append(indexName);
+    }
+
+    DBDirectClient client(opCtx);
+    if (!updates.empty()) {
+        write_ops::UpdateCommandRequest updateOp(statsNss, std::move(updates));
+        auto reply =
+            client.runCommand(OpMsgRequest::fromDBAndBody(statsNss.db(), updateOp.toBSON({})));
+        uassertStatusOK(getStatusFromWriteCommandReply(reply->getCommandReply()));
+    }
+
+    write_ops::DeleteOpEntry deleteStale;
+    deleteStale.setQ(BSON("_id" << BSON("$nin" << indexNames.arr())));
+    deleteStale.setMulti(true);
+    write_ops::DeleteCommandRequest deleteOp(statsNss, {deleteStale});
+    auto reply = client.runCommand(OpMsgRequest::fromDBAndBody(statsNss.db(), deleteOp.toBSON({})));
+    uassertStatusOK(getStatusFromWriteCommandReply(reply->getCommandReply()));
+}
+
+/**
+ * The 'analyze' command gathers the statistics which let the planner rank candidate plans by
+ * estimated cost instead of running them against each other:
+ *
+ *    {
+ *        analyze: <collection>,
+ *        buckets: <maximum number of histogram buckets per index>
+ *    }
+ *
+ * Each btree index gets an equi-depth histogram and a distinct value count for its leading field.
+ * They are stored in <db>.system.statistics.<collection>, one document per index with the index
+ * name as its _id and the UUID of the collection, and take effect on this node immediately.
+ */
+class AnalyzeCommand final : public BasicCommand {
+public:
+    AnalyzeCommand() : BasicCommand("analyze") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override;
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        AuthorizationSession* authzSession = AuthorizationSession::get(client);
+        ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+        if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+            return Status::OK();
+        }
+
+        return Status(ErrorCodes::Unauthorized, "unauthorized");
+    }
+
+    std::string help() const override {
+        return "Gathers the index statistics used to rank query plans by estimated cost.";
+    }
+} analyzeCommand;
+
+bool AnalyzeCommand::run(OperationContext* opCtx,
+                         const std::string& dbname,
+                         const BSONObj& cmdObj,
+                         BSONObjBuilder& result) {
+    const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+    size_t maxBuckets = internalQueryStatisticsHistogramBuckets.load();
+    if (auto bucketsElem = cmdObj["buckets"]) {
+        uassert(ErrorCodes::BadValue,
+                "'buckets' must be a positive number",
+                bucketsElem.isNumber() && bucketsElem.safeNumberLong() > 0);
+        maxBuckets = bucketsElem.safeNumberLong();
+    }
+
+    CollectionStatistics::IndexStatisticsMap indexStats;
+    boost::optional<UUID> collectionUUID;
+    {
+        AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+        const auto& collection = autoColl.getCollection();
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << nss << " does not exist",
+                collection);
+        collectionUUID = collection->uuid();
+
+        const long long numRecords = collection->numRecords(opCtx);
+        auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (it->more()) {
+            const auto entry = it->next();
+            if (entry->descriptor()->getIndexType() != INDEX_BTREE) {
+                continue;
+            }
+            indexStats[entry->descriptor()->indexName()] =
+                std::make_shared<const IndexStatistics>(
+                    buildIndexStatistics(opCtx, entry, numRecords, maxBuckets));
+        }
+    }
+
+    persistIndexStatistics(opCtx, nss.makeStatisticsNamespace(), *collectionUUID, indexStats);
+
+    {
+        AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+        if (const auto& collection = autoColl.getCollection();
+            collection && collection->uuid() == *collectionUUID) {
+            CollectionStatistics::get(collection)
+                .set(indexStats, opCtx->getServiceContext()->getFastClockSource()->now());
+
+            // The cached plans were chosen without the new statistics.
+            CollectionQueryInfo::get(collection).getPlanCache()->clear();
+        }
+    }
+
+    LOGV2(6194507,
+          "Gathered index statistics",
+          "namespace"_attr = nss,
+          "numIndexes"_attr = indexStats.size());
+
+    BSONArrayBuilder indexesBuilder(result.subarrayStart("indexes"));
+    for (auto&& [indexName, stats] : indexStats) {
+        indexesBuilder.append(BSON("name" << indexName << "numKeys" << stats->numKeys()
+                                          << "numDistinct" << stats->numDistinct() << "numBuckets"
+                                          << static_cast<int>(stats->buckets().size())));
+    }
+    indexesBuilder.doneFast();
+    return true;
+}
+
+}  // namespace
+}  // namespace mongo
@@ -48,10 +48,12 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/create_indexes_gen.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/fts/fts_util.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -138,6 +140,16 @@ std::vector<BSONObj> parseAndValidateIndexSpecs(OperationContext* opCtx,
                     "Can't hide index on system collection",
                     !(ns.isSystem() && !ns.isTimeseriesBucketsCollection()) ||
                         indexSpec[IndexDescriptor::kHiddenFieldName].eoo());
+
+            // Earlier 5.0 binaries cannot read the keys of text indexes which store term
+            // positions. They share the featureCompatibilityVersion of this binary, so creating
+            // such indexes must be opted into.
+            uassert(ErrorCodes::CannotCreateIndex,
+                    str::stream() << "textIndexVersion " << fts::TEXT_INDEX_VERSION_4
+                                  << " requires featureFlagTextIndexPositions to be enabled",
+                    indexSpec[IndexDescriptor::kTextVersionFieldName].numberInt() !=
+                            fts::TEXT_INDEX_VERSION_4 ||
+                        feature_flags::gFeatureFlagTextIndexPositions.isEnabledAndIgnoreFCV());
         }
 
         indexSpecs.push_back(std::move(indexSpec));
@@ -50,7 +50,9 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -127,6 +129,57 @@ boost::intrusive_ptr<ExpressionContext> makeExpressionContext(
     return expCtx;
 }
 
+/**
+ * Returns whether the results of the find command running on 'opCtx' against 'collection' may be
+ * served from or stored in the QueryResultCache. The cached results reflect the latest committed
+ * writes, so only reads of the latest data outside of multi-document transactions qualify.
+ */
+bool canUseQueryResultCache(OperationContext* opCtx, const CollectionPtr& collection) {
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto readConcernLevel = readConcernArgs.getLevel();
+    return collection && !collection->isCapped() && !opCtx->inMultiDocumentTransaction() &&
+        (readConcernLevel == repl::ReadConcernLevel::kLocalReadConcern ||
+         readConcernLevel == repl::ReadConcernLevel::kAvailableReadConcern) &&
+        !readConcernArgs.getArgsAfterClusterTime() && !readConcernArgs.getArgsAtClusterTime() &&
+        opCtx->recoveryUnit()->getTimestampReadSource() ==
+        RecoveryUnit::ReadSource::kNoTimestamp &&
+        !OperationShardingState::isOperationVersioned(opCtx);
+}
+
+/**
+ * Answers the find command running on 'opCtx' with the results found in the QueryResultCache, as a
+ * single batch without a cursor.
+ */
+void replyWithCachedResults(OperationContext* opCtx,
+                            const NamespaceString& nss,
+                            const std::vector<BSONObj>& docs,
+                            rpc::ReplyBuilderInterface* result) {
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        CurOp::get(opCtx)->setPlanSummary_inlock("RESULT_CACHE"_sd);
+    }
+
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
+    CursorResponseBuilder firstBatch(result, options);
+    ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+    for (auto&& doc : docs) {
+        firstBatch.append(doc);
+        docUnitsReturned.observeOne(doc.objsize());
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().nreturned = docs.size();
+    curOp->debug().cursorid = -1;
+    curOp->debug().cursorExhausted = true;
+
+    firstBatch.done(0, nss.ns());
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    metricsCollector.incrementDocUnitsReturned(docUnitsReturned);
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -405,6 +458,15 @@ public:
                 }
             }
 
+            // If the collection is opted in to result caching, record the generation of its cached
+            // results before the storage snapshot is opened, so that results read from a snapshot
+            // which predates a committed write are never cached.
+            boost::optional<uint64_t> resultCacheGeneration;
+            if (const auto& cacheNss = findCommand->getNamespaceOrUUID().nss();
+                cacheNss && QueryResultCache::isEnabledFor(*cacheNss)) {
+                resultCacheGeneration = QueryResultCache::get(opCtx).getGeneration(*cacheNss);
+            }
+
             // Acquire locks. If the query is on a view, we release our locks and convert the query
             // request into an aggregation command.
             boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
@@ -471,6 +533,17 @@ public:
 
             const auto& collection = ctx->getCollection();
 
+            boost::optional<BSONObj> resultCacheKey;
+            if (resultCacheGeneration && canUseQueryResultCache(opCtx, collection)) {
+                resultCacheKey = QueryResultCache::makeKey(collection->uuid(), *cq);
+            }
+            if (resultCacheKey) {
+                if (auto cachedDocs = QueryResultCache::get(opCtx).lookup(*resultCacheKey)) {
+                    replyWithCachedResults(opCtx, nss, *cachedDocs, result);
+                    return;
+                }
+            }
+
             if (cq->getFindCommandRequest().getReadOnce()) {
                 // The readOnce option causes any storage-layer cursors created during plan
                 // execution to assume read data will not be needed again and need not be cached.
@@ -515,6 +588,7 @@ public:
             std::uint64_t numResults = 0;
             bool stashedResult = false;
             ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            std::vector<BSONObj> resultCacheDocs;
 
             try {
                 while (!FindCommon::enoughForFirstBatch(originalFC, numResults) &&
@@ -534,6 +608,9 @@ public:
                     firstBatch.append(obj);
                     numResults++;
                     docUnitsReturned.observeOne(obj.objsize());
+                    if (resultCacheKey) {
+                        resultCacheDocs.push_back(obj.getOwned());
+                    }
                 }
             } catch (DBException& exception) {
                 firstBatch.abandon();
@@ -602,6 +679,13 @@ public:
             // Generate the response object to send to the client.
             firstBatch.done(cursorId, nss.ns());
 
+            // Results which fit entirely in the first batch can be answered from the result cache
+            // next time.
+            if (resultCacheKey && cursorId == 0) {
+                QueryResultCache::get(opCtx).insert(
+                    nss, *resultCacheKey, *resultCacheGeneration, std::move(resultCacheDocs));
+            }
+
             // Increment this metric once we have generated a response and we know it will return
             // documents.
             auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
@@ -48,6 +48,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/fts/fts_util.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops.h"
@@ -675,6 +676,43 @@ private:
         }
     }
 
+    /**
+     * Fails the downgrade if any text index, including those still being built, stores term
+     * positions. Earlier versions cannot read the keys of such indexes.
+     *
+     * TODO (SERVER-56171): Remove once 5.0 is last-lts.
+     */
+    void _checkForTextIndexesWithPositions(OperationContext* opCtx) {
+        auto collCatalog = CollectionCatalog::get(opCtx);
+        for (const auto& db : collCatalog->getAllDbNames()) {
+            for (auto collIt = collCatalog->begin(opCtx, db); collIt != collCatalog->end(opCtx);
+                 ++collIt) {
+                NamespaceStringOrUUID collName(
+                    collCatalog->lookupNSSByUUID(opCtx, collIt.uuid().get()).get());
+                AutoGetCollectionForRead coll(opCtx, collName);
+                if (!coll) {
+                    continue;
+                }
+
+                std::vector<const IndexDescriptor*> textIndexes;
+                const bool includeUnfinishedIndexes = true;
+                coll->getIndexCatalog()->findIndexByType(
+                    opCtx, IndexNames::TEXT, textIndexes, includeUnfinishedIndexes);
+                for (auto&& textIndex : textIndexes) {
+                    uassert(ErrorCodes::CannotDowngrade,
+                            str::stream()
+                                << "Cannot downgrade the cluster when there are text indexes with "
+                                   "textIndexVersion "
+                                << fts::TEXT_INDEX_VERSION_4
+                                << "; drop them before downgrading. First detected index: "
+                                << textIndex->indexName() << " on " << coll->ns(),
+                            textIndex->infoObj()["textIndexVersion"].numberInt() <
+                                fts::TEXT_INDEX_VERSION_4);
+                }
+            }
+        }
+    }
+
     void _runDowngrade(OperationContext* opCtx,
                        const SetFeatureCompatibilityVersion& request,
                        boost::optional<Timestamp> changeTimestamp) {
@@ -756,6 +794,13 @@ private:
             Lock::GlobalLock lk(opCtx, MODE_S);
         }
 
+        // Text indexes which store term positions are only supported in 5.0. Index builds which
+        // started before the FCV changed are in the catalog by now, and no new ones can start.
+        // TODO (SERVER-56171): Remove once 5.0 is last-lts.
+        if (requestedVersion < FeatureCompatibility::Version::kVersion50) {
+            _checkForTextIndexesWithPositions(opCtx);
+        }
+
         uassert(ErrorCodes::Error(549181),
                 "Failing upgrade due to 'failDowngrading' failpoint set",
                 !failDowngrading.shouldFail());
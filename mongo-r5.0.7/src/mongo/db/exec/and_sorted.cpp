@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "mongo/db/exec/and_common.h"
+#include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/util/str.h"
@@ -42,6 +43,15 @@ using std::numeric_limits;
 using std::unique_ptr;
 using std::vector;
 
+namespace {
+
+// The number of consecutive results behind the target RecordId a child may return before we try to
+// seek it to the target instead. A seek costs a descent of the index, so for children which are
+// only slightly behind it is cheaper to keep stepping them.
+const size_t kResultsBehindTargetBeforeSeek = 4;
+
+}  // namespace
+
 // static
 const char* AndSortedStage::kStageType = "AND_SORTED";
 
@@ -148,6 +158,7 @@ PlanStage::StageState AndSortedStage::moveTowardTargetRecordId(WorkingSetID* out
             // The front element has hit _targetRecordId.  Don't move it forward anymore/work on
             // another element.
             _workingTowardRep.pop();
+            _resultsBehindTarget = 0;
             AndCommon::mergeFrom(_ws, _targetId, *member);
             _ws->free(id);
 
@@ -165,8 +176,12 @@ PlanStage::StageState AndSortedStage::moveTowardTargetRecordId(WorkingSetID* out
             return PlanStage::NEED_TIME;
         } else if (member->recordId < _targetRecordId) {
             // The front element of _workingTowardRep hasn't hit the thing we're AND-ing with
-            // yet.  Try again later.
+            // yet.  Try again later, skipping directly to _targetRecordId if it keeps lagging.
             _ws->free(id);
+            if (++_resultsBehindTarget >= kResultsBehindTargetBeforeSeek &&
+                seekChildToTargetRecordId(workingChildNumber)) {
+                _resultsBehindTarget = 0;
+            }
             return PlanStage::NEED_TIME;
         } else {
             // member->recordId > _targetRecordId.
@@ -183,6 +198,7 @@ PlanStage::StageState AndSortedStage::moveTowardTargetRecordId(WorkingSetID* out
             member->makeObjOwnedIfNeeded();
 
             _workingTowardRep = std::queue<size_t>();
+            _resultsBehindTarget = 0;
             for (size_t i = 0; i < _children.size(); ++i) {
                 if (workingChildNumber != i) {
                     _workingTowardRep.push(i);
@@ -204,6 +220,22 @@ PlanStage::StageState AndSortedStage::moveTowardTargetRecordId(WorkingSetID* out
     }
 }
 
+bool AndSortedStage::seekChildToTargetRecordId(size_t childNumber) {
+    auto& child = _children[childNumber];
+    if (child->stageType() != STAGE_IXSCAN) {
+        return false;
+    }
+
+    auto indexScan = static_cast<IndexScan*>(child.get());
+    if (!indexScan->canSeekToRecordId()) {
+        return false;
+    }
+
+    indexScan->seekToRecordId(_targetRecordId);
+    ++_specificStats.seeksToTarget;
+    return true;
+}
+
 unique_ptr<PlanStageStats> AndSortedStage::getStats() {
     _commonStats.isEOF = isEOF();
 
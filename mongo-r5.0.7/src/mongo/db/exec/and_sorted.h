@@ -72,6 +72,10 @@ private:
     // Returns the target node in 'out' if all children successfully advance to it.
     PlanStage::StageState moveTowardTargetRecordId(WorkingSetID* out);
 
+    // If the child at 'childNumber' is an index scan which can be repositioned by RecordId, seeks
+    // it directly to _targetRecordId and returns true. Otherwise returns false.
+    bool seekChildToTargetRecordId(size_t childNumber);
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -85,6 +89,11 @@ private:
     // These are indices into _children.
     std::queue<size_t> _workingTowardRep;
 
+    // The number of consecutive results the front of _workingTowardRep has returned which were
+    // behind _targetRecordId. Once this grows large enough we seek the child rather than keep
+    // stepping it.
+    size_t _resultsBehindTarget = 0;
+
     // If any child hits EOF or if we have any errors, we're EOF.
     bool _isEOF;
 
@@ -44,6 +44,7 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/query/query_knobs_gen.h"
@@ -64,12 +65,14 @@ CachedPlanStage::CachedPlanStage(ExpressionContext* expCtx,
                                  CanonicalQuery* cq,
                                  const QueryPlannerParams& params,
                                  size_t decisionWorks,
-                                 std::unique_ptr<PlanStage> root)
+                                 std::unique_ptr<PlanStage> root,
+                                 bool allowMidQueryReplanning)
     : RequiresAllIndicesStage(kStageType, expCtx, collection),
       _ws(ws),
       _canonicalQuery(cq),
       _plannerParams(params),
-      _decisionWorks(decisionWorks) {
+      _decisionWorks(decisionWorks),
+      _allowMidQueryReplanning(allowMidQueryReplanning) {
     _children.emplace_back(std::move(root));
 }
 
@@ -87,6 +90,8 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // Dismiss the requirement that no indices can be dropped when this method returns.
     ON_BLOCK_EXIT([this] { releaseAllIndicesRequirement(); });
 
+    _yieldPolicy = yieldPolicy;
+
     // If we work this many times during the trial period, then we will replan the
     // query from scratch.
     size_t maxWorksBeforeReplan =
@@ -133,7 +138,11 @@ Status CachedPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             _results.push(id);
 
             if (_results.size() >= numResults) {
-                // Once a plan returns enough results, stop working. There is no need to replan.
+                // Once a plan returns enough results, stop working. There is no need to replan
+                // now, but keep an eye on the plan in case it runs away later.
+                if (canReplanMidQuery()) {
+                    _maxWorksBetweenResults = maxWorksBeforeReplan;
+                }
                 return Status::OK();
             }
         } else if (PlanStage::IS_EOF == state) {
@@ -272,6 +281,105 @@ Status CachedPlanStage::replan(PlanYieldPolicy* yieldPolicy, bool shouldCache, s
     return Status::OK();
 }
 
+bool CachedPlanStage::canReplanMidQuery() const {
+    if (!_allowMidQueryReplanning ||
+        internalQueryCacheMaxRecordIdsForMidQueryReplanning.load() <= 0) {
+        return false;
+    }
+
+    // A projection discards the RecordIds of the results.
+    const auto& findCommand = _canonicalQuery->getFindCommandRequest();
+    return findCommand.getSort().isEmpty() && !findCommand.getSkip() && !findCommand.getLimit() &&
+        !findCommand.getNtoreturn() && !findCommand.getTailable() && !_canonicalQuery->getProj();
+}
+
+Status CachedPlanStage::replanMidQuery() {
+    auto explainer = plan_explainer_factory::make(child().get());
+    LOGV2_DEBUG(6194512,
+                1,
+                "Cached plan stopped producing results, replanning query mid-stream",
+                "maxWorksBetweenResults"_attr = *_maxWorksBetweenResults,
+                "numReturned"_attr = _returnedRecordIds.size(),
+                "query"_attr = redact(_canonicalQuery->toStringShort()),
+                "planSummary"_attr = explainer->getPlanSummary());
+
+    // We only try once, whether or not we manage to pick a new plan.
+    const auto maxWorks = *_maxWorksBetweenResults;
+    _maxWorksBetweenResults = boost::none;
+
+    // The indices may have changed since the trial period, so plan with the current set.
+    QueryPlannerParams plannerParams;
+    plannerParams.options = _plannerParams.options;
+    fillOutPlannerParams(expCtx()->opCtx, collection(), _canonicalQuery, &plannerParams);
+
+    // Stages above us may still hold members of the shared working set, so leave it alone.
+    // Members held by the candidate plans are released with the working set.
+    auto statusWithSolutions = QueryPlanner::plan(*_canonicalQuery, plannerParams);
+    if (!statusWithSolutions.isOK()) {
+        return statusWithSolutions.getStatus().withContext(
+            str::stream() << "error processing query: " << _canonicalQuery->toString()
+                          << " planner returned error");
+    }
+    auto solutions = std::move(statusWithSolutions.getValue());
+
+    PlanCache* cache = CollectionQueryInfo::get(collection()).getPlanCache();
+    cache->deactivate(*_canonicalQuery);
+
+    std::unique_ptr<QuerySolution> replannedQs;
+    std::unique_ptr<PlanStage> newRoot;
+    if (1 == solutions.size()) {
+        newRoot = stage_builder::buildClassicExecutableTree(
+            expCtx()->opCtx, collection(), *_canonicalQuery, *solutions[0], _ws);
+        replannedQs = std::move(solutions[0]);
+    } else {
+        auto multiPlanStage = std::make_unique<MultiPlanStage>(
+            expCtx(), collection(), _canonicalQuery, PlanCachingMode::AlwaysCache);
+        for (auto&& solution : solutions) {
+            if (solution->cacheData.get()) {
+                solution->cacheData->indexFilterApplied = plannerParams.indexFiltersApplied;
+            }
+
+            auto&& nextPlanRoot = stage_builder::buildClassicExecutableTree(
+                expCtx()->opCtx, collection(), *_canonicalQuery, *solution, _ws);
+            multiPlanStage->addPlan(std::move(solution), std::move(nextPlanRoot), _ws);
+        }
+
+        // Picking the best plan may yield. Keep the current plan as our second child meanwhile, so
+        // that it is saved and restored along with the candidates and can carry on should
+        // planning fail.
+        auto multiPlanStageRaw = multiPlanStage.get();
+        _children.insert(_children.begin(), std::move(multiPlanStage));
+        Status pickBestPlanStatus = Status::OK();
+        {
+            ON_BLOCK_EXIT([&] {
+                newRoot = std::move(_children.front());
+                _children.erase(_children.begin());
+            });
+            pickBestPlanStatus = multiPlanStageRaw->pickBestPlan(_yieldPolicy);
+        }
+        if (!pickBestPlanStatus.isOK()) {
+            return pickBestPlanStatus;
+        }
+    }
+
+    _children.clear();
+    _children.emplace_back(std::move(newRoot));
+    _replannedQs = std::move(replannedQs);
+    _plannerParams = std::move(plannerParams);
+    _replannedMidQuery = true;
+    _specificStats.replanReason = str::stream()
+        << "cached plan went " << maxWorks
+        << " works without producing a result after its trial period";
+
+    explainer = plan_explainer_factory::make(child().get());
+    LOGV2_DEBUG(6194513,
+                1,
+                "Query plan after replanning mid-stream",
+                "query"_attr = redact(_canonicalQuery->toStringShort()),
+                "planSummary"_attr = explainer->getPlanSummary());
+    return Status::OK();
+}
+
 bool CachedPlanStage::isEOF() {
     return _results.empty() && child()->isEOF();
 }
@@ -285,11 +393,59 @@ PlanStage::StageState CachedPlanStage::doWork(WorkingSetID* out) {
     if (!_results.empty()) {
         *out = _results.front();
         _results.pop();
-        return PlanStage::ADVANCED;
+        return trackResult(*out);
     }
 
     // Nothing left in trial period buffer.
-    return child()->work(out);
+    const auto state = child()->work(out);
+    if (state == PlanStage::ADVANCED) {
+        if (_replannedMidQuery && _returnedRecordIds.count(_ws->get(*out)->recordId)) {
+            // The plan we abandoned already returned this result.
+            _ws->free(*out);
+            return PlanStage::NEED_TIME;
+        }
+        return trackResult(*out);
+    }
+
+    if (state == PlanStage::NEED_TIME && _maxWorksBetweenResults &&
+        ++_worksSinceLastResult >= *_maxWorksBetweenResults) {
+        auto status = replanMidQuery();
+        if (!status.isOK()) {
+            // If the query was killed or interrupted while replanning, the current plan cannot
+            // carry on either. Otherwise some results have already been returned, so rather than
+            // failing the query we stick with the plan which produced them.
+            if (ErrorCodes::isInterruption(status) || status == ErrorCodes::QueryPlanKilled) {
+                uassertStatusOK(status);
+            }
+            LOGV2_DEBUG(6194514,
+                        1,
+                        "Failed to replan query mid-stream, continuing with the cached plan",
+                        "query"_attr = redact(_canonicalQuery->toStringShort()),
+                        "error"_attr = redact(status));
+        }
+    }
+    return state;
+}
+
+PlanStage::StageState CachedPlanStage::trackResult(WorkingSetID id) {
+    _worksSinceLastResult = 0;
+    if (!_maxWorksBetweenResults) {
+        return PlanStage::ADVANCED;
+    }
+
+    // If we cannot identify a result, or have returned too many to remember them all, we can no
+    // longer switch plans without risking returning a result twice.
+    WorkingSetMember* member = _ws->get(id);
+    if (!member->hasRecordId() ||
+        _returnedRecordIds.size() >=
+            static_cast<size_t>(internalQueryCacheMaxRecordIdsForMidQueryReplanning.load())) {
+        _maxWorksBetweenResults = boost::none;
+        _returnedRecordIds.clear();
+        return PlanStage::ADVANCED;
+    }
+
+    _returnedRecordIds.insert(member->recordId);
+    return PlanStage::ADVANCED;
 }
 
 std::unique_ptr<PlanStageStats> CachedPlanStage::getStats() {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <queue>
 
@@ -39,6 +40,7 @@
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -49,6 +51,13 @@ class PlanYieldPolicy;
  * high, the plan cache entry is deactivated and we use multi-planning to select an entirely new
  * winning plan. This process is called "replanning".
  *
+ * If the cached plan survives the trial period, we keep watching it. Should it later go as many
+ * work cycles without producing a result as the whole trial period was allowed, and the query can
+ * tolerate switching plans mid-stream, we replan once more and continue with the new winner,
+ * discarding any results it produces which the old plan has already returned. This replanning
+ * happens within work() and may yield, so it is only enabled when this stage is the root of a
+ * read-only plan. Should it fail, we carry on with the old plan.
+ *
  * This stage requires all indices to stay intact during the trial period so that replanning can
  * occur with the set of indices in 'params'. As a future improvement, we could instead refresh the
  * list of indices in 'params' prior to replanning, and thus avoid inheriting from
@@ -62,7 +71,8 @@ public:
                     CanonicalQuery* cq,
                     const QueryPlannerParams& params,
                     size_t decisionWorks,
-                    std::unique_ptr<PlanStage> root);
+                    std::unique_ptr<PlanStage> root,
+                    bool allowMidQueryReplanning = false);
 
     bool isEOF() final;
 
@@ -109,6 +119,30 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Returns true if the query may switch to a different plan after some of its results have
+     * been returned. This requires that the results can be returned in any order, that no skip or
+     * limit has been applied to the results returned so far, and that each result can be
+     * identified by its RecordId so that the new plan does not return it again.
+     */
+    bool canReplanMidQuery() const;
+
+    /**
+     * Called when the cached plan has gone '_maxWorksBetweenResults' work cycles after the trial
+     * period without producing a result. Re-plans the query, refreshing the set of indices since
+     * they may have changed since the trial period.
+     *
+     * The current plan is only replaced once a new winner has been picked, so it remains usable if
+     * this returns a non-OK status.
+     */
+    Status replanMidQuery();
+
+    /**
+     * Records that 'id' is about to be returned, remembering its RecordId while we may still
+     * replan mid-query. Returns ADVANCED.
+     */
+    StageState trackResult(WorkingSetID id);
+
     // Not owned.
     WorkingSet* _ws;
 
@@ -128,6 +162,23 @@ private:
     // Any results produced during trial period execution are kept here.
     std::queue<WorkingSetID> _results;
 
+    // Whether this stage is the root of a read-only plan, and so may replan mid-query.
+    const bool _allowMidQueryReplanning;
+
+    // The yield policy passed to pickBestPlan(), used again if we replan mid-query. Not owned.
+    PlanYieldPolicy* _yieldPolicy = nullptr;
+
+    // Set once the cached plan has passed its trial period if the query may later switch plans.
+    // The number of consecutive work cycles without a result after which we replan.
+    boost::optional<size_t> _maxWorksBetweenResults;
+    size_t _worksSinceLastResult = 0;
+
+    // The RecordIds of the results returned so far, while we may still replan mid-query.
+    stdx::unordered_set<RecordId, RecordId::Hasher> _returnedRecordIds;
+
+    // True once we have replanned mid-query, after which we discard results already returned.
+    bool _replannedMidQuery = false;
+
     // Stats
     CachedPlanStats _specificStats;
 };
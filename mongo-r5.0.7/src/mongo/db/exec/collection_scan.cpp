@@ -62,6 +62,7 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
+      _compiledFilter(Filter::compile(_filter)),
       _params(params) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
@@ -70,13 +71,10 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     _specificStats.tailable = params.tailable;
     if (params.minRecord || params.maxRecord) {
         // The 'minRecord' and 'maxRecord' parameters are used for a special optimization that
-        // applies only to forwards scans of the oplog and scans on collections clustered by _id.
+        // applies only to scans on collections clustered by _id, and to forward scans of other
+        // collections such as the oplog.
         invariant(!params.resumeAfterRecordId);
-        if (collection->ns().isOplog()) {
-            invariant(params.direction == CollectionScanParams::FORWARD);
-        } else {
-            invariant(collection->isClustered());
-        }
+        invariant(collection->isClustered() || params.direction == CollectionScanParams::FORWARD);
     }
     LOGV2_DEBUG(5400802,
                 5,
@@ -259,6 +257,15 @@ bool atEndOfRangeInclusive(const CollectionScanParams& params, const WorkingSetM
         return params.minRecord && member.recordId < *params.minRecord;
     }
 }
+
+// The initial seekNear() may position the scan on the record preceding its start bound.
+bool beforeStartOfRange(const CollectionScanParams& params, const WorkingSetMember& member) {
+    if (params.direction == CollectionScanParams::FORWARD) {
+        return params.minRecord && member.recordId < *params.minRecord;
+    } else {
+        return params.maxRecord && member.recordId > *params.maxRecord;
+    }
+}
 }  // namespace
 
 PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
@@ -275,9 +282,15 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
         return PlanStage::IS_EOF;
     }
 
-    if (Filter::passes(member, _filter)) {
+    if (beforeStartOfRange(_params, *member)) {
+        _workingSet->free(memberID);
+        return PlanStage::NEED_TIME;
+    }
+
+    if (Filter::passes(member, _filter, _compiledFilter.get_ptr())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter = boost::none;
         }
         *out = memberID;
         return PlanStage::ADVANCED;
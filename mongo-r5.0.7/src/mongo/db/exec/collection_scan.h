@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -122,6 +123,7 @@ private:
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
+    boost::optional<CompiledMatchExpression> _compiledFilter;
 
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -44,18 +44,18 @@ struct CollectionScanParams {
     // reverse scan. A forward scan will start scanning at the document with the lowest RecordId
     // greater than or equal to minRecord. A reverse scan will stop and return EOF on the first
     // document with a RecordId less than minRecord, or a higher record if none exists. May only
-    // be used for scans on collections clustered by _id and forward oplog scans. If exclusive
-    // bounds are required, a MatchExpression must be passed to the CollectionScan stage. This field
-    // cannot be used in conjunction with 'resumeAfterRecordId'
+    // be used for scans on collections clustered by _id and forward scans of other collections.
+    // If exclusive bounds are required, a MatchExpression must be passed to the CollectionScan
+    // stage. This field cannot be used in conjunction with 'resumeAfterRecordId'
     boost::optional<RecordId> minRecord;
 
     // If present, this parameter sets the start point of a reverse scan or the end point of a
     // forward scan. A forward scan will stop and return EOF on the first document with a RecordId
     // greater than maxRecord. A reverse scan will start scanning at the document with the
     // highest RecordId less than or equal to maxRecord, or a lower record if none exists. May
-    // only be used for scans on collections clustered by _id and forward oplog scans. If exclusive
-    // bounds are required, a MatchExpression must be passed to the CollectionScan stage. This field
-    // cannot be used in conjunction with 'resumeAfterRecordId'.
+    // only be used for scans on collections clustered by _id and forward scans of other
+    // collections. If exclusive bounds are required, a MatchExpression must be passed to the
+    // CollectionScan stage. This field cannot be used in conjunction with 'resumeAfterRecordId'.
     boost::optional<RecordId> maxRecord;
 
     // If true, the collection scan will return a token that can be used to resume the scan.
@@ -87,4 +87,13 @@ struct CollectionScanParams {
     bool shouldWaitForOplogVisibility = false;
 };
 
+/**
+ * Inclusive bounds on the RecordIds of the documents visited by a forward collection scan. Writes
+ * which are split between several workers assign each of them a range of RecordIds.
+ */
+struct RecordIdBounds {
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+};
+
 }  // namespace mongo
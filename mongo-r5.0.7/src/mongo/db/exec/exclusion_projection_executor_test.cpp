@@ -35,6 +35,7 @@
 #include <iterator>
 #include <string>
 
+#include "mongo/base/exact_cast.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
@@ -86,6 +87,18 @@ auto makeExclusionProjectionWithNoArrayRecursion(const BSONObj& spec) {
     return createProjectionExecutor(spec, noArrayRecursion);
 }
 
+// Helper to create an ExclusionProjectionExecutor with the fast-path BSON-to-BSON projection mode
+// allowed. Asserts that the fast-path node has been chosen for the projection.
+auto makeFastPathExclusionProjection(const BSONObj& spec, const ProjectionPolicies& policies = {}) {
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto projection = projection_ast::parse(expCtx, spec, policies);
+    auto executor = buildProjectionExecutor(expCtx, &projection, policies, kDefaultBuilderParams);
+    invariant(executor->getType() == TransformerInterface::TransformerType::kExclusionProjection);
+    auto exclusionExecutor = static_cast<ExclusionProjectionExecutor*>(executor.get());
+    ASSERT(exact_pointer_cast<FastPathEligibleExclusionNode*>(exclusionExecutor->getRoot()));
+    return executor;
+}
+
 TEST(ExclusionProjectionExecutionTest, ShouldSerializeToEquivalentProjection) {
     auto exclusion = makeExclusionProjectionWithDefaultPolicies(
         fromjson("{a: 0, b: {c: NumberLong(0), d: 0.0}, 'x.y': false, _id: NumberInt(0)}"));
@@ -548,6 +561,78 @@ TEST(ExclusionProjectionExecutionTest, ShouldNotRetainNestedArraysIfNoRecursionN
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+//
+// Fast-path BSON-to-BSON exclusion projection tests.
+//
+
+TEST(ExclusionProjectionExecutionTest, ShouldNotUseFastPathWithMetaExpressions) {
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto projection = projection_ast::parse(
+        expCtx, fromjson("{a: 0, c: {$meta: 'textScore'}}"), ProjectionPolicies{});
+    auto executor =
+        buildProjectionExecutor(expCtx, &projection, ProjectionPolicies{}, kDefaultBuilderParams);
+    auto exclusionExecutor = static_cast<ExclusionProjectionExecutor*>(executor.get());
+    ASSERT_FALSE(exact_pointer_cast<FastPathEligibleExclusionNode*>(exclusionExecutor->getRoot()));
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldExcludeTopLevelAndDottedFields) {
+    auto exclusion = makeFastPathExclusionProjection(fromjson("{a: 0, 'b.c': 0, 'b.d.e': 0}"));
+
+    auto result = exclusion->applyTransformation(
+        Document{fromjson("{_id: 1, a: 1, b: {c: 2, d: {e: 3, f: 4}, g: 5}, h: 6}")});
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{_id: 1, b: {d: {f: 4}, g: 5}, h: 6}")});
+
+    // Scalars on a dotted exclusion path are retained, and missing paths are not created.
+    result = exclusion->applyTransformation(Document{fromjson("{_id: 1, b: 2, h: 6}")});
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{_id: 1, b: 2, h: 6}")});
+    result = exclusion->applyTransformation(Document{fromjson("{_id: 1, a: 1}")});
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{_id: 1}")});
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldApplyDottedExclusionToEachElementInArray) {
+    auto exclusion = makeFastPathExclusionProjection(BSON("a.b" << false));
+
+    auto result = exclusion->applyTransformation(
+        Document{fromjson("{a: [1, {}, {b: 1}, {b: 1, c: 2}, [], [1, {c: 1, b: 1}]]}")});
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{a: [1, {}, {}, {c: 2}, [], [1, {c: 1}]]}")});
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldNotRecurseNestedArraysForNoRecursePolicy) {
+    ProjectionPolicies noArrayRecursion{
+        ProjectionPolicies::kDefaultIdPolicyDefault,
+        ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays,
+        ProjectionPolicies::kComputedFieldsPolicyDefault};
+    auto exclusion = makeFastPathExclusionProjection(BSON("a.b" << false), noArrayRecursion);
+
+    auto result = exclusion->applyTransformation(
+        Document{fromjson("{a: [1, {b: 2, c: 3}, [{b: 4, c: 5}], {d: 6}]}")});
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{a: [1, {c: 3}, [{b: 4, c: 5}], {d: 6}]}")});
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldPreserveFieldOrderAndMetadata) {
+    auto exclusion = makeFastPathExclusionProjection(fromjson("{_id: 0, 'c.x': 0}"));
+
+    MutableDocument inputDocBuilder(Document{fromjson("{d: 1, _id: 2, c: {y: 1, x: 2}, a: 3}")});
+    inputDocBuilder.metadata().setTextScore(10.0);
+    Document inputDoc = inputDocBuilder.freeze();
+
+    auto result = exclusion->applyTransformation(inputDoc);
+
+    MutableDocument expectedDoc(Document{fromjson("{d: 1, c: {y: 1}, a: 3}")});
+    expectedDoc.copyMetaDataFrom(inputDoc);
+    ASSERT_DOCUMENT_EQ(result, expectedDoc.freeze());
+    ASSERT_EQ(result.metadata().getTextScore(), 10.0);
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathShouldFallBackToDefaultForNonBsonDocuments) {
+    auto exclusion = makeFastPathExclusionProjection(BSON("a.b" << false));
+
+    MutableDocument inputDocBuilder(Document{fromjson("{a: {b: 1, c: 2}}")});
+    inputDocBuilder.addField("d", Value(3));
+    auto result = exclusion->applyTransformation(inputDocBuilder.freeze());
+    ASSERT_DOCUMENT_EQ(result, Document{fromjson("{a: {c: 2}, d: 3}")});
+}
+
 //
 // extractProjectOnFieldAndRename() tests.
 //
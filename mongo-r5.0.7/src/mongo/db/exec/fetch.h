@@ -33,6 +33,7 @@
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 
@@ -94,6 +95,7 @@ private:
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
+    boost::optional<CompiledMatchExpression> _compiledFilter;
 
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
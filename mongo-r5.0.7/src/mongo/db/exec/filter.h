@@ -29,9 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/matchable.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -159,6 +163,30 @@ public:
         return filter->matches(&doc, nullptr);
     }
 
+    /**
+     * As above, but evaluates the filter through 'compiledFilter', if one was built from 'filter'
+     * by compile() and 'wsm' has a document to match against.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       const CompiledMatchExpression* compiledFilter) {
+        if (compiledFilter && wsm->hasObj()) {
+            return compiledFilter->matchesBSON(wsm->doc.value().toBson());
+        }
+        return passes(wsm, filter);
+    }
+
+    /**
+     * Compiles 'filter' for repeated evaluation against documents, unless it is NULL or compiled
+     * filters are disabled.
+     */
+    static boost::optional<CompiledMatchExpression> compile(const MatchExpression* filter) {
+        if (!filter || !internalQueryEnableCompiledMatchExpressions.load()) {
+            return boost::none;
+        }
+        return CompiledMatchExpression(filter);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
@@ -775,6 +775,47 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+// Returns the area in square meters of the spherical cap with the given radius in meters.
+double capArea(double radius) {
+    const double angle = std::min(std::max(radius, 0.0) / kRadiusOfEarthInMeters, M_PI);
+    return 2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters * (1 - std::cos(angle));
+}
+
+// Returns the radius in meters of the spherical cap with the given area in square meters.
+double capRadius(double area) {
+    const double height = area / (2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters);
+    return std::acos(std::max(1 - height, -1.0)) * kRadiusOfEarthInMeters;
+}
+
+/**
+ * Returns the width of the next annulus, given the width of the last one and the number of results
+ * found in it. Assuming the results around the search point are as dense as in the last annulus,
+ * the next annulus is sized to hold the target number of results. As the density of a few results
+ * is a rough estimate, the width changes at most 4 times from one annulus to the next.
+ */
+double nextSphereBoundsIncrement(const IntervalStats& lastIntervalStats, double lastIncrement) {
+    const double maxIncrement = lastIncrement * 4;
+    if (lastIntervalStats.numResultsReturned == 0) {
+        // Cross sparse areas quickly.
+        return maxIncrement;
+    }
+
+    const double inner = std::max(lastIntervalStats.minDistanceAllowed, 0.0);
+    const double outer = lastIntervalStats.maxDistanceAllowed;
+    const double lastArea = capArea(outer) - capArea(inner);
+    if (lastArea <= 0) {
+        return lastIncrement;
+    }
+
+    const double target = gInternalQueryS2GeoNearTargetResultsPerInterval.load();
+    const double nextArea = lastArea * target / lastIntervalStats.numResultsReturned;
+    const double increment = capRadius(capArea(outer) + nextArea) - outer;
+    if (!(increment > 0)) {
+        return lastIncrement;
+    }
+    return std::min(std::max(increment, lastIncrement / 4), maxIncrement);
+}
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const CollectionPtr& collection,
@@ -945,13 +986,8 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     //
 
     if (!_specificStats.intervalStats.empty()) {
-        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement =
+            nextSphereBoundsIncrement(_specificStats.intervalStats.back(), _boundsIncrement);
     }
 
     invariant(_boundsIncrement > 0.0);
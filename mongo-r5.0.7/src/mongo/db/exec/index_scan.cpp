@@ -33,8 +33,10 @@
 
 #include "mongo/db/exec/index_scan.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
@@ -42,6 +44,8 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace {
 
@@ -73,6 +77,7 @@ IndexScan::IndexScan(ExpressionContext* expCtx,
       _forward(params.direction == 1),
       _shouldDedup(params.shouldDedup),
       _addKeyMetadata(params.addKeyMetadata),
+      _topKSortBound(std::move(params.topKSortBound)),
       _startKeyInclusive(IndexBounds::isStartIncludedInBound(params.bounds.boundInclusion)),
       _endKeyInclusive(IndexBounds::isEndIncludedInBound(params.bounds.boundInclusion)) {
     _specificStats.indexName = params.name;
@@ -123,6 +128,8 @@ boost::optional<IndexKeyEntry> IndexScan::initIndexScan() {
                 _forward,
                 _startKeyInclusive);
             return _indexCursor->seek(keyStringForSeek);
+        } else if (initPointProbes()) {
+            return probeNextPoint();
         } else {
             _checker.reset(new IndexBoundsChecker(&_bounds, _keyPattern, _direction));
 
@@ -137,6 +144,58 @@ boost::optional<IndexKeyEntry> IndexScan::initIndexScan() {
     }
 }
 
+bool IndexScan::initPointProbes() {
+    const auto threshold = internalQueryIndexScanPointProbeThreshold.load();
+    if (threshold <= 0 || _bounds.fields.empty()) {
+        return false;
+    }
+
+    const auto& points = _bounds.fields[0].intervals;
+    if (points.size() < static_cast<size_t>(threshold) ||
+        !std::all_of(points.begin(), points.end(), [](auto&& interval) {
+            return interval.isPoint();
+        })) {
+        return false;
+    }
+
+    for (size_t i = 1; i < _bounds.fields.size(); ++i) {
+        const auto& intervals = _bounds.fields[i].intervals;
+        if (intervals.size() != 1 || !(intervals[0].isMinToMax() || intervals[0].isMaxToMin())) {
+            return false;
+        }
+    }
+
+    // The points are already in the order of the scan, and each spans every key which begins with
+    // it, from the start of each remaining field's interval to its end.
+    const auto sdi = indexAccessMethod()->getSortedDataInterface();
+    _pointProbes.reserve(points.size());
+    for (auto&& point : points) {
+        BSONObjBuilder startKey;
+        BSONObjBuilder endKey;
+        startKey.appendAs(point.start, "");
+        endKey.appendAs(point.end, "");
+        for (size_t i = 1; i < _bounds.fields.size(); ++i) {
+            startKey.appendAs(_bounds.fields[i].intervals[0].start, "");
+            endKey.appendAs(_bounds.fields[i].intervals[0].end, "");
+        }
+        _pointProbes.push_back(
+            {IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(startKey.obj(),
+                                                                   sdi->getKeyStringVersion(),
+                                                                   sdi->getOrdering(),
+                                                                   _forward,
+                                                                   true /* inclusive */),
+             endKey.obj()});
+    }
+    return true;
+}
+
+boost::optional<IndexKeyEntry> IndexScan::probeNextPoint() {
+    invariant(_nextPointProbe < _pointProbes.size());
+    const auto& probe = _pointProbes[_nextPointProbe++];
+    _indexCursor->setEndPosition(probe.endKey, true /* inclusive */);
+    return _indexCursor->seek(probe.seekKey);
+}
+
 PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     // Get the next kv pair from the index, if any.
     boost::optional<IndexKeyEntry> kv;
@@ -156,6 +215,20 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
                     indexAccessMethod()->getSortedDataInterface()->getOrdering(),
                     _forward));
                 break;
+            case NEED_SEEK_TO_RECORD_ID:
+                ++_specificStats.seeks;
+                kv = _indexCursor->seek(
+                    KeyString::Builder(
+                        indexAccessMethod()->getSortedDataInterface()->getKeyStringVersion(),
+                        _startKey,
+                        indexAccessMethod()->getSortedDataInterface()->getOrdering(),
+                        _recordIdSeekTarget)
+                        .getValueCopy());
+                break;
+            case NEED_POINT_PROBE:
+                ++_specificStats.seeks;
+                kv = probeNextPoint();
+                break;
             case HIT_END:
                 return PlanStage::IS_EOF;
         }
@@ -202,6 +275,12 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
         }
     }
 
+    if (!kv && _nextPointProbe < _pointProbes.size()) {
+        // We have reached the end of the current point. Move on to the next one.
+        _scanState = NEED_POINT_PROBE;
+        return PlanStage::NEED_TIME;
+    }
+
     if (!kv) {
         _scanState = HIT_END;
         _commonStats.isEOF = true;
@@ -211,6 +290,13 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     _scanState = GETTING_NEXT;
 
+    if (_topKSortBound && _topKSortBound->canSkip(kv->key)) {
+        // A top-k sort above us has already buffered enough results which are at least as good
+        // as this one, so there is no need to fetch or filter it.
+        ++_specificStats.keysSkippedByTopKBound;
+        return PlanStage::NEED_TIME;
+    }
+
     if (_shouldDedup) {
         ++_specificStats.dupsTested;
         if (!_returned.insert(kv->loc).second) {
@@ -247,11 +333,28 @@ bool IndexScan::isEOF() {
     return _commonStats.isEOF;
 }
 
+bool IndexScan::canSeekToRecordId() const {
+    // Only a forward scan over a single point of a non-unique index is guaranteed to produce its
+    // keys in RecordId order. Keys of a unique index do not end in a RecordId, and we only allow
+    // seeking once the cursor has been established. Scans which probe a list of points leave the
+    // start and end keys empty, so they must be excluded explicitly.
+    return _scanState == GETTING_NEXT && _forward && !_checker && _pointProbes.empty() &&
+        !_specificStats.isUnique && _startKeyInclusive && _endKeyInclusive &&
+        !_startKey.isEmpty() && SimpleBSONObjComparator::kInstance.evaluate(_startKey == _endKey);
+}
+
+void IndexScan::seekToRecordId(const RecordId& recordId) {
+    invariant(canSeekToRecordId());
+    _recordIdSeekTarget = recordId;
+    _scanState = NEED_SEEK_TO_RECORD_ID;
+}
+
 void IndexScan::doSaveStateRequiresIndex() {
     if (!_indexCursor)
         return;
 
-    if (_scanState == NEED_SEEK) {
+    if (_scanState == NEED_SEEK || _scanState == NEED_SEEK_TO_RECORD_ID ||
+        _scanState == NEED_POINT_PROBE) {
         _indexCursor->saveUnpositioned();
         return;
     }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/exec/top_k_sort_bound.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -80,6 +81,10 @@ struct IndexScanParams {
 
     // Do we want to add the key as metadata?
     bool addKeyMetadata{false};
+
+    // If set, the cutoff of a top-k sort above this scan. Entries which cannot make it into the
+    // top-k are discarded by the scan.
+    std::shared_ptr<TopKSortBound> topKSortBound;
 };
 
 /**
@@ -101,6 +106,12 @@ public:
         // Skipping keys as directed by the _checker.
         NEED_SEEK,
 
+        // Skipping keys as directed by a call to seekToRecordId().
+        NEED_SEEK_TO_RECORD_ID,
+
+        // Probing the index for the next entry of _pointProbes.
+        NEED_POINT_PROBE,
+
         // Retrieving the next key, and applying the filter if necessary.
         GETTING_NEXT,
 
@@ -127,6 +138,21 @@ public:
 
     const SpecificStats* getSpecificStats() const final;
 
+    /**
+     * Returns true if this scan is positioned within a single point of a non-unique index and
+     * scanning forward, in which case it produces RecordIds in ascending order and can skip ahead
+     * to a given RecordId with a single seek.
+     */
+    bool canSeekToRecordId() const;
+
+    /**
+     * Repositions the scan so that the next call to work() examines the first key of the point
+     * whose RecordId is greater than or equal to 'recordId'. Used by AND_SORTED to leapfrog over
+     * RecordIds which cannot be part of the intersection rather than stepping through them one
+     * key at a time. Must only be called if canSeekToRecordId() returns true.
+     */
+    void seekToRecordId(const RecordId& recordId);
+
     static const char* kStageType;
 
 protected:
@@ -140,6 +166,19 @@ private:
      */
     boost::optional<IndexKeyEntry> initIndexScan();
 
+    /**
+     * If the bounds consist of at least 'internalQueryIndexScanPointProbeThreshold' points on the
+     * leading field of the index, with every other field unbounded, fills out _pointProbes and
+     * returns true.
+     */
+    bool initPointProbes();
+
+    /**
+     * Positions the index cursor on the first key of the next entry of _pointProbes, returning
+     * that key if there is one.
+     */
+    boost::optional<IndexKeyEntry> probeNextPoint();
+
     // The WorkingSet we fill with results.  Not owned by us.
     WorkingSet* const _workingSet;
 
@@ -161,12 +200,18 @@ private:
     // Do we want to add the key as metadata?
     const bool _addKeyMetadata;
 
+    // Shared with a top-k sort above us, or null if there is no such sort.
+    const std::shared_ptr<TopKSortBound> _topKSortBound;
+
     // Stats
     IndexScanStats _specificStats;
 
     // Keeps track of what work we need to do next.
     ScanState _scanState = ScanState::INITIALIZING;
 
+    // The RecordId to seek to when in the NEED_SEEK_TO_RECORD_ID state.
+    RecordId _recordIdSeekTarget;
+
     // Could our index have duplicates?  If so, we use _returned to dedup.
     stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
 
@@ -184,6 +229,21 @@ private:
     std::unique_ptr<IndexBoundsChecker> _checker;
     IndexSeekPoint _seekPoint;
 
+    //
+    // 1a) As a special case, if the bounds are a long list of points on the leading field of the
+    //     index, such as those produced by a large $in, then rather than checking every key
+    //     against the bounds we probe the index for each point in turn. The seek key for each
+    //     point is encoded once up front, and the cursor's end position stops the scan at the end
+    //     of the point. In this case _checker is NULL and _pointProbes is non-empty.
+    //
+
+    struct PointProbe {
+        KeyString::Value seekKey;
+        BSONObj endKey;
+    };
+    std::vector<PointProbe> _pointProbes;
+    size_t _nextPointProbe = 0;
+
     //
     // 2) If the index scan is a single contiguous interval, then the scan can execute faster by
     //    letting the index cursor tell us when it hits the end, rather than repeatedly doing
@@ -174,6 +174,7 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+            abandonOutperformedCandidates(numResults);
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -289,6 +290,48 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+void MultiPlanStage::abandonOutperformedCandidates(size_t numResults) {
+    auto worksOf = [](const plan_ranker::CandidatePlan& candidate) {
+        return candidate.root->getCommonStats()->works;
+    };
+
+    const plan_ranker::CandidatePlan* leader = nullptr;
+    for (auto&& candidate : _candidates) {
+        if (candidate.status.isOK() &&
+            (!leader ||
+             candidate.results.size() * worksOf(*leader) >
+                 leader->results.size() * worksOf(candidate))) {
+            leader = &candidate;
+        }
+    }
+    if (!leader) {
+        return;
+    }
+
+    for (auto&& candidate : _candidates) {
+        if (&candidate == leader || !candidate.status.isOK() ||
+            candidate.solution->hasBlockingStage) {
+            continue;
+        }
+        if (trial_period::isOutperformedByLeader(candidate.results.size(),
+                                                 worksOf(candidate),
+                                                 leader->results.size(),
+                                                 worksOf(*leader),
+                                                 numResults)) {
+            LOGV2_DEBUG(6194509,
+                        5,
+                        "Abandoning candidate plan outperformed during the trial period",
+                        "results"_attr = candidate.results.size(),
+                        "works"_attr = worksOf(candidate),
+                        "leaderResults"_attr = leader->results.size(),
+                        "leaderWorks"_attr = worksOf(*leader));
+            candidate.status = {ErrorCodes::QueryPlanKilled,
+                                "candidate plan was outperformed during the trial period"};
+            ++_failureCount;
+        }
+    }
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
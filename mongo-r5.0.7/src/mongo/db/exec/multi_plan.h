@@ -153,6 +153,13 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Marks as failed the candidates without blocking stages which are so much less productive
+     * than the leading candidate that they cannot win, so that the rest of the trial period is
+     * not spent working them. The leading candidate is never abandoned.
+     */
+    void abandonOutperformedCandidates(size_t numResults);
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
@@ -191,6 +198,8 @@ private:
     //
     // Arbitrary error codes are not swallowed by the multi-planner, since it is not know whether it
     // is safe for the query to continue executing.
+    //
+    // Candidates abandoned because they were outperformed are counted as failed as well.
     size_t _failureCount = 0u;
 
     // Stats
@@ -210,6 +210,9 @@ struct AndSortedStats : public SpecificStats {
 
     // How many results from each child did not pass the AND?
     std::vector<size_t> failedAnd;
+
+    // How many times was a child index scan repositioned directly to the target RecordId?
+    size_t seeksToTarget = 0u;
 };
 
 struct CachedPlanStats : public SpecificStats {
@@ -471,7 +474,8 @@ struct IndexScanStats : public SpecificStats {
           dupsTested(0),
           dupsDropped(0),
           keysExamined(0),
-          seeks(0) {}
+          seeks(0),
+          keysSkippedByTopKBound(0) {}
 
     std::unique_ptr<SpecificStats> clone() const final {
         auto specific = std::make_unique<IndexScanStats>(*this);
@@ -533,6 +537,10 @@ struct IndexScanStats : public SpecificStats {
 
     // Number of times the index cursor is re-positioned during the execution of the scan.
     size_t seeks;
+
+    // Number of examined keys which were discarded because they could not make it into the result
+    // of a top-k sort above the scan.
+    size_t keysSkippedByTopKBound;
 };
 
 struct LimitStats : public SpecificStats {
@@ -788,6 +796,16 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // Number of top scoring documents requested, or 0 if all matching documents are returned.
+    size_t limit = 0;
+
+    // Whether the stage stopped reading postings once it knew the top scoring documents.
+    bool stoppedEarly = false;
+
+    // Number of documents skipped without a fetch because the term positions in the index showed
+    // that they do not contain a phrase of the query.
+    size_t docsRejectedByPhrase = 0;
 };
 
 struct TrialStats : public SpecificStats {
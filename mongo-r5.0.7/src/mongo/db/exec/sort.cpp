@@ -61,6 +61,11 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
             // The plan must be structured such that a previous stage has attached the sort key
             // metadata.
             spool(id);
+            if (_topKSortBound) {
+                if (auto cutoff = getCutoffSortKey()) {
+                    _topKSortBound->setThreshold(std::move(*cutoff));
+                }
+            }
             return PlanStage::NEED_TIME;
         } else if (code == PlanStage::IS_EOF) {
             // The child has returned all of its results. Record this fact so that subsequent calls
@@ -36,6 +36,7 @@
 #include "mongo/db/exec/sort_executor.h"
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/sort_key_generator.h"
+#include "mongo/db/exec/top_k_sort_bound.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/record_id.h"
 
@@ -83,6 +84,21 @@ public:
      */
     virtual StageState unspool(WorkingSetID* out) = 0;
 
+    /**
+     * Returns the sort key which any further input must beat in order to be retained by a top-k
+     * sort, or boost::none if no such key has been established.
+     */
+    virtual boost::optional<Value> getCutoffSortKey() const = 0;
+
+    /**
+     * Arranges for the cutoff of this top-k sort to be published to 'bound' as documents are
+     * spooled, so that a descendant index scan can discard entries which cannot make it into the
+     * result set.
+     */
+    void setTopKSortBound(std::shared_ptr<TopKSortBound> bound) {
+        _topKSortBound = std::move(bound);
+    }
+
     StageState doWork(WorkingSetID* out) final;
 
     std::unique_ptr<PlanStageStats> getStats() override final;
@@ -98,6 +114,9 @@ protected:
 private:
     // Whether or not we have finished loading data into '_sortExecutor'.
     bool _populated = false;
+
+    // If set, receives the cutoff of this top-k sort each time a document is spooled.
+    std::shared_ptr<TopKSortBound> _topKSortBound;
 };
 
 /**
@@ -132,6 +151,10 @@ public:
         return &_sortExecutor.stats();
     }
 
+    boost::optional<Value> getCutoffSortKey() const final {
+        return _sortExecutor.getCutoffSortKey();
+    }
+
 private:
     SortExecutor<SortableWorkingSetMember> _sortExecutor;
 };
@@ -173,6 +196,10 @@ public:
         return &_sortExecutor.stats();
     }
 
+    boost::optional<Value> getCutoffSortKey() const final {
+        return _sortExecutor.getCutoffSortKey();
+    }
+
 private:
     SortExecutor<BSONObj> _sortExecutor;
 };
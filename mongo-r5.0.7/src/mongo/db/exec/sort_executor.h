@@ -144,6 +144,18 @@ public:
         _sorter.reset();
     }
 
+    /**
+     * Returns the sort key which any further input must beat in order to be part of a top-k sort
+     * result, or boost::none if there is no limit or no such key has been established yet. Should
+     * only be called before 'loadingDone()' is called.
+     */
+    boost::optional<Value> getCutoffSortKey() const {
+        if (!_sorter) {
+            return boost::none;
+        }
+        return _sorter->getCutoffKey();
+    }
+
     /**
      * Returns true if there are more results which can be returned via 'getNext()', or false to
      * indicate end-of-stream. Should only be called after 'loadingDone()' is called.
@@ -182,6 +194,7 @@ private:
         if (_diskUseAllowed) {
             opts.extSortAllowed = true;
             opts.tempDir = _tempDir;
+            opts.spillInBackground = internalSorterSpillInBackground.load();
         }
 
         return opts;
@@ -304,4 +304,63 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, TopKSortPublishesCutoffToBound) {
+    WorkingSet ws;
+
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx(), nullptr, kNss);
+
+    auto queuedDataStage = std::make_unique<QueuedDataStage>(expCtx.get(), &ws);
+    for (auto&& obj : {BSON("a" << 5), BSON("a" << 1), BSON("a" << 3), BSON("a" << 4)}) {
+        WorkingSetID id = ws.allocate();
+        WorkingSetMember* wsm = ws.get(id);
+        wsm->doc = {SnapshotId(), Document{obj}};
+        wsm->transitionToOwnedObj();
+        queuedDataStage->pushBack(id);
+    }
+
+    auto sortPattern = BSON("a" << 1);
+    SortStageDefault sort(expCtx,
+                          &ws,
+                          SortPattern{sortPattern, expCtx},
+                          2u,
+                          kMaxMemoryUsageBytes,
+                          false,  // addSortKeyMetadata
+                          std::move(queuedDataStage));
+
+    // The sort field is the second field of the hypothetical index key.
+    auto bound = std::make_shared<TopKSortBound>(sortPattern, std::vector<size_t>{1});
+    sort.setTopKSortBound(bound);
+
+    // No cutoff is known until the sort has buffered 'limit' documents.
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    ASSERT_EQUALS(sort.work(&id), PlanStage::NEED_TIME);
+    ASSERT_FALSE(bound->hasThreshold());
+    ASSERT_FALSE(bound->canSkip(BSON("" << 0 << "" << 100)));
+
+    // After {a: 5} and {a: 1} have been buffered, the worst kept sort key is 5.
+    ASSERT_EQUALS(sort.work(&id), PlanStage::NEED_TIME);
+    ASSERT_TRUE(bound->hasThreshold());
+    ASSERT_TRUE(bound->canSkip(BSON("" << 0 << "" << 6)));
+    ASSERT_TRUE(bound->canSkip(BSON("" << 0 << "" << 5)));
+    ASSERT_FALSE(bound->canSkip(BSON("" << 0 << "" << 4)));
+
+    // Buffering {a: 3} tightens the cutoff to 3.
+    ASSERT_EQUALS(sort.work(&id), PlanStage::NEED_TIME);
+    ASSERT_TRUE(bound->canSkip(BSON("" << 0 << "" << 4)));
+    ASSERT_FALSE(bound->canSkip(BSON("" << 0 << "" << 2)));
+}
+
+TEST(TopKSortBoundTest, DescendingCompoundBound) {
+    TopKSortBound bound(BSON("a" << -1 << "b" << 1), std::vector<size_t>{2, 0});
+    ASSERT_FALSE(bound.canSkip(BSON("" << 1 << "" << 1 << "" << 1)));
+
+    // Keys are laid out as {b, <unused>, a}; the sort key is {a: -1, b: 1}.
+    bound.setThreshold(Value(std::vector<Value>{Value(10), Value(5)}));
+    ASSERT_TRUE(bound.canSkip(BSON("" << 5 << "" << 0 << "" << 9)));
+    ASSERT_TRUE(bound.canSkip(BSON("" << 5 << "" << 0 << "" << 10)));
+    ASSERT_TRUE(bound.canSkip(BSON("" << 6 << "" << 0 << "" << 10)));
+    ASSERT_FALSE(bound.canSkip(BSON("" << 4 << "" << 0 << "" << 10)));
+    ASSERT_FALSE(bound.canSkip(BSON("" << 100 << "" << 0 << "" << 11)));
+}
 }  // namespace
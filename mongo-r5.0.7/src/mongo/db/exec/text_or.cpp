@@ -29,6 +29,8 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <vector>
@@ -52,17 +54,37 @@ using fts::FTSSpec;
 
 const char* TextOrStage::kStageType = "TEXT_OR";
 
+namespace {
+
+// Checking whether the top documents are known takes time linear in the number of documents seen,
+// so it is done after a number of postings proportional to it.
+const size_t kMinPostingsBetweenTopKChecks = 128;
+
+// The children that contributed to the score of a document are tracked in a 64 bit mask.
+const size_t kMaxChildrenForTopK = 64;
+
+}  // namespace
+
 TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          size_t keyPrefixSize,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         std::vector<fts::PhraseTermPosition> phraseTermScans,
+                         boost::optional<TopKParams> topKParams)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _keyPrefixSize(keyPrefixSize),
       _ws(ws),
+      _phraseTermScans(std::move(phraseTermScans)),
       _scoreIterator(_scores.end()),
+      _topKParams(std::move(topKParams)),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _idRetrying(WorkingSet::INVALID_ID) {
+    if (_topKParams) {
+        invariant(_topKParams->limit > 0);
+        _specificStats.limit = _topKParams->limit;
+    }
+}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -134,6 +156,9 @@ PlanStage::StageState TextOrStage::doWork(WorkingSetID* out) {
         case State::kInit:
             stageState = initStage(out);
             break;
+        case State::kReadingPhrasePositions:
+            stageState = readPhrasePositions(out);
+            break;
         case State::kReadingTerms:
             stageState = readFromChildren(out);
             break;
@@ -154,6 +179,28 @@ PlanStage::StageState TextOrStage::initStage(WorkingSetID* out) {
     try {
         _recordCursor = collection()->getCursor(opCtx());
         _internalState = State::kReadingTerms;
+
+        // The scans of positions are preceded by the scan of the documents in other languages.
+        invariant(_phraseTermScans.empty() || _phraseTermScans.size() < _children.size());
+        _numTermChildren = _children.size() -
+            (_phraseTermScans.empty() ? 0 : _phraseTermScans.size() + 1);
+        if (!_phraseTermScans.empty() && _numTermChildren > 0) {
+            size_t numPhrases = 0;
+            for (auto&& phraseTermScan : _phraseTermScans) {
+                numPhrases = std::max(numPhrases, phraseTermScan.phrase + 1);
+            }
+            _phraseStarts.resize(numPhrases);
+            _currentChild = _numTermChildren;
+            _internalState = State::kReadingPhrasePositions;
+        }
+
+        if (_topKParams && _numTermChildren > kMaxChildrenForTopK) {
+            _topKParams = boost::none;
+            _specificStats.limit = 0;
+        }
+        if (_topKParams) {
+            _childBounds.resize(_numTermChildren);
+        }
         return PlanStage::NEED_TIME;
     } catch (const WriteConflictException&) {
         invariant(_internalState == State::kInit);
@@ -162,13 +209,138 @@ PlanStage::StageState TextOrStage::initStage(WorkingSetID* out) {
     }
 }
 
+PlanStage::StageState TextOrStage::readPhrasePositions(WorkingSetID* out) {
+    invariant(_currentChild >= _numTermChildren && _currentChild < _children.size());
+
+    WorkingSetID id;
+    StageState childState = _children[_currentChild]->work(&id);
+
+    if (_currentChild == _numTermChildren) {
+        // The documents with strings in other languages have no positions, and are never rejected.
+        if (PlanStage::ADVANCED == childState) {
+            _otherLanguageDocs.insert(_ws->get(id)->recordId);
+            _ws->free(id);
+            return PlanStage::NEED_TIME;
+        } else if (PlanStage::IS_EOF == childState) {
+            ++_currentChild;
+            return PlanStage::NEED_TIME;
+        }
+        *out = id;
+        return childState;
+    }
+
+    const auto& phraseTermScan = _phraseTermScans[_currentChild - _numTermChildren - 1];
+    if (PlanStage::ADVANCED == childState) {
+        WorkingSetMember* wsm = _ws->get(id);
+        invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
+        invariant(1 == wsm->keyData.size());
+        const auto& phraseStarts = _phraseStarts[phraseTermScan.phrase];
+
+        // Only the documents in which the terms of the phrase read so far line up matter.
+        if (!phraseStarts || phraseStarts->count(wsm->recordId)) {
+            // Locate the position within possibly compound key: {prefix,term,position,suffix}.
+            BSONObjIterator keyIt(wsm->keyData.back().keyData);
+            for (unsigned i = 0; i < _keyPrefixSize; i++) {
+                keyIt.next();
+            }
+            keyIt.next();  // Skip past 'term'.
+
+            const size_t position = static_cast<size_t>(keyIt.next().number());
+            if (position >= phraseTermScan.offset) {
+                _currentPhraseStarts[wsm->recordId].push_back(position - phraseTermScan.offset);
+            }
+        }
+        _ws->free(id);
+        return PlanStage::NEED_TIME;
+    } else if (PlanStage::IS_EOF == childState) {
+        const bool phraseFound = intersectPhraseStarts(phraseTermScan);
+        if (!phraseFound && _otherLanguageDocs.empty()) {
+            // No document contains this phrase, so none matches the query.
+            _internalState = State::kDone;
+            return PlanStage::IS_EOF;
+        }
+
+        if (phraseFound && ++_currentChild < _children.size()) {
+            return PlanStage::NEED_TIME;
+        }
+
+        // Every phrase has been checked, or one cannot be found in any document in the default
+        // language: only the documents that may contain all of them, and the documents in other
+        // languages, are scored.
+        _phraseCandidates.emplace(std::move(_otherLanguageDocs));
+        if (phraseFound) {
+            const PositionMap* smallest = nullptr;
+            for (auto&& phraseStarts : _phraseStarts) {
+                if (phraseStarts && (!smallest || phraseStarts->size() < smallest->size())) {
+                    smallest = &*phraseStarts;
+                }
+            }
+            invariant(smallest);
+            for (auto&& entry : *smallest) {
+                if (std::all_of(
+                        _phraseStarts.begin(), _phraseStarts.end(), [&](const auto& starts) {
+                            return !starts || starts->count(entry.first);
+                        })) {
+                    _phraseCandidates->insert(entry.first);
+                }
+            }
+        }
+        _phraseStarts.clear();
+
+        _currentChild = 0;
+        _internalState = State::kReadingTerms;
+        return PlanStage::NEED_TIME;
+    } else {
+        // Propagate WSID from below.
+        *out = id;
+        return childState;
+    }
+}
+
+bool TextOrStage::intersectPhraseStarts(const fts::PhraseTermPosition& phraseTermScan) {
+    for (auto&& entry : _currentPhraseStarts) {
+        // The positions of a term in a document are read in ascending order.
+        auto& positions = entry.second;
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+    }
+
+    auto& phraseStarts = _phraseStarts[phraseTermScan.phrase];
+    if (!phraseStarts) {
+        phraseStarts = std::move(_currentPhraseStarts);
+    } else {
+        for (auto it = phraseStarts->begin(); it != phraseStarts->end();) {
+            auto current = _currentPhraseStarts.find(it->first);
+            if (current == _currentPhraseStarts.end()) {
+                phraseStarts->erase(it++);
+                continue;
+            }
+
+            std::vector<size_t> starts;
+            std::set_intersection(it->second.begin(),
+                                  it->second.end(),
+                                  current->second.begin(),
+                                  current->second.end(),
+                                  std::back_inserter(starts));
+            if (starts.empty()) {
+                phraseStarts->erase(it++);
+                continue;
+            }
+            it->second = std::move(starts);
+            ++it;
+        }
+    }
+    _currentPhraseStarts.clear();
+
+    return !phraseStarts->empty();
+}
+
 PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     // Check to see if there were any children added in the first place.
-    if (_children.size() == 0) {
+    if (_numTermChildren == 0) {
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
     }
-    invariant(_currentChild < _children.size());
+    invariant(_currentChild < _numTermChildren);
 
     // Either retry the last WSM we worked on or get a new one from our current child.
     WorkingSetID id;
@@ -182,12 +354,33 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        StageState stageState = addTerm(id, out);
+        if (!_topKParams || _idRetrying != WorkingSet::INVALID_ID) {
+            return stageState;
+        }
+
+        if (++_postingsSinceCheck >= std::max(kMinPostingsBetweenTopKChecks, _scores.size() / 4)) {
+            _postingsSinceCheck = 0;
+            if (haveTopK()) {
+                // None of the unread postings can change which documents are the top ones.
+                keepTopK();
+                _specificStats.stoppedEarly = true;
+                _scoreIterator = _scores.begin();
+                _internalState = State::kReturningResults;
+                return stageState;
+            }
+        }
+
+        invariant(pickNextChild());
+        return stageState;
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
-        ++_currentChild;
-
-        if (_currentChild < _children.size()) {
+        if (_topKParams) {
+            _childBounds[_currentChild].exhausted = true;
+            if (pickNextChild()) {
+                return PlanStage::NEED_TIME;
+            }
+        } else if (++_currentChild < _numTermChildren) {
             // We have another child to read from.
             return PlanStage::NEED_TIME;
         }
@@ -235,6 +428,22 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _keyPrefixSize; i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topKParams) {
+        // Postings are read in descending score order.
+        _childBounds[_currentChild].score = documentTermScore;
+    }
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
@@ -246,6 +455,13 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         // We haven't seen this RecordId before.
         invariant(textRecordData->score == 0);
 
+        if (_phraseCandidates && !_phraseCandidates->count(wsm->recordId)) {
+            ++_specificStats.docsRejectedByPhrase;
+            _ws->free(wsid);
+            textRecordData->score = -1;
+            return NEED_TIME;
+        }
+
         if (!Filter::passes(newKeyData.keyData, newKeyData.indexKeyPattern, _filter)) {
             _ws->free(wsid);
             textRecordData->score = -1;
@@ -283,20 +499,114 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _keyPrefixSize; i++) {
-        keyIt.next();
+    // Aggregate relevance score, term keys.
+    textRecordData->score += documentTermScore;
+    if (_topKParams) {
+        textRecordData->childrenSeen |= uint64_t{1} << _currentChild;
     }
+    return NEED_TIME;
+}
 
-    keyIt.next();  // Skip past 'term'.
+bool TextOrStage::pickNextChild() {
+    boost::optional<size_t> next;
+    for (size_t i = 0; i < _childBounds.size(); ++i) {
+        if (!_childBounds[i].exhausted &&
+            (!next || _childBounds[i].score > _childBounds[*next].score)) {
+            next = i;
+        }
+    }
+    if (!next) {
+        return false;
+    }
+    _currentChild = *next;
+    return true;
+}
 
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+bool TextOrStage::haveTopK() const {
+    const size_t limit = _topKParams->limit;
 
-    // Aggregate relevance score, term keys.
-    textRecordData->score += documentTermScore;
-    return NEED_TIME;
+    // Bound on the score of a document that has not been seen yet.
+    double unseenBound = 0;
+    for (auto&& child : _childBounds) {
+        if (!child.exhausted) {
+            unseenBound += child.score;
+        }
+    }
+
+    // Collect the (lower, upper) bounds on the final scores of the documents seen. A document may
+    // still get a posting from any child it has not been seen in.
+    std::vector<std::pair<double, double>> bounds;
+    bounds.reserve(_scores.size());
+    for (auto&& [recordId, textRecordData] : _scores) {
+        if (textRecordData.wsid == WorkingSet::INVALID_ID) {
+            // Rejected by the filter.
+            continue;
+        }
+        double upper = textRecordData.score;
+        for (size_t i = 0; i < _childBounds.size(); ++i) {
+            if (!_childBounds[i].exhausted && !(textRecordData.childrenSeen & (uint64_t{1} << i))) {
+                upper += _childBounds[i].score;
+            }
+        }
+        bounds.emplace_back(textRecordData.score, upper);
+    }
+
+    if (bounds.size() < limit) {
+        return false;
+    }
+
+    // The documents with the 'limit' highest lower bounds are the top ones if no other document,
+    // seen or not, can score above the lowest of them.
+    std::nth_element(bounds.begin(),
+                     bounds.begin() + (limit - 1),
+                     bounds.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    const double threshold = bounds[limit - 1].first;
+    return unseenBound <= threshold &&
+        std::all_of(bounds.begin() + limit, bounds.end(), [&](const auto& bound) {
+               return bound.second <= threshold;
+           });
+}
+
+void TextOrStage::keepTopK() {
+    const size_t limit = _topKParams->limit;
+
+    std::vector<std::pair<double, RecordId>> candidates;
+    candidates.reserve(_scores.size());
+    for (auto&& [recordId, textRecordData] : _scores) {
+        if (textRecordData.wsid != WorkingSet::INVALID_ID) {
+            candidates.emplace_back(textRecordData.score, recordId);
+        }
+    }
+    invariant(candidates.size() >= limit);
+    std::nth_element(candidates.begin(),
+                     candidates.begin() + (limit - 1),
+                     candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    ScoreMap topK;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        TextRecordData textRecordData = _scores[candidates[i].second];
+        if (i >= limit) {
+            _ws->free(textRecordData.wsid);
+            continue;
+        }
+
+        // The postings not read may hold part of the score of a top document, so compute it from
+        // the document as the index keys were.
+        fts::TermFrequencyMap termScores;
+        _topKParams->spec.scoreDocument(_ws->get(textRecordData.wsid)->doc.value().toBson(),
+                                        &termScores);
+        textRecordData.score = 0;
+        for (auto&& term : _topKParams->terms) {
+            auto it = termScores.find(term);
+            if (it != termScores.end()) {
+                textRecordData.score += it->second;
+            }
+        }
+        topK.emplace(candidates[i].second, textRecordData);
+    }
+    _scores = std::move(topK);
 }
 
 }  // namespace mongo
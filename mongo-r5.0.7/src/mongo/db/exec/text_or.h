@@ -29,12 +29,19 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
+#include "mongo/db/fts/fts_util.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -47,6 +54,20 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If only the documents with the highest scores are needed, the stage can be given a limit. Each
+ * child scans the postings of one term in descending score order, so the score of the last posting
+ * read from a child bounds the score of its remaining postings. The stage reads from the child with
+ * the highest such bound first, and stops reading as soon as no document can displace the current
+ * best 'limit' documents. The scores of those documents are then computed exactly from their
+ * contents.
+ *
+ * Text indexes that store term positions let the stage skip the documents that cannot contain the
+ * positive phrases of the query. The children are then followed by a scan of the documents with
+ * strings in a language other than the default language of the index, and one scan of positions
+ * for each inner term of each phrase, described by 'phraseTermScans'. These are read first, and
+ * only documents in other languages or in which the inner terms of every phrase appear at their
+ * relative positions are fetched and scored.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -57,21 +78,37 @@ public:
         // 1. Initialize the _recordCursor.
         kInit,
 
-        // 2. Read the terms/scores from the text index.
+        // 2. Read the positions of the phrase terms from the text index, if any.
+        kReadingPhrasePositions,
+
+        // 3. Read the terms/scores from the text index.
         kReadingTerms,
 
-        // 3. Return results to our parent.
+        // 4. Return results to our parent.
         kReturningResults,
 
-        // 4. Finished.
+        // 5. Finished.
         kDone,
     };
 
+    /**
+     * Parameters for returning only the 'limit' documents with the highest scores.
+     */
+    struct TopKParams {
+        size_t limit;
+
+        // Used to compute the exact scores of the returned documents.
+        FTSSpec spec;
+        std::set<std::string> terms;
+    };
+
     TextOrStage(ExpressionContext* expCtx,
                 size_t keyPrefixSize,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                std::vector<fts::PhraseTermPosition> phraseTermScans = {},
+                boost::optional<TopKParams> topKParams = boost::none);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -106,6 +143,19 @@ private:
      */
     StageState initStage(WorkingSetID* out);
 
+    /**
+     * Worker for kReadingPhrasePositions. Reads the positions of the phrase terms and, once all
+     * are read, computes the documents that may contain every phrase.
+     */
+    StageState readPhrasePositions(WorkingSetID* out);
+
+    /**
+     * Helper called from readPhrasePositions when a scan of positions is exhausted. Keeps the
+     * positions at which its phrase may start in each document. Returns false if no document can
+     * contain the phrase.
+     */
+    bool intersectPhraseStarts(const fts::PhraseTermPosition& phraseTermScan);
+
     /**
      * Worker for kReadingTerms. Reads from the children, searching for the terms in the query and
      * populates the score map.
@@ -123,6 +173,23 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Returns whether the documents seen so far contain the top '_topKParams->limit' documents,
+     * given the bounds on the scores of the postings not read yet.
+     */
+    bool haveTopK() const;
+
+    /**
+     * Discards all but the top '_topKParams->limit' documents and computes their exact scores.
+     */
+    void keepTopK();
+
+    /**
+     * Selects the child to read the next posting from: the one whose unread postings have the
+     * highest bound. Returns false if all children are exhausted.
+     */
+    bool pickNextChild();
+
     // The key prefix length within a possibly compound key: {prefix,term,score,suffix}.
     const size_t _keyPrefixSize;
 
@@ -135,6 +202,30 @@ private:
     // Which of _children are we calling work(...) on now?
     size_t _currentChild = 0;
 
+    // The scans of positions that follow the scans of terms, and the scan of the documents in other
+    // languages, in _children.
+    const std::vector<fts::PhraseTermPosition> _phraseTermScans;
+
+    // Number of _children that scan terms.
+    size_t _numTermChildren = 0;
+
+    // Maps each document to the sorted positions at which a phrase may start in it.
+    typedef stdx::unordered_map<RecordId, std::vector<size_t>, RecordId::Hasher> PositionMap;
+
+    // For each phrase, where it may start given the scans of positions read so far. Unset until
+    // the first scan of a term of the phrase is read.
+    std::vector<boost::optional<PositionMap>> _phraseStarts;
+
+    // Where the phrase of the current scan of positions may start, given the positions read so far.
+    PositionMap _currentPhraseStarts;
+
+    // The documents with strings in a language other than the default language of the index,
+    // which the scans of positions cannot reject.
+    stdx::unordered_set<RecordId, RecordId::Hasher> _otherLanguageDocs;
+
+    // Once the scans of positions are read, the only documents that may contain every phrase.
+    boost::optional<stdx::unordered_set<RecordId, RecordId::Hasher>> _phraseCandidates;
+
     /**
      *  Temporary score data filled out by children.
      *  Maps from RecordID -> (aggregate score for doc, wsid).
@@ -144,6 +235,9 @@ private:
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
         WorkingSetID wsid;
         double score;
+
+        // Bit i is set once the child i has contributed to 'score'. Only used with a limit.
+        uint64_t childrenSeen = 0;
     };
 
     typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
@@ -152,6 +246,20 @@ private:
 
     TextOrStats _specificStats;
 
+    // Set if only the documents with the highest scores are needed.
+    boost::optional<TopKParams> _topKParams;
+
+    // With a limit, the bound on the scores of the unread postings of each child. That is the
+    // score of the last posting read from the child, or infinity if it has not been read yet.
+    struct ChildBound {
+        double score = std::numeric_limits<double>::infinity();
+        bool exhausted = false;
+    };
+    std::vector<ChildBound> _childBounds;
+
+    // Number of postings read since the last check for whether the top documents are known.
+    size_t _postingsSinceCheck = 0;
+
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
     WorkingSetID _idRetrying;
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * A dynamic bound on the sort key which a top-k SortStage shares with an IndexScan beneath it.
+ *
+ * Once the sort stage has buffered 'limit' results, any input whose sort key is not strictly better
+ * than the worst buffered result can never be part of the output. The sort stage publishes that
+ * worst key here via setThreshold(), and the index scan uses canSkip() to discard index entries
+ * which cannot make it into the top-k before they are fetched and filtered.
+ *
+ * The bound is only valid when the sort key of a document can be reconstructed from a single index
+ * key, which requires that the index is a non-multikey btree index containing every component of
+ * the sort pattern, and that neither the index nor the query uses a collation. The stage builder is
+ * responsible for checking these conditions before creating a TopKSortBound.
+ */
+class TopKSortBound final {
+public:
+    /**
+     * 'sortPattern' is the sort pattern of the top-k sort stage. 'keyPositions' holds, for each
+     * component of the sort pattern, the position of the corresponding field in the index key.
+     */
+    TopKSortBound(const BSONObj& sortPattern, std::vector<size_t> keyPositions)
+        : _comparator(sortPattern), _keyPositions(std::move(keyPositions)) {
+        invariant(_keyPositions.size() == static_cast<size_t>(sortPattern.nFields()));
+    }
+
+    /**
+     * Records the sort key which any further input must beat in order to be retained by the top-k
+     * sort. Successive thresholds only ever become tighter.
+     */
+    void setThreshold(Value threshold) {
+        _threshold = std::move(threshold);
+        _hasThreshold = true;
+    }
+
+    bool hasThreshold() const {
+        return _hasThreshold;
+    }
+
+    /**
+     * Returns true if the document referenced by the index key 'indexKey' cannot enter the top-k
+     * result set given the current threshold. The key is expected in the unowned, field-name-less
+     * form returned by the storage engine cursor.
+     */
+    bool canSkip(const BSONObj& indexKey) const {
+        if (!_hasThreshold) {
+            return false;
+        }
+
+        // The top-k sorter rejects any input which does not compare strictly less than its cutoff,
+        // so an index key which compares greater or equal can be skipped.
+        return _comparator(_sortKeyFromIndexKey(indexKey), _threshold) >= 0;
+    }
+
+private:
+    Value _sortKeyFromIndexKey(const BSONObj& indexKey) const {
+        if (_keyPositions.size() == 1) {
+            return Value(_elementAt(indexKey, _keyPositions[0]));
+        }
+
+        std::vector<Value> components;
+        components.reserve(_keyPositions.size());
+        for (auto position : _keyPositions) {
+            components.emplace_back(_elementAt(indexKey, position));
+        }
+        return Value(std::move(components));
+    }
+
+    static BSONElement _elementAt(const BSONObj& indexKey, size_t position) {
+        BSONObjIterator it(indexKey);
+        for (size_t i = 0; i < position; ++i) {
+            it.next();
+        }
+        return it.next();
+    }
+
+    const SortKeyComparator _comparator;
+    const std::vector<size_t> _keyPositions;
+
+    Value _threshold;
+    bool _hasThreshold = false;
+};
+
+}  // namespace mongo
@@ -64,4 +64,27 @@ size_t getTrialPeriodNumToReturn(const CanonicalQuery& query) {
 
     return numResults;
 }
+
+bool isOutperformedByLeader(size_t candidateResults,
+                            size_t candidateCost,
+                            size_t leaderResults,
+                            size_t leaderCost,
+                            size_t numToReturn) {
+    const double abandonRatio = internalQueryPlanEvaluationAbandonRatio.load();
+    if (abandonRatio == 0) {
+        return false;
+    }
+
+    // Require the leader to have returned a meaningful share of the trial period's results before
+    // trusting its productivity.
+    if (leaderResults == 0 || leaderResults < numToReturn / 4) {
+        return false;
+    }
+
+    const double candidateProductivity =
+        static_cast<double>(candidateResults) / std::max<size_t>(candidateCost, 1);
+    const double leaderProductivity =
+        static_cast<double>(leaderResults) / std::max<size_t>(leaderCost, 1);
+    return candidateProductivity * abandonRatio < leaderProductivity;
+}
 }  // namespace mongo::trial_period
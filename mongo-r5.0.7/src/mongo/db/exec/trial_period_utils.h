@@ -48,5 +48,20 @@ size_t getTrialPeriodMaxWorks(OperationContext* opCtx, const CollectionPtr& coll
  * trial period. As soon as any plan hits this number of documents, the trial period ends.
  */
 size_t getTrialPeriodNumToReturn(const CanonicalQuery& query);
+
+/**
+ * Returns true if a candidate plan which has returned 'candidateResults' results at a cost of
+ * 'candidateCost' can be abandoned before the end of the trial period, because the most productive
+ * candidate has returned 'leaderResults' results at a cost of only 'leaderCost'. The cost is
+ * whatever unit the caller ranks plans by, such as works or storage reads. 'numToReturn' is the
+ * number of results which ends the trial period.
+ *
+ * Controlled by 'internalQueryPlanEvaluationAbandonRatio'.
+ */
+bool isOutperformedByLeader(size_t candidateResults,
+                            size_t candidateCost,
+                            size_t leaderResults,
+                            size_t leaderCost,
+                            size_t numToReturn);
 }  // namespace trial_period
 }  // namespace mongo
@@ -82,6 +82,16 @@ public:
         return _done;
     }
 
+    /**
+     * Returns the current value of the trial run metric specified as a template parameter
+     * 'metric'.
+     */
+    template <TrialRunMetric metric>
+    size_t getMetric() const {
+        static_assert(metric >= 0 && metric < TrialRunMetric::kLastElem);
+        return _metrics[metric];
+    }
+
 private:
     const size_t _maxMetrics[TrialRunMetric::kLastElem];
     size_t _metrics[TrialRunMetric::kLastElem]{0};
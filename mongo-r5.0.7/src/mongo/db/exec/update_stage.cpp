@@ -46,6 +46,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
@@ -172,6 +173,13 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     const bool isInsert = false;
     FieldRefSet immutablePaths;
 
+    // Operator-style updates report the paths they modify, which allows index maintenance to skip
+    // those indexes whose keys cannot have changed. Replacement and pipeline updates may modify any
+    // path, so all indexes are maintained for them.
+    FieldRefSetWithStorage modifiedPaths;
+    const bool trackModifiedPaths = driver->type() == UpdateDriver::UpdateType::kOperator &&
+        internalQueryUpdateOnlyAffectedIndexes.load();
+
     if (_isUserInitiatedWrite) {
         // Documents coming directly from users should be validated for storage. It is safe to
         // access the CollectionShardingState in this write context and to throw SSV if the sharding
@@ -192,7 +200,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                trackModifiedPaths ? &modifiedPaths : nullptr);
     } else {
         // If there was a matched field, obtain it.
         MatchDetails matchDetails;
@@ -212,7 +221,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                trackModifiedPaths ? &modifiedPaths : nullptr);
     }
 
     if (!status.isOK()) {
@@ -225,6 +235,9 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
 
     // Ensure _id is first if it exists, and generate a new OID if appropriate.
     _ensureIdFieldIsFirst(&_doc, createIdField);
+    if (createIdField && !oldObj.value().hasField(idFieldName)) {
+        modifiedPaths.keepShortest(idFieldRef);
+    }
 
     // See if the changes were applied in place
     const char* source = nullptr;
@@ -270,6 +283,10 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // Ensure we set the type correctly
         args.source = request->source();
 
+        if (trackModifiedPaths && !modifiedPaths.empty()) {
+            args.modifiedPaths = &modifiedPaths;
+        }
+
         if (inPlace) {
             if (!request->explain()) {
                 newObj = oldObj.value();
@@ -52,6 +52,7 @@ void BasicFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _document = document.toString();
     _tokenizer = std::make_unique<Tokenizer>(_language, _document);
+    _numWords = 0;
 }
 
 bool BasicFTSTokenizer::moveNext() {
@@ -69,6 +70,7 @@ bool BasicFTSTokenizer::moveNext() {
             continue;
         }
 
+        ++_numWords;
         string word = str::toLower(token.data);
 
         // Stop words are case-sensitive so we need them to be lower cased to check
@@ -90,5 +92,10 @@ StringData BasicFTSTokenizer::get() const {
     return _stem;
 }
 
+size_t BasicFTSTokenizer::position() const {
+    invariant(_numWords > 0);
+    return _numWords - 1;
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -69,6 +69,8 @@ public:
 
     StringData get() const override;
 
+    size_t position() const override;
+
 private:
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
@@ -79,6 +81,9 @@ private:
     Options _options;
 
     std::string _stem;
+
+    // Number of words read from the document so far.
+    size_t _numWords = 0;
 };
 
 }  // namespace fts
@@ -138,10 +138,7 @@ void FTSIndexFormat::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
     spec.scoreDocument(obj, &term_freqs);
 
     auto sequence = keys->extract_sequence();
-    for (TermFrequencyMap::const_iterator i = term_freqs.begin(); i != term_freqs.end(); ++i) {
-        const string& term = i->first;
-        double weight = i->second;
-
+    auto appendKey = [&](double weight, const string& term) {
         KeyString::PooledBuilder keyString(pooledBufferBuilder, keyStringVersion, ordering);
         for (const auto& elem : extrasBefore) {
             keyString.appendBSONElement(elem);
@@ -156,6 +153,23 @@ void FTSIndexFormat::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
         }
 
         sequence.push_back(keyString.release());
+    };
+
+    for (TermFrequencyMap::const_iterator i = term_freqs.begin(); i != term_freqs.end(); ++i) {
+        appendKey(i->second, i->first);
+    }
+
+    if (spec.storesTermPositions()) {
+        TermPositionMap termPositions;
+        if (!spec.getTermPositions(obj, &termPositions)) {
+            appendKey(0, getPositionTerm(""));
+        }
+        for (auto&& [term, positions] : termPositions) {
+            const string positionTerm = getPositionTerm(term);
+            for (size_t position : positions) {
+                appendKey(position, positionTerm);
+            }
+        }
     }
     keys->adopt_sequence(std::move(sequence));
 }
@@ -178,6 +192,25 @@ BSONObj FTSIndexFormat::getIndexKey(double weight,
     return b.appendElements(key).obj();
 }
 
+BSONObj FTSIndexFormat::getPositionIndexKey(size_t position,
+                                            const string& term,
+                                            const BSONObj& indexPrefix,
+                                            TextIndexVersion textIndexVersion) {
+    invariant(textIndexVersion >= TEXT_INDEX_VERSION_4);
+    return getIndexKey(position, getPositionTerm(term), indexPrefix, textIndexVersion);
+}
+
+BSONObj FTSIndexFormat::getOtherLanguageIndexKey(const BSONObj& indexPrefix,
+                                                 TextIndexVersion textIndexVersion) {
+    invariant(textIndexVersion >= TEXT_INDEX_VERSION_4);
+    // No term is empty, so this entry cannot be mistaken for a position.
+    return getIndexKey(0, getPositionTerm(""), indexPrefix, textIndexVersion);
+}
+
+string FTSIndexFormat::getPositionTerm(const string& term) {
+    return " " + term;
+}
+
 template <typename KeyStringBuilder>
 void FTSIndexFormat::_appendIndexKey(KeyStringBuilder& keyString,
                                      double weight,
@@ -205,7 +238,8 @@ void FTSIndexFormat::_appendIndexKey(KeyStringBuilder& keyString,
             keyString.appendString(term.substr(0, termKeyPrefixLengthV2) + keySuffix);
         }
     } else {
-        invariant(TEXT_INDEX_VERSION_3 == textIndexVersion);
+        invariant(TEXT_INDEX_VERSION_3 == textIndexVersion ||
+                  TEXT_INDEX_VERSION_4 == textIndexVersion);
         if (term.size() <= termKeyPrefixLengthV3) {
             keyString.appendString(term);
         } else {
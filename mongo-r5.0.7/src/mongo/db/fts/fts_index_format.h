@@ -65,6 +65,35 @@ public:
                                const BSONObj& indexPrefix,
                                TextIndexVersion textIndexVersion);
 
+    /**
+     * Helper method to get the entry storing a position of a term in indexes that store term
+     * positions. Such entries hold the position in place of the weight, and the term prefixed with
+     * a space, which no term contains, in place of the term.
+     * @param position, the position of the term in the entry
+     * @param term, the std::string term in the entry
+     * @param indexPrefix, the fields that go in the index first
+     * @param textIndexVersion, index version. affects key format.
+     */
+    static BSONObj getPositionIndexKey(size_t position,
+                                       const std::string& term,
+                                       const BSONObj& indexPrefix,
+                                       TextIndexVersion textIndexVersion);
+
+    /**
+     * Helper method to get the entry that indexes which store term positions hold, instead of
+     * positions, for documents with strings in a language other than the default language of the
+     * index.
+     * @param indexPrefix, the fields that go in the index first
+     * @param textIndexVersion, index version. affects key format.
+     */
+    static BSONObj getOtherLanguageIndexKey(const BSONObj& indexPrefix,
+                                            TextIndexVersion textIndexVersion);
+
+    /**
+     * Returns the term stored in the entries holding the positions of 'term'.
+     */
+    static std::string getPositionTerm(const std::string& term);
+
 private:
     /**
      * Helper method to get return entry from the FTSIndex as a BSONObj.
@@ -278,6 +278,79 @@ TEST(FTSIndexFormat, LongWordTextIndexVersion3) {
     assertEqualsIndexKeys(expectedKeys, keys);
 }
 
+/**
+ * Tests that text index version 4 also indexes the position of each occurrence of a term.
+ */
+TEST(FTSIndexFormat, TextIndexVersion4StoresTermPositions) {
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("data"
+                                                               << "text")
+                                                       << "textIndexVersion" << 4))));
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+    KeyStringSet keys;
+    FTSIndexFormat::getKeys(allocator,
+                            spec,
+                            BSON("data"
+                                 << "cat sat on the cat"),
+                            &keys,
+                            KeyString::Version::kLatestVersion,
+                            Ordering::make(BSONObj()));
+
+    // Stop words are not indexed but still count as positions.
+    std::set<std::pair<string, double>> positionKeys;
+    std::set<string> termKeys;
+    for (auto& keyString : keys) {
+        auto key = KeyString::toBson(keyString, Ordering::make(BSONObj()));
+        ASSERT_EQUALS(2, key.nFields());
+        BSONObjIterator i(key);
+        string term = i.next().String();
+        double weight = i.next().numberDouble();
+        if (term == FTSIndexFormat::getPositionTerm(term.substr(1))) {
+            positionKeys.emplace(term.substr(1), weight);
+        } else {
+            termKeys.insert(term);
+        }
+    }
+
+    ASSERT_EQUALS(5U, keys.size());
+    ASSERT(termKeys == (std::set<string>{"cat", "sat"}));
+    ASSERT(positionKeys ==
+           (std::set<std::pair<string, double>>{{"cat", 0}, {"sat", 1}, {"cat", 4}}));
+    ASSERT_BSONOBJ_EQ(
+        BSON("" << FTSIndexFormat::getPositionTerm("cat") << "" << 4.0),
+        FTSIndexFormat::getPositionIndexKey(4, "cat", BSONObj(), TEXT_INDEX_VERSION_4));
+}
+
+/**
+ * Tests that text index version 4 does not index the positions of the terms of documents with
+ * strings in a language other than the default language, but marks these documents instead.
+ */
+TEST(FTSIndexFormat, TextIndexVersion4MarksDocumentsInOtherLanguages) {
+    FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("data"
+                                                               << "text")
+                                                       << "textIndexVersion" << 4))));
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+    KeyStringSet keys;
+    FTSIndexFormat::getKeys(allocator,
+                            spec,
+                            BSON("data" << BSON_ARRAY("cat sat"
+                                                      << "running")
+                                        << "language"
+                                        << "none"),
+                            &keys,
+                            KeyString::Version::kLatestVersion,
+                            Ordering::make(BSONObj()));
+
+    // One entry per term, and the mark.
+    auto keyObjs = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    for (auto& keyString : keys) {
+        keyObjs.insert(KeyString::toBson(keyString, Ordering::make(BSONObj())));
+    }
+    ASSERT_EQUALS(4U, keyObjs.size());
+    ASSERT_EQUALS(1U,
+                  keyObjs.count(FTSIndexFormat::getOtherLanguageIndexKey(BSONObj(),
+                                                                         TEXT_INDEX_VERSION_4)));
+}
+
 TEST(FTSIndexFormat, GetKeysWithLeadingEmptyArrayThrows) {
     BSONObj keyPattern = fromjson("{'a.b': 1, data: 'text'}");
     FTSSpec spec(assertGet(FTSSpec::fixSpec(BSON("key" << keyPattern << "textIndexVersion" << 3))));
@@ -186,6 +186,8 @@ const FTSLanguage& FTSLanguage::make(StringData langName, TextIndexVersion textI
         case TEXT_INDEX_VERSION_2:
             return getLanguageRegistry<TEXT_INDEX_VERSION_2>().make(langName);
         case TEXT_INDEX_VERSION_3:
+        case TEXT_INDEX_VERSION_4:
+            // Version 4 only adds term positions to the version 3 format.
             return getLanguageRegistry<TEXT_INDEX_VERSION_3>().make(langName);
         case TEXT_INDEX_VERSION_INVALID:
             break;
@@ -135,6 +135,26 @@ Status FTSQueryImpl::parse(TextIndexVersion textIndexVersion) {
     _addTerms(tokenizer.get(), positiveTermSentence, false);
     _addTerms(tokenizer.get(), negativeTermSentence, true);
 
+    for (const auto& phrase : _positivePhrases) {
+        // A phrase matches any substring of a document, so its first and last words may only be
+        // parts of words of the document: "cat sat" matches "bobcat saturday". Only the words in
+        // between are sure to be words of the document, at the same relative positions.
+        size_t lastPosition = 0;
+        tokenizer->reset(phrase.c_str(), FTSTokenizer::kNone);
+        while (tokenizer->moveNext()) {
+            lastPosition = tokenizer->position();
+        }
+
+        auto& phraseTerms = _positivePhraseTerms.emplace_back();
+        tokenizer->reset(phrase.c_str(), FTSTokenizer::kFilterStopWords);
+        while (tokenizer->moveNext()) {
+            const size_t position = tokenizer->position();
+            if (position > 0 && position < lastPosition) {
+                phraseTerms.push_back({tokenizer->get().toString(), position});
+            }
+        }
+    }
+
     return Status::OK();
 }
 
@@ -149,6 +169,7 @@ std::unique_ptr<FTSQuery> FTSQueryImpl::clone() const {
     clonedQuery->_positivePhrases = _positivePhrases;
     clonedQuery->_negatedPhrases = _negatedPhrases;
     clonedQuery->_termsForBounds = _termsForBounds;
+    clonedQuery->_positivePhraseTerms = _positivePhraseTerms;
     return std::move(clonedQuery);
 }
 
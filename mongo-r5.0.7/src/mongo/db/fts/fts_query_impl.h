@@ -43,6 +43,14 @@ class FTSTokenizer;
 
 class FTSQueryImpl final : public FTSQuery {
 public:
+    /**
+     * A term of a phrase, and its position relative to the first word of the phrase.
+     */
+    struct PhraseTerm {
+        std::string term;
+        size_t offset;
+    };
+
     Status parse(TextIndexVersion textIndexVersion) final;
 
     std::unique_ptr<FTSQuery> clone() const final;
@@ -64,6 +72,16 @@ public:
         return _termsForBounds;
     }
 
+    /**
+     * Returns the inner terms of each positive phrase, in the order of getPositivePhr(), tokenized
+     * as the terms for bounds are. The first and last words of a phrase are left out, since they
+     * may match only part of a word. A document can only match a phrase if these terms appear at
+     * these relative positions in one of its strings.
+     */
+    const std::vector<std::vector<PhraseTerm>>& getPositivePhraseTerms() const {
+        return _positivePhraseTerms;
+    }
+
     /**
      * Returns a BSON object with the following format:
      * {
@@ -83,6 +101,7 @@ private:
     std::vector<std::string> _positivePhrases;
     std::vector<std::string> _negatedPhrases;
     std::set<std::string> _termsForBounds;
+    std::vector<std::vector<PhraseTerm>> _positivePhraseTerms;
 };
 }  // namespace fts
 }  // namespace mongo
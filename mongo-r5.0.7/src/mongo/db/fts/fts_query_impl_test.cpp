@@ -164,6 +164,26 @@ TEST(FTSQueryImpl, Phrase1) {
     ASSERT_TRUE(q.getTermsForBounds() == q.getPositiveTerms());
 }
 
+TEST(FTSQueryImpl, PhraseTermOffsets) {
+    FTSQueryImpl q;
+    q.setQuery("doing a \"Testing the Phrases of running tests\" \"cat sat\" fun");
+    q.setLanguage("english");
+    q.setCaseSensitive(true);
+    q.setDiacriticSensitive(false);
+    ASSERT(q.parse(TEXT_INDEX_VERSION_4).isOK());
+
+    // Terms are stemmed and lower cased as in the index, and stop words only count as offsets.
+    // The first and last words, which may be parts of longer words, are left out.
+    const auto& phraseTerms = q.getPositivePhraseTerms();
+    ASSERT_EQUALS(2U, phraseTerms.size());
+    ASSERT_EQUALS(2U, phraseTerms[0].size());
+    ASSERT_EQUALS("phrase", phraseTerms[0][0].term);
+    ASSERT_EQUALS(2U, phraseTerms[0][0].offset);
+    ASSERT_EQUALS("run", phraseTerms[0][1].term);
+    ASSERT_EQUALS(4U, phraseTerms[0][1].offset);
+    ASSERT_EQUALS(0U, phraseTerms[1].size());
+}
+
 TEST(FTSQueryImpl, Phrase2) {
     FTSQueryImpl q;
     q.setQuery("doing a \"phrase-test\" for fun");
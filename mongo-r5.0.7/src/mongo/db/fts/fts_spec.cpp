@@ -37,6 +37,7 @@
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/fts_util.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/server_options.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -73,10 +74,13 @@ FTSSpec::FTSSpec(const BSONObj& indexInfo) {
             "found invalid spec for text index, expected number for textIndexVersion",
             textIndexVersionElt.isNumber());
 
-    // We currently support TEXT_INDEX_VERSION_1 (deprecated), TEXT_INDEX_VERSION_2, and
-    // TEXT_INDEX_VERSION_3.
+    // We currently support TEXT_INDEX_VERSION_1 (deprecated), TEXT_INDEX_VERSION_2,
+    // TEXT_INDEX_VERSION_3 and TEXT_INDEX_VERSION_4.
     // Reject all other values.
     switch (textIndexVersionElt.numberInt()) {
+        case TEXT_INDEX_VERSION_4:
+            _textIndexVersion = TEXT_INDEX_VERSION_4;
+            break;
         case TEXT_INDEX_VERSION_3:
             _textIndexVersion = TEXT_INDEX_VERSION_3;
             break;
@@ -90,8 +94,9 @@ FTSSpec::FTSSpec(const BSONObj& indexInfo) {
             msgasserted(17364,
                         str::stream() << "attempt to use unsupported textIndexVersion "
                                       << textIndexVersionElt.numberInt()
-                                      << "; versions supported: " << TEXT_INDEX_VERSION_3 << ", "
-                                      << TEXT_INDEX_VERSION_2 << ", " << TEXT_INDEX_VERSION_1);
+                                      << "; versions supported: " << TEXT_INDEX_VERSION_4 << ", "
+                                      << TEXT_INDEX_VERSION_3 << ", " << TEXT_INDEX_VERSION_2
+                                      << ", " << TEXT_INDEX_VERSION_1);
     }
 
     // Initialize _defaultLanguage.  Note that the FTSLanguage constructor requires
@@ -184,6 +189,35 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
     }
 }
 
+bool FTSSpec::getTermPositions(const BSONObj& obj, TermPositionMap* termPositions) const {
+    invariant(storesTermPositions());
+
+    FTSElementIterator it(*this, obj);
+
+    size_t firstPosition = 0;
+    while (it.more()) {
+        FTSIteratorValue val = it.next();
+        if (val._language != _defaultLanguage) {
+            termPositions->clear();
+            return false;
+        }
+
+        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
+        tokenizer->reset(val._text, FTSTokenizer::kFilterStopWords);
+
+        size_t numWords = 0;
+        while (tokenizer->moveNext()) {
+            (*termPositions)[tokenizer->get().toString()].push_back(firstPosition +
+                                                                    tokenizer->position());
+            numWords = tokenizer->position() + 1;
+        }
+
+        // Leave a position unused between strings, so that no phrase can span two of them.
+        firstPosition += numWords + 1;
+    }
+    return true;
+}
+
 void FTSSpec::_scoreStringV2(FTSTokenizer* tokenizer,
                              StringData raw,
                              TermFrequencyMap* docScores,
@@ -487,10 +521,21 @@ StatusWith<BSONObj> FTSSpec::fixSpec(const BSONObj& spec) {
 
             textIndexVersion = e.numberInt();
             if (textIndexVersion != TEXT_INDEX_VERSION_2 &&
-                textIndexVersion != TEXT_INDEX_VERSION_3) {
+                textIndexVersion != TEXT_INDEX_VERSION_3 &&
+                textIndexVersion != TEXT_INDEX_VERSION_4) {
                 return {ErrorCodes::CannotCreateIndex,
                         str::stream() << "bad textIndexVersion: " << textIndexVersion};
             }
+
+            // Earlier versions cannot read the keys of text indexes which store term positions,
+            // so only create them once the cluster can no longer be downgraded to one.
+            const auto& fcv = serverGlobalParams.featureCompatibility;
+            if (textIndexVersion == TEXT_INDEX_VERSION_4 && fcv.isVersionInitialized() &&
+                fcv.isLessThan(ServerGlobalParams::FeatureCompatibility::Version::kVersion50)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "textIndexVersion " << TEXT_INDEX_VERSION_4
+                                      << " requires featureCompatibilityVersion 5.0"};
+            }
         } else {
             b.append(e);
         }
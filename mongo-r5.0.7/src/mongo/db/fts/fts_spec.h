@@ -52,6 +52,7 @@ extern const double DEFAULT_WEIGHT;
 
 typedef std::map<std::string, double> Weights;  // TODO cool map
 typedef stdx::unordered_map<std::string, double> TermFrequencyMap;
+typedef stdx::unordered_map<std::string, std::vector<size_t>> TermPositionMap;
 
 struct ScoreHelperStruct {
     ScoreHelperStruct() : freq(0), count(0), exp(0) {}
@@ -105,6 +106,16 @@ public:
      */
     void scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) const;
 
+    /**
+     * Computes the positions of the terms of a BSONObj as applied to this spec. Positions count
+     * all the words of each string, including stop words, and strings are separated by an unused
+     * position. Returns false, and leaves 'termPositions' empty, if some string of the BSONObj is
+     * not in the default language: its terms are stemmed differently from those of queries in the
+     * default language, so their positions are not comparable. Only valid for specs that store
+     * term positions.
+     */
+    bool getTermPositions(const BSONObj& obj, TermPositionMap* termPositions) const;
+
     /**
      * given a query, pulls out the pieces (in order) that go in the index first
      */
@@ -122,6 +133,14 @@ public:
         return _textIndexVersion;
     }
 
+    /**
+     * Returns whether the index stores the positions of the terms of each document, in addition to
+     * their scores.
+     */
+    bool storesTermPositions() const {
+        return _textIndexVersion >= TEXT_INDEX_VERSION_4;
+    }
+
 private:
     //
     // Helper methods.  Invoked for TEXT_INDEX_VERSION_2 spec objects only.
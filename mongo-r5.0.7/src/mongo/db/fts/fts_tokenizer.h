@@ -93,6 +93,12 @@ public:
      * Returned StringData is valid until next call to moveNext().
      */
     virtual StringData get() const = 0;
+
+    /**
+     * Returns the position of the current token among the words of the document, counting the
+     * stop words that were filtered out.
+     */
+    virtual size_t position() const = 0;
 };
 
 }  // namespace fts
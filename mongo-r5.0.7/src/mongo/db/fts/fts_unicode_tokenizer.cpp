@@ -58,6 +58,7 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
+    _numWords = 0;
     _document.resetData(document);  // Validates that document is valid UTF8.
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
@@ -78,6 +79,7 @@ bool UnicodeFTSTokenizer::moveNext() {
             ++_pos;
         }
         const size_t len = _pos - start;
+        ++_numWords;
 
         // Skip the delimiters before the next token.
         _skipDelimiters();
@@ -111,6 +113,11 @@ StringData UnicodeFTSTokenizer::get() const {
     return _word;
 }
 
+size_t UnicodeFTSTokenizer::position() const {
+    invariant(_numWords > 0);
+    return _numWords - 1;
+}
+
 void UnicodeFTSTokenizer::_skipDelimiters() {
     while (_pos < _document.size() &&
            unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage)) {
@@ -67,6 +67,8 @@ public:
 
     StringData get() const override;
 
+    size_t position() const override;
+
 private:
     /**
      * Helper that moves the tokenizer past all delimiters that shouldn't be considered part of
@@ -85,6 +87,9 @@ private:
     StringData _word;
     Options _options;
 
+    // Number of words read from the document so far.
+    size_t _numWords = 0;
+
     StackBufBuilder _wordBuf;
     StackBufBuilder _finalBuf;
 };
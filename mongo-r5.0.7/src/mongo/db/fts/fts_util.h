@@ -45,6 +45,16 @@ enum TextIndexVersion {
     TEXT_INDEX_VERSION_1 = 1,        // Legacy index format.  Deprecated.
     TEXT_INDEX_VERSION_2 = 2,        // Index format with ASCII support and murmur hashing.
     TEXT_INDEX_VERSION_3 = 3,        // Current index format with basic Unicode support.
+    TEXT_INDEX_VERSION_4 = 4,        // Version 3 format that also stores term positions.
+};
+
+/**
+ * Identifies a term of a positive phrase of a text query by the index of the phrase and the
+ * position of the term relative to the first word of the phrase.
+ */
+struct PhraseTermPosition {
+    size_t phrase;
+    size_t offset;
 };
 }  // namespace fts
 }  // namespace mongo
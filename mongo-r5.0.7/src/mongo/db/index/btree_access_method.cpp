@@ -77,4 +77,19 @@ void BtreeAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuild
     _keyGenerator->getKeys(pooledBufferBuilder, obj, skipMultikey, keys, multikeyPaths, id);
 }
 
+boost::optional<std::vector<size_t>> BtreeAccessMethod::registerSharedPaths(
+    SharedPathExtractor* extractor) const {
+    return _keyGenerator->registerSharedPaths(extractor);
+}
+
+bool BtreeAccessMethod::doGetKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                                 const SharedPathExtractor& extractor,
+                                                 const std::vector<size_t>& slots,
+                                                 KeyStringSet* keys,
+                                                 MultikeyPaths* multikeyPaths,
+                                                 boost::optional<RecordId> id) const {
+    return _keyGenerator->getKeysFromSharedPaths(
+        pooledBufferBuilder, extractor, slots, keys, multikeyPaths, id);
+}
+
 }  // namespace mongo
@@ -47,6 +47,9 @@ class BtreeAccessMethod : public AbstractIndexAccessMethod {
 public:
     BtreeAccessMethod(IndexCatalogEntry* btreeState, std::unique_ptr<SortedDataInterface> btree);
 
+    boost::optional<std::vector<size_t>> registerSharedPaths(
+        SharedPathExtractor* extractor) const final;
+
 private:
     void doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
                    const BSONObj& obj,
@@ -56,6 +59,13 @@ private:
                    MultikeyPaths* multikeyPaths,
                    boost::optional<RecordId> id) const final;
 
+    bool doGetKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                  const SharedPathExtractor& extractor,
+                                  const std::vector<size_t>& slots,
+                                  KeyStringSet* keys,
+                                  MultikeyPaths* multikeyPaths,
+                                  boost::optional<RecordId> id) const final;
+
     // Our keys differ for V0 and V1.
     std::unique_ptr<BtreeKeyGenerator> _keyGenerator;
 };
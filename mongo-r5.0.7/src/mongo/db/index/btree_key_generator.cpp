@@ -29,12 +29,15 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <memory>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/index/shared_path_extractor.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/util/assert_util.h"
@@ -84,6 +87,23 @@ BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
     // "a.b".
     return kEmptyElt;
 }
+
+/**
+ * Like extractNonArrayElementAtPath(), but may be used on any document. Returns boost::none if the
+ * traversal of 'path' runs into an array, including an array at the end of the path.
+ */
+boost::optional<BSONElement> extractElementAtPathIfNoArray(const BSONObj& obj, StringData path) {
+    auto dotOffset = path.find('.');
+    auto elt = obj.getField(dotOffset == std::string::npos ? path : path.substr(0, dotOffset));
+    if (elt.type() == BSONType::Array) {
+        return boost::none;
+    } else if (dotOffset == std::string::npos || elt.eoo()) {
+        return elt;
+    } else if (elt.type() == BSONType::Object) {
+        return extractElementAtPathIfNoArray(elt.embeddedObject(), path.substr(dotOffset + 1));
+    }
+    return BSONElement{};
+}
 }  // namespace
 
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
@@ -110,6 +130,17 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
         _pathsContainPositionalComponent =
             _pathsContainPositionalComponent || fieldRef.hasNumericPathComponents();
     }
+
+    const bool hasFixedValues = std::any_of(
+        _fixed.begin(), _fixed.end(), [](const BSONElement& elt) { return !elt.eoo(); });
+    if (_pathsContainPositionalComponent || hasFixedValues) {
+        _shape = KeyPatternShape::kGeneric;
+    } else if (_fieldNames.size() == 1) {
+        _shape = _pathLengths[0] == 1 ? KeyPatternShape::kSingleTopLevelField
+                                      : KeyPatternShape::kSingleField;
+    } else {
+        _shape = KeyPatternShape::kCompound;
+    }
 }
 
 static void assertParallelArrays(const char* first, const char* second) {
@@ -246,6 +277,13 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
             multikeyPaths->resize(_fieldNames.size());
         }
         _getKeysWithoutArray(pooledBufferBuilder, obj, id, keys);
+    } else if (_tryGetKeysWithoutArray(pooledBufferBuilder, obj, id, keys)) {
+        // None of the indexed paths contain an array, so none of them cause the index to be
+        // multikey.
+        if (multikeyPaths) {
+            invariant(multikeyPaths->empty());
+            multikeyPaths->resize(_fieldNames.size());
+        }
     } else {
         if (multikeyPaths) {
             invariant(multikeyPaths->empty());
@@ -276,16 +314,16 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
     }
 }
 
-void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                             const BSONObj& obj,
-                                             boost::optional<RecordId> id,
-                                             KeyStringSet* keys) const {
-
+template <typename GetElementFn>
+void BtreeKeyGenerator::_buildKeyWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                              const GetElementFn& getElement,
+                                              boost::optional<RecordId> id,
+                                              KeyStringSet* keys) const {
     KeyString::PooledBuilder keyString{pooledBufferBuilder, _keyStringVersion, _ordering};
     size_t numNotFound{0};
 
-    for (auto&& fieldName : _fieldNames) {
-        auto elem = extractNonArrayElementAtPath(obj, fieldName);
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        auto elem = getElement(i);
         if (elem.eoo()) {
             ++numNotFound;
         }
@@ -309,6 +347,107 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
     keys->insert(keyString.release());
 }
 
+template <BtreeKeyGenerator::KeyPatternShape kShape>
+bool BtreeKeyGenerator::_getKeysIfNoArrays(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                           const BSONObj& obj,
+                                           boost::optional<RecordId> id,
+                                           KeyStringSet* keys) const {
+    if constexpr (kShape == KeyPatternShape::kSingleTopLevelField) {
+        auto elt = obj.getField(_fieldNames[0]);
+        if (elt.type() == BSONType::Array) {
+            return false;
+        }
+        _buildKeyWithoutArray(pooledBufferBuilder, [&](size_t) { return elt; }, id, keys);
+    } else if constexpr (kShape == KeyPatternShape::kSingleField) {
+        auto elt = extractElementAtPathIfNoArray(obj, _fieldNames[0]);
+        if (!elt) {
+            return false;
+        }
+        _buildKeyWithoutArray(pooledBufferBuilder, [&](size_t) { return *elt; }, id, keys);
+    } else {
+        static_assert(kShape == KeyPatternShape::kCompound);
+        boost::container::small_vector<BSONElement, 4> elts;
+        for (auto&& fieldName : _fieldNames) {
+            auto elt = extractElementAtPathIfNoArray(obj, fieldName);
+            if (!elt) {
+                return false;
+            }
+            elts.push_back(*elt);
+        }
+        _buildKeyWithoutArray(pooledBufferBuilder, [&](size_t i) { return elts[i]; }, id, keys);
+    }
+    return true;
+}
+
+bool BtreeKeyGenerator::_tryGetKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                                const BSONObj& obj,
+                                                boost::optional<RecordId> id,
+                                                KeyStringSet* keys) const {
+    switch (_shape) {
+        case KeyPatternShape::kSingleTopLevelField:
+            return _getKeysIfNoArrays<KeyPatternShape::kSingleTopLevelField>(
+                pooledBufferBuilder, obj, id, keys);
+        case KeyPatternShape::kSingleField:
+            return _getKeysIfNoArrays<KeyPatternShape::kSingleField>(
+                pooledBufferBuilder, obj, id, keys);
+        case KeyPatternShape::kCompound:
+            return _getKeysIfNoArrays<KeyPatternShape::kCompound>(
+                pooledBufferBuilder, obj, id, keys);
+        case KeyPatternShape::kGeneric:
+            return false;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                             const BSONObj& obj,
+                                             boost::optional<RecordId> id,
+                                             KeyStringSet* keys) const {
+    _buildKeyWithoutArray(
+        pooledBufferBuilder,
+        [&](size_t i) { return extractNonArrayElementAtPath(obj, _fieldNames[i]); },
+        id,
+        keys);
+}
+
+boost::optional<std::vector<size_t>> BtreeKeyGenerator::registerSharedPaths(
+    SharedPathExtractor* extractor) const {
+    if (_isIdIndex || _pathsContainPositionalComponent) {
+        return boost::none;
+    }
+
+    std::vector<size_t> slots;
+    slots.reserve(_fieldNames.size());
+    for (auto&& fieldName : _fieldNames) {
+        slots.push_back(extractor->addPath(fieldName));
+    }
+    return slots;
+}
+
+bool BtreeKeyGenerator::getKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                               const SharedPathExtractor& extractor,
+                                               const std::vector<size_t>& slots,
+                                               KeyStringSet* keys,
+                                               MultikeyPaths* multikeyPaths,
+                                               boost::optional<RecordId> id) const {
+    invariant(slots.size() == _fieldNames.size());
+    for (auto slot : slots) {
+        if (extractor.arrayAlongPath(slot)) {
+            return false;
+        }
+    }
+
+    // Without arrays along the indexed paths the document generates a single key and none of the
+    // paths cause the index to be multikey.
+    if (multikeyPaths) {
+        invariant(multikeyPaths->empty());
+        multikeyPaths->resize(_fieldNames.size());
+    }
+    _buildKeyWithoutArray(
+        pooledBufferBuilder, [&](size_t i) { return extractor.getValue(slots[i]); }, id, keys);
+    return true;
+}
+
 void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                           std::vector<BSONElement>* fixed,
                                           SharedBufferFragmentBuilder& pooledBufferBuilder,
@@ -42,6 +42,7 @@
 namespace mongo {
 
 class CollatorInterface;
+class SharedPathExtractor;
 
 /**
  * Internal class used by BtreeAccessMethod to generate keys for indexed documents.
@@ -82,6 +83,29 @@ public:
                  MultikeyPaths* multikeyPaths,
                  boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * Registers the fields of the key pattern with 'extractor' and returns the slot of each field,
+     * in key pattern order, for use with getKeysFromSharedPaths(). Returns boost::none for the _id
+     * index, which has its own fast path, and for key patterns with positional path components,
+     * which a walk that stops at arrays cannot resolve.
+     */
+    boost::optional<std::vector<size_t>> registerSharedPaths(SharedPathExtractor* extractor) const;
+
+    /**
+     * Generates the index keys for the document from which 'extractor' last extracted its values,
+     * using the 'slots' returned by registerSharedPaths(). The keys are the same as getKeys() would
+     * generate, and 'multikeyPaths', if non-null, is set to have no multikey components.
+     *
+     * Returns false without generating any keys if the document has an array along one of the
+     * indexed paths, in which case the caller must use getKeys() instead.
+     */
+    bool getKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                const SharedPathExtractor& extractor,
+                                const std::vector<size_t>& slots,
+                                KeyStringSet* keys,
+                                MultikeyPaths* multikeyPaths,
+                                boost::optional<RecordId> id = boost::none) const;
+
 private:
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
@@ -159,6 +183,54 @@ private:
                               boost::optional<RecordId> id,
                               KeyStringSet* keys) const;
 
+    /**
+     * The shape of the key pattern, determined once at construction, which selects a specialized
+     * version of _getKeysIfNoArrays() for it.
+     */
+    enum class KeyPatternShape {
+        // A single top-level field, such as {a: 1}.
+        kSingleTopLevelField,
+        // A single dotted field, such as {"a.b": 1}.
+        kSingleField,
+        // Several fields, such as {a: 1, "b.c": 1}.
+        kCompound,
+        // Key patterns with positional path components or fixed values, which always need the
+        // generic algorithm.
+        kGeneric,
+    };
+
+    /**
+     * Generates the single key of 'obj' like _getKeysWithoutArray(), but checks along the way that
+     * none of the indexed paths runs into an array. Returns false without generating a key if one
+     * does, in which case the generic algorithm must be used. This lets documents without arrays in
+     * the indexed fields skip the array machinery even when the index may be multikey.
+     */
+    template <KeyPatternShape kShape>
+    bool _getKeysIfNoArrays(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                            const BSONObj& obj,
+                            boost::optional<RecordId> id,
+                            KeyStringSet* keys) const;
+
+    /**
+     * Dispatches to the version of _getKeysIfNoArrays() for the shape of this key pattern. Returns
+     * false if the generic algorithm must be used.
+     */
+    bool _tryGetKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                 const BSONObj& obj,
+                                 boost::optional<RecordId> id,
+                                 KeyStringSet* keys) const;
+
+    /**
+     * Builds the single key of a document without arrays along the indexed paths, where
+     * 'getElement(i)' returns the value of the i-th field of the key pattern, and adds it to 'keys'
+     * unless the index is sparse and all of the fields are missing.
+     */
+    template <typename GetElementFn>
+    void _buildKeyWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                               const GetElementFn& getElement,
+                               boost::optional<RecordId> id,
+                               KeyStringSet* keys) const;
+
     /**
      * A call to _getKeysWithArray() begins by calling this for each field in the key pattern. It
      * traverses the path '*field' in 'obj' until either reaching the end of the path or an array
@@ -229,6 +301,8 @@ private:
     // generator from using the non-multikey fast path.
     bool _pathsContainPositionalComponent{false};
 
+    KeyPatternShape _shape{KeyPatternShape::kGeneric};
+
     const Ordering _ordering;
 
     // These are used by getKeys below.
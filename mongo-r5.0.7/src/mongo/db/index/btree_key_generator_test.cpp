@@ -37,6 +37,7 @@
 #include <iostream>
 
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/shared_path_extractor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/logv2/log.h"
@@ -123,7 +124,7 @@ bool testKeygen(const BSONObj& kp,
                                                       KeyString::Version::kLatestVersion,
                                                       Ordering::make(BSONObj()));
 
-    auto runTest = [&](bool skipMultikey) {
+    auto runTest = [&](bool skipMultikey, bool useSharedPaths = false) {
         //
         // Ask 'keyGen' to generate index keys for the object 'obj' and report any prefixes of the
         // indexed fields that would cause the index to be multikey as a result of inserting
@@ -132,7 +133,20 @@ bool testKeygen(const BSONObj& kp,
         SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
         KeyStringSet actualKeys;
         MultikeyPaths actualMultikeyPaths;
-        keyGen->getKeys(allocator, obj, skipMultikey, &actualKeys, &actualMultikeyPaths);
+        if (useSharedPaths) {
+            // Register an unrelated path as well, as another index built alongside would.
+            SharedPathExtractor extractor;
+            extractor.addPath("unrelated.path");
+            auto slots = keyGen->registerSharedPaths(&extractor);
+            extractor.extract(obj);
+            if (!slots ||
+                !keyGen->getKeysFromSharedPaths(
+                    allocator, extractor, *slots, &actualKeys, &actualMultikeyPaths)) {
+                keyGen->getKeys(allocator, obj, false, &actualKeys, &actualMultikeyPaths);
+            }
+        } else {
+            keyGen->getKeys(allocator, obj, skipMultikey, &actualKeys, &actualMultikeyPaths);
+        }
 
         //
         // Check that the results match the expected result.
@@ -172,6 +186,12 @@ bool testKeygen(const BSONObj& kp,
         }
     }
 
+    // Test that generating keys from shared path values, or falling back to the fully general path
+    // when the document has arrays along the indexed paths, works as expected.
+    if (!runTest(false, true)) {
+        return false;
+    }
+
     // Test that fully general key generation path works as expected.
     return runTest(false);
 }
@@ -1421,4 +1441,114 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetCompoundKeysIgnoresArraysOutsideIndexedPaths) {
+    BSONObj keyPattern = fromjson("{a: 1, 'b.c': 1}");
+    BSONObj genKeysFrom = fromjson("{a: 1, b: {c: 2, d: [3, 4]}, e: [5, 6]}");
+    KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                     fromjson("{'': 1, '': 2}"),
+                                     Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString.release()};
+    MultikeyPaths expectedMultikeyPaths{MultikeyComponents{}, MultikeyComponents{}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, GetCompoundKeysFromArrayInLastIndexedPath) {
+    BSONObj keyPattern = fromjson("{a: 1, 'b.c': 1}");
+    BSONObj genKeysFrom = fromjson("{a: 1, b: [{c: 2}, {c: 3}]}");
+    KeyString::HeapBuilder keyString1(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 1, '': 2}"),
+                                      Ordering::make(BSONObj()));
+    KeyString::HeapBuilder keyString2(KeyString::Version::kLatestVersion,
+                                      fromjson("{'': 1, '': 3}"),
+                                      Ordering::make(BSONObj()));
+    KeyStringSet expectedKeys{keyString1.release(), keyString2.release()};
+    MultikeyPaths expectedMultikeyPaths{MultikeyComponents{}, {0U}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, SharedPathsOfSeveralIndexes) {
+    auto makeKeyGen = [](const std::vector<const char*>& fieldNames) {
+        return std::make_unique<BtreeKeyGenerator>(fieldNames,
+                                                   std::vector<BSONElement>(fieldNames.size()),
+                                                   false,
+                                                   nullptr,
+                                                   KeyString::Version::kLatestVersion,
+                                                   Ordering::make(BSONObj()));
+    };
+    auto first = makeKeyGen({"a.b", "c"});
+    auto second = makeKeyGen({"c", "a.d"});
+
+    SharedPathExtractor extractor;
+    auto firstSlots = first->registerSharedPaths(&extractor);
+    auto secondSlots = second->registerSharedPaths(&extractor);
+    ASSERT(firstSlots && secondSlots);
+    ASSERT_EQ(3U, extractor.numPaths());
+    ASSERT_EQ((*firstSlots)[1], (*secondSlots)[0]);
+
+    for (auto&& obj : {fromjson("{c: 1, a: {d: 2, b: 3}}"),
+                       fromjson("{a: {b: 1}, a: {b: 2, d: 3}}"),
+                       fromjson("{a: 1, c: {x: 2}}"),
+                       fromjson("{}")}) {
+        extractor.extract(obj);
+        for (auto&& [keyGen, slots] : {std::make_pair(first.get(), &*firstSlots),
+                                       std::make_pair(second.get(), &*secondSlots)}) {
+            SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+            KeyStringSet expectedKeys;
+            MultikeyPaths expectedMultikeyPaths;
+            keyGen->getKeys(allocator, obj, false, &expectedKeys, &expectedMultikeyPaths);
+
+            KeyStringSet actualKeys;
+            MultikeyPaths actualMultikeyPaths;
+            ASSERT(keyGen->getKeysFromSharedPaths(
+                allocator, extractor, *slots, &actualKeys, &actualMultikeyPaths));
+            ASSERT(keysetsEqual(expectedKeys, actualKeys))
+                << obj << ": expected " << dumpKeyset(expectedKeys) << ", got "
+                << dumpKeyset(actualKeys);
+            ASSERT(expectedMultikeyPaths == actualMultikeyPaths);
+        }
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, SharedPathsFallBackOnArrays) {
+    std::vector<const char*> fieldNames{"a.b", "c"};
+    BtreeKeyGenerator keyGen(fieldNames,
+                             std::vector<BSONElement>(fieldNames.size()),
+                             false,
+                             nullptr,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(BSONObj()));
+
+    SharedPathExtractor extractor;
+    auto slots = keyGen.registerSharedPaths(&extractor);
+    ASSERT(slots);
+
+    for (auto&& obj : {fromjson("{a: [{b: 1}, {b: 2}], c: 1}"),
+                       fromjson("{a: {b: [1, 2]}, c: 1}"),
+                       fromjson("{a: {b: 1}, c: []}")}) {
+        extractor.extract(obj);
+        SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+        KeyStringSet keys;
+        MultikeyPaths multikeyPaths;
+        ASSERT_FALSE(
+            keyGen.getKeysFromSharedPaths(allocator, extractor, *slots, &keys, &multikeyPaths))
+            << obj;
+        ASSERT(keys.empty());
+        ASSERT(multikeyPaths.empty());
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, SharedPathsNotUsedForPositionalPaths) {
+    std::vector<const char*> fieldNames{"a.0.b"};
+    BtreeKeyGenerator keyGen(fieldNames,
+                             std::vector<BSONElement>(fieldNames.size()),
+                             false,
+                             nullptr,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(BSONObj()));
+
+    SharedPathExtractor extractor;
+    ASSERT_FALSE(keyGen.registerSharedPaths(&extractor));
+    ASSERT_EQ(0U, extractor.numPaths());
+}
+
 }  // namespace
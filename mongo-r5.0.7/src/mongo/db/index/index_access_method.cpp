@@ -36,15 +36,18 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/error_codes.h"
 #include "mongo/base/status.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/shared_path_extractor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
@@ -71,6 +74,18 @@ MONGO_FAIL_POINT_DEFINE(hangDuringIndexBuildBulkLoadYieldSecond);
 
 namespace {
 
+// The keys loaded into new indexes from the external sorter by all index builds, and the time
+// spent loading them, from which the bulk load throughput can be derived.
+Counter64 bulkLoadKeysInserted;
+Counter64 bulkLoadBytesInserted;
+Counter64 bulkLoadMillis;
+ServerStatusMetricField<Counter64> displayBulkLoadKeysInserted("indexBuilds.bulkLoad.keysInserted",
+                                                               &bulkLoadKeysInserted);
+ServerStatusMetricField<Counter64> displayBulkLoadBytesInserted(
+    "indexBuilds.bulkLoad.bytesInserted", &bulkLoadBytesInserted);
+ServerStatusMetricField<Counter64> displayBulkLoadMillis("indexBuilds.bulkLoad.totalMillis",
+                                                         &bulkLoadMillis);
+
 /**
  * Returns true if at least one prefix of any of the indexed fields causes the index to be
  * multikey, and returns false otherwise. This function returns false if the 'multikeyPaths'
@@ -87,7 +102,8 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
-        .DBName(dbName.toString());
+        .DBName(dbName.toString())
+        .SpillInBackground(internalSorterSpillInBackground.load());
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -511,6 +527,10 @@ public:
 
     bool isMultikey() const final;
 
+    void mergeFrom(std::vector<std::unique_ptr<BulkBuilder>> builders) final;
+
+    bool shareExtractedPaths(SharedPathExtractor* extractor) final;
+
     /**
      * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
      * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
@@ -524,6 +544,12 @@ public:
 private:
     void _insertMultikeyMetadataKeysIntoSorter();
 
+    /**
+     * Adds the path components in 'multikeyPaths' to the paths that cause this index to be
+     * multikey.
+     */
+    void _mergeMultikeyPaths(const MultikeyPaths& multikeyPaths);
+
     Sorter* _makeSorter(
         size_t maxMemoryUsageBytes,
         StringData dbName,
@@ -547,6 +573,10 @@ private:
     // These are inserted into the sorter after all normal data keys have been added, just
     // before the bulk build is committed.
     KeyStringSet _multikeyMetadataKeys;
+
+    // If set, keys are generated from the values this extractor extracts at '_sharedPathSlots'.
+    const SharedPathExtractor* _sharedPathExtractor = nullptr;
+    std::vector<size_t> _sharedPathSlots;
 };
 
 std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initiateBulk(
@@ -588,52 +618,55 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(
     auto keys = executionCtx.keys();
     auto multikeyPaths = executionCtx.multikeyPaths();
 
+    auto onSuppressedError = [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+        // If a key generation error was suppressed, record the document as "skipped" so the
+        // index builder can retry at a point when data is consistent.
+        auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+        if (interceptor && interceptor->getSkippedRecordTracker()) {
+            LOGV2_DEBUG(20684,
+                        1,
+                        "Recording suppressed key generation error to retry later: "
+                        "{error} on {loc}: {obj}",
+                        "error"_attr = status,
+                        "loc"_attr = loc,
+                        "obj"_attr = redact(obj));
+
+            // Save and restore the cursor around the write in case it throws a WCE
+            // internally and causes the cursor to be unpositioned.
+            saveCursorBeforeWrite();
+            interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+            restoreCursorAfterWrite();
+        }
+    };
+
     try {
-        _indexCatalogEntry->accessMethod()->getKeys(
-            pooledBuilder,
-            obj,
-            options.getKeysMode,
-            GetKeysContext::kAddingKeys,
-            keys.get(),
-            &_multikeyMetadataKeys,
-            multikeyPaths.get(),
-            loc,
-            [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-
-                    // Save and restore the cursor around the write in case it throws a WCE
-                    // internally and causes the cursor to be unpositioned.
-                    saveCursorBeforeWrite();
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                    restoreCursorAfterWrite();
-                }
-            });
+        if (_sharedPathExtractor) {
+            _indexCatalogEntry->accessMethod()->getKeysFromSharedPaths(pooledBuilder,
+                                                                       obj,
+                                                                       *_sharedPathExtractor,
+                                                                       _sharedPathSlots,
+                                                                       options.getKeysMode,
+                                                                       keys.get(),
+                                                                       &_multikeyMetadataKeys,
+                                                                       multikeyPaths.get(),
+                                                                       loc,
+                                                                       onSuppressedError);
+        } else {
+            _indexCatalogEntry->accessMethod()->getKeys(pooledBuilder,
+                                                        obj,
+                                                        options.getKeysMode,
+                                                        GetKeysContext::kAddingKeys,
+                                                        keys.get(),
+                                                        &_multikeyMetadataKeys,
+                                                        multikeyPaths.get(),
+                                                        loc,
+                                                        onSuppressedError);
+        }
     } catch (...) {
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
-                _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
-            }
-        }
-    }
+    _mergeMultikeyPaths(*multikeyPaths);
 
     for (const auto& keyString : *keys) {
         _sorter->add(keyString, mongo::NullValue());
@@ -655,6 +688,57 @@ bool AbstractIndexAccessMethod::BulkBuilderImpl::isMultikey() const {
     return _isMultiKey;
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::mergeFrom(
+    std::vector<std::unique_ptr<BulkBuilder>> builders) {
+    for (auto& builder : builders) {
+        auto other = checked_cast<BulkBuilderImpl*>(builder.get());
+        invariant(other->_indexCatalogEntry == _indexCatalogEntry);
+
+        _isMultiKey = _isMultiKey || other->_isMultiKey;
+        _mergeMultikeyPaths(other->_indexMultikeyPaths);
+
+        // Multikey metadata keys may have been generated by several builders, so they are
+        // deduplicated here rather than added to each builder's Sorter.
+        _multikeyMetadataKeys.insert(other->_multikeyMetadataKeys.begin(),
+                                     other->_multikeyMetadataKeys.end());
+        other->_multikeyMetadataKeys.clear();
+
+        _keysInserted += other->_keysInserted;
+        _sorter->addSpilledRuns(other->_sorter->releaseSpilledRuns());
+    }
+}
+
+bool AbstractIndexAccessMethod::BulkBuilderImpl::shareExtractedPaths(
+    SharedPathExtractor* extractor) {
+    auto slots = _indexCatalogEntry->accessMethod()->registerSharedPaths(extractor);
+    if (!slots) {
+        return false;
+    }
+
+    _sharedPathExtractor = extractor;
+    _sharedPathSlots = std::move(*slots);
+    return true;
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_mergeMultikeyPaths(
+    const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (_indexMultikeyPaths.empty()) {
+        _indexMultikeyPaths = multikeyPaths;
+        return;
+    }
+
+    invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
+                                      multikeyPaths[i].begin(),
+                                      multikeyPaths[i].end());
+    }
+}
+
 IndexAccessMethod::BulkBuilder::Sorter::Iterator*
 AbstractIndexAccessMethod::BulkBuilderImpl::done() {
     _insertMultikeyMetadataKeysIntoSorter();
@@ -761,6 +845,8 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
     auto builder = _newInterface->makeBulkBuilder(opCtx, dupsAllowed);
 
     KeyString::Value previousKey;
+    int64_t keysLoaded = 0;
+    int64_t bytesLoaded = 0;
 
     for (int64_t i = 0; it->more(); i++) {
         opCtx->checkForInterrupt();
@@ -842,6 +928,11 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
                 return status;
         }
 
+        // Only count the key once it has been added to the index and, if it duplicates the
+        // previous key, recorded for the duplicate key check.
+        ++keysLoaded;
+        bytesLoaded += data.first.getSize();
+
         // Starts yielding locks after the first non-zero 'yieldIterations' inserts.
         if (yieldIterations && (i + 1) % yieldIterations == 0) {
             _yieldBulkLoad(opCtx, &collection, ns);
@@ -853,6 +944,11 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
 
     pm.finished();
 
+    const auto millis = timer.millis();
+    bulkLoadKeysInserted.increment(keysLoaded);
+    bulkLoadBytesInserted.increment(bytesLoaded);
+    bulkLoadMillis.increment(millis);
+
     LOGV2(20685,
           "Index build: inserted {bulk_getKeysInserted} keys from external sorter into index in "
           "{timer_seconds} seconds",
@@ -860,7 +956,10 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
           logAttrs(ns),
           "index"_attr = _descriptor->indexName(),
           "keysInserted"_attr = bulk->getKeysInserted(),
-          "duration"_attr = Milliseconds(Seconds(timer.seconds())));
+          "keysLoaded"_attr = keysLoaded,
+          "bytesLoaded"_attr = bytesLoaded,
+          "keysPerSecond"_attr = keysLoaded * 1000 / std::max<long long>(millis, 1),
+          "duration"_attr = Milliseconds(millis));
     return Status::OK();
 }
 
@@ -927,6 +1026,38 @@ void AbstractIndexAccessMethod::getKeys(SharedBufferFragmentBuilder& pooledBuffe
     }
 }
 
+boost::optional<std::vector<size_t>> AbstractIndexAccessMethod::registerSharedPaths(
+    SharedPathExtractor* extractor) const {
+    return boost::none;
+}
+
+void AbstractIndexAccessMethod::getKeysFromSharedPaths(
+    SharedBufferFragmentBuilder& pooledBufferBuilder,
+    const BSONObj& obj,
+    const SharedPathExtractor& extractor,
+    const std::vector<size_t>& slots,
+    GetKeysMode mode,
+    KeyStringSet* keys,
+    KeyStringSet* multikeyMetadataKeys,
+    MultikeyPaths* multikeyPaths,
+    boost::optional<RecordId> id,
+    OnSuppressedErrorFn onSuppressedError) const {
+    // Key generation from values without arrays cannot fail, so there are no errors to suppress.
+    if (doGetKeysFromSharedPaths(pooledBufferBuilder, extractor, slots, keys, multikeyPaths, id)) {
+        return;
+    }
+
+    getKeys(pooledBufferBuilder,
+            obj,
+            mode,
+            GetKeysContext::kAddingKeys,
+            keys,
+            multikeyMetadataKeys,
+            multikeyPaths,
+            id,
+            std::move(onSuppressedError));
+}
+
 bool AbstractIndexAccessMethod::shouldMarkIndexAsMultikey(
     size_t numberOfKeys,
     const KeyStringSet& multikeyMetadataKeys,
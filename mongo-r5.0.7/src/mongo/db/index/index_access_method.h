@@ -48,6 +48,7 @@ namespace mongo {
 
 class BSONObjBuilder;
 class MatchExpression;
+class SharedPathExtractor;
 struct UpdateTicket;
 struct InsertDeleteOptions;
 
@@ -261,6 +262,24 @@ public:
 
         virtual bool isMultikey() const = 0;
 
+        /**
+         * Moves the keys and multikey state gathered by 'builders', which must have been created
+         * by initiateBulk() on the same index, into this BulkBuilder. The sorted runs spilled by
+         * 'builders' are handed to the underlying Sorter, which merges them with its own without
+         * writing them again. Used to combine the keys generated by the threads of a parallel
+         * collection scan.
+         */
+        virtual void mergeFrom(std::vector<std::unique_ptr<BulkBuilder>> builders) = 0;
+
+        /**
+         * Has insert() generate keys from the values that 'extractor' extracts from each document,
+         * if this index supports it, so that the indexes of a build share a single walk over each
+         * document. Returns false if this index walks the documents itself. Otherwise the caller
+         * must call 'extractor->extract()' on each document before passing it to insert(), and
+         * 'extractor' must outlive this BulkBuilder.
+         */
+        virtual bool shareExtractedPaths(SharedPathExtractor* extractor) = 0;
+
         /**
          * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
          * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
@@ -371,6 +390,31 @@ public:
 
     static OnSuppressedErrorFn kNoopOnSuppressedErrorFn;
 
+    /**
+     * Registers the document paths this index generates keys from with 'extractor' and returns the
+     * slots to pass to getKeysFromSharedPaths(), or boost::none if this index type cannot generate
+     * keys from the extracted values.
+     */
+    virtual boost::optional<std::vector<size_t>> registerSharedPaths(
+        SharedPathExtractor* extractor) const = 0;
+
+    /**
+     * Behaves like getKeys() with GetKeysContext::kAddingKeys, except that the keys are generated
+     * from the values that 'extractor' last extracted from 'obj' at 'slots' when possible. Falls
+     * back to getKeys() for documents whose extracted values are not enough to generate the keys,
+     * such as documents with arrays along the indexed paths.
+     */
+    virtual void getKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const BSONObj& obj,
+                                        const SharedPathExtractor& extractor,
+                                        const std::vector<size_t>& slots,
+                                        GetKeysMode mode,
+                                        KeyStringSet* keys,
+                                        KeyStringSet* multikeyMetadataKeys,
+                                        MultikeyPaths* multikeyPaths,
+                                        boost::optional<RecordId> id,
+                                        OnSuppressedErrorFn onSuppressedError) const = 0;
+
     /**
      * Given the set of keys, multikeyMetadataKeys and multikeyPaths generated by a particular
      * document, return 'true' if the index should be marked as multikey and 'false' otherwise.
@@ -569,6 +613,20 @@ public:
                  boost::optional<RecordId> id,
                  OnSuppressedErrorFn onSuppressedError) const final;
 
+    boost::optional<std::vector<size_t>> registerSharedPaths(
+        SharedPathExtractor* extractor) const override;
+
+    void getKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                const BSONObj& obj,
+                                const SharedPathExtractor& extractor,
+                                const std::vector<size_t>& slots,
+                                GetKeysMode mode,
+                                KeyStringSet* keys,
+                                KeyStringSet* multikeyMetadataKeys,
+                                MultikeyPaths* multikeyPaths,
+                                boost::optional<RecordId> id,
+                                OnSuppressedErrorFn onSuppressedError) const final;
+
     bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
                                    const KeyStringSet& multikeyMetadataKeys,
                                    const MultikeyPaths& multikeyPaths) const override;
@@ -598,6 +656,20 @@ protected:
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const = 0;
 
+    /**
+     * Fills 'keys' and 'multikeyPaths' like doGetKeys() from the values 'extractor' extracted at
+     * the 'slots' returned by registerSharedPaths(). Returns false if the extracted values are not
+     * enough to generate the keys of the document, in which case doGetKeys() is used instead.
+     */
+    virtual bool doGetKeysFromSharedPaths(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                          const SharedPathExtractor& extractor,
+                                          const std::vector<size_t>& slots,
+                                          KeyStringSet* keys,
+                                          MultikeyPaths* multikeyPaths,
+                                          boost::optional<RecordId> id) const {
+        return false;
+    }
+
     const IndexCatalogEntry* const _indexCatalogEntry;  // owned by IndexCatalog
     const IndexDescriptor* const _descriptor;
 
@@ -71,6 +71,55 @@ void BM_KeyGenBasic(benchmark::State& state, bool skipMultikey) {
     }
 }
 
+void BM_KeyGenNested(benchmark::State& state, bool skipMultikey) {
+    constexpr const char* kDottedFieldName = "a.b.c";
+    BSONObj obj = BSON("x" << 1 << "a" << BSON("y" << 2 << "b" << BSON("c" << 3)));
+
+    BtreeKeyGenerator generator({kDottedFieldName},
+                                {BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                makeOrdering(kDottedFieldName));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, skipMultikey, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
+void BM_KeyGenCompound(benchmark::State& state, bool skipMultikey) {
+    BSONObj obj = BSON("a" << 1 << "b"
+                           << "string"
+                           << "c" << BSON("d" << 2.5) << "e" << BSON_ARRAY(1 << 2));
+
+    BtreeKeyGenerator generator({"a", "b", "c.d"},
+                                {BSONElement{}, BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSON("a" << 1 << "b" << 1 << "c.d" << 1)));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        generator.getKeys(allocator, obj, skipMultikey, &keys, &multikeyPaths);
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
 void BM_KeyGenArray(benchmark::State& state, int32_t elements) {
     std::mt19937 gen(numGen());
 
@@ -168,6 +217,12 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
+BENCHMARK_CAPTURE(BM_KeyGenNested, Generic, false);
+BENCHMARK_CAPTURE(BM_KeyGenNested, SkipMultikey, true);
+
+BENCHMARK_CAPTURE(BM_KeyGenCompound, Generic, false);
+BENCHMARK_CAPTURE(BM_KeyGenCompound, SkipMultikey, true);
+
 BENCHMARK_CAPTURE(BM_KeyGenArray, 1K, 1000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 10K, 10000);
 BENCHMARK_CAPTURE(BM_KeyGenArray, 100K, 100000);
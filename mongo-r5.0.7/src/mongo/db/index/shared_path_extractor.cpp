@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/shared_path_extractor.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+SharedPathExtractor::SharedPathExtractor() {
+    _nodes.emplace_back(""_sd);
+}
+
+size_t SharedPathExtractor::addPath(StringData path) {
+    invariant(!path.empty());
+
+    size_t nodeIdx = 0;
+    while (true) {
+        const auto dotOffset = path.find('.');
+        const auto fieldName = path.substr(0, dotOffset);
+
+        auto& children = _nodes[nodeIdx].children;
+        auto childIt = std::find_if(children.begin(), children.end(), [&](size_t childIdx) {
+            return _nodes[childIdx].fieldName == fieldName;
+        });
+        if (childIt != children.end()) {
+            nodeIdx = *childIt;
+        } else {
+            // Adding a node may reallocate '_nodes', so don't keep references across it.
+            const size_t childIdx = _nodes.size();
+            _nodes.emplace_back(fieldName);
+            _nodes[nodeIdx].children.push_back(childIdx);
+            nodeIdx = childIdx;
+        }
+
+        if (dotOffset == std::string::npos) {
+            break;
+        }
+        path = path.substr(dotOffset + 1);
+    }
+
+    auto& node = _nodes[nodeIdx];
+    if (!node.slot) {
+        node.slot = _values.size();
+        _values.emplace_back();
+    }
+    return *node.slot;
+}
+
+void SharedPathExtractor::extract(const BSONObj& obj) {
+    ++_numExtracted;
+    for (auto&& value : _values) {
+        value = Value{};
+    }
+    _extractChildren(obj, 0);
+}
+
+void SharedPathExtractor::_extractChildren(const BSONObj& obj, size_t nodeIdx) {
+    const auto& children = _nodes[nodeIdx].children;
+    size_t numUnmatched = children.size();
+
+    for (auto&& elt : obj) {
+        if (numUnmatched == 0) {
+            break;
+        }
+
+        const auto fieldName = elt.fieldNameStringData();
+        for (auto childIdx : children) {
+            auto& child = _nodes[childIdx];
+            if (child.lastMatched == _numExtracted || child.fieldName != fieldName) {
+                continue;
+            }
+
+            child.lastMatched = _numExtracted;
+            --numUnmatched;
+            _extractAt(elt, childIdx);
+            break;
+        }
+    }
+}
+
+void SharedPathExtractor::_extractAt(const BSONElement& elt, size_t nodeIdx) {
+    if (elt.type() == BSONType::Array) {
+        _markArrayAlongPath(nodeIdx);
+        return;
+    }
+
+    const auto& node = _nodes[nodeIdx];
+    if (node.slot) {
+        _values[*node.slot].element = elt;
+    }
+
+    // Paths that continue past a scalar don't exist in the document, e.g. "a.b" in {a: 1}.
+    if (!node.children.empty() && elt.type() == BSONType::Object) {
+        _extractChildren(elt.embeddedObject(), nodeIdx);
+    }
+}
+
+void SharedPathExtractor::_markArrayAlongPath(size_t nodeIdx) {
+    const auto& node = _nodes[nodeIdx];
+    if (node.slot) {
+        _values[*node.slot].arrayAlongPath = true;
+    }
+    for (auto childIdx : node.children) {
+        _markArrayAlongPath(childIdx);
+    }
+}
+
+}  // namespace mongo
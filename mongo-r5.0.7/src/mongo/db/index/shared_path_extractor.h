@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * Extracts the values of a set of dotted paths from a document in a single walk over it. Index
+ * builds use this to avoid having every index being built walk the same document paths
+ * independently when generating its keys: each index registers its paths once, the document is
+ * walked once, and each index then builds its keys from the extracted values.
+ *
+ * The walk stops at arrays. If a prefix of a registered path, or the path itself, names an array,
+ * then no value is extracted for that path and arrayAlongPath() returns true for it. Key generators
+ * must then fall back to walking the document themselves in order to expand the array.
+ */
+class SharedPathExtractor {
+public:
+    SharedPathExtractor();
+
+    /**
+     * Registers the dotted 'path' and returns the slot at which extract() stores its value.
+     * Registering the same path more than once returns the same slot.
+     */
+    size_t addPath(StringData path);
+
+    size_t numPaths() const {
+        return _values.size();
+    }
+
+    /**
+     * Extracts the values of all registered paths from 'obj', replacing the values extracted from
+     * the previous document. As with BSONObj::getField(), the first occurrence of a duplicated
+     * field name wins. The extracted elements point into 'obj', which must outlive their use.
+     */
+    void extract(const BSONObj& obj);
+
+    /**
+     * Returns the element found at the path registered at 'slot', or EOO if the path doesn't exist
+     * in the last extracted document. Always EOO if arrayAlongPath() is true for 'slot'.
+     */
+    BSONElement getValue(size_t slot) const {
+        return _values[slot].element;
+    }
+
+    /**
+     * Returns true if the walk over the last extracted document ran into an array at the path
+     * registered at 'slot' or at any of its prefixes.
+     */
+    bool arrayAlongPath(size_t slot) const {
+        return _values[slot].arrayAlongPath;
+    }
+
+private:
+    // A component of one or more registered paths. The root node has an empty field name.
+    struct Node {
+        explicit Node(StringData name) : fieldName(name.toString()) {}
+
+        std::string fieldName;
+        std::vector<size_t> children;
+
+        // The slot of the registered path that ends at this node, if any.
+        boost::optional<size_t> slot;
+
+        // The number of the last extract() call that matched this node, so that only the first
+        // occurrence of a field name is considered.
+        unsigned long long lastMatched = 0;
+    };
+
+    struct Value {
+        BSONElement element;
+        bool arrayAlongPath = false;
+    };
+
+    void _extractChildren(const BSONObj& obj, size_t nodeIdx);
+
+    void _extractAt(const BSONElement& elt, size_t nodeIdx);
+
+    void _markArrayAlongPath(size_t nodeIdx);
+
+    std::vector<Node> _nodes;
+    std::vector<Value> _values;
+    unsigned long long _numExtracted = 0;
+};
+
+}  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -84,6 +85,10 @@ public:
 private:
     IndexCatalogEntry* _indexCatalogEntry;
 
+    // Serializes the lazy creation of '_skippedRecordsTable', since the threads of a parallel
+    // collection scan may record skipped records concurrently.
+    Mutex _mutex = MONGO_MAKE_LATCH("SkippedRecordTracker::_mutex");
+
     // This temporary record store is owned by the duplicate key tracker and should be dropped or
     // kept along with it with a call to finalizeTemporaryTable().
     std::unique_ptr<TemporaryRecordStore> _skippedRecordsTable;
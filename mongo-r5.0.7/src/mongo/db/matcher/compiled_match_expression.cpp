@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <algorithm>
+
+#include "mongo/db/field_ref.h"
+
+namespace mongo {
+
+namespace {
+
+// A node's children are tracked in a bitmask while scanning a document, so nodes with more children
+// than this look each of them up separately instead.
+constexpr size_t kMaxChildrenForSinglePass = 64;
+
+}  // namespace
+
+CompiledMatchExpression::CompiledMatchExpression(const MatchExpression* expr) : _expr(expr) {
+    invariant(expr);
+    _nodes.emplace_back();
+
+    std::vector<const MatchExpression*> conjuncts{expr};
+    while (!conjuncts.empty()) {
+        const auto conjunct = conjuncts.back();
+        conjuncts.pop_back();
+
+        if (conjunct->matchType() == MatchExpression::AND) {
+            for (size_t i = conjunct->numChildren(); i > 0; --i) {
+                conjuncts.push_back(conjunct->getChild(i - 1));
+            }
+        } else if (conjunct->fieldRef() && conjunct->fieldRef()->numParts() > 0) {
+            // Every path expression evaluates the element its path resolves to, or EOO if the path
+            // is missing, when no array lies along the path.
+            addPredicate(conjunct);
+        } else {
+            _residual.push_back(conjunct);
+        }
+    }
+}
+
+void CompiledMatchExpression::addPredicate(const MatchExpression* expr) {
+    const FieldRef& path = *expr->fieldRef();
+    size_t nodeIndex = 0;
+    for (size_t part = 0; part < path.numParts(); ++part) {
+        const auto fieldName = path.getPart(part);
+        auto& children = _nodes[nodeIndex].children;
+        auto child = std::find_if(children.begin(), children.end(), [&](auto&& child) {
+            return child.first == fieldName;
+        });
+        if (child != children.end()) {
+            nodeIndex = child->second;
+        } else {
+            children.emplace_back(fieldName.toString(), _nodes.size());
+            nodeIndex = _nodes.size();
+            _nodes.emplace_back();
+        }
+    }
+    _nodes[nodeIndex].predicates.push_back(expr);
+    ++_numCompiledPredicates;
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc) const {
+    if (!matchesObject(_nodes[0], doc, doc)) {
+        return false;
+    }
+
+    for (auto&& residual : _residual) {
+        if (!residual->matchesBSON(doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatchExpression::matchesObject(const PathNode& node,
+                                            const BSONObj& obj,
+                                            const BSONObj& doc) const {
+    const auto& children = node.children;
+    if (children.size() > kMaxChildrenForSinglePass) {
+        for (auto&& [fieldName, childIndex] : children) {
+            if (!matchesElement(_nodes[childIndex], obj.getField(fieldName), doc)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Only the first occurrence of a field name is considered, as BSONObj::getField() would.
+    uint64_t found = 0;
+    size_t numFound = 0;
+    BSONObjIterator it(obj);
+    while (numFound < children.size() && it.more()) {
+        const auto elem = it.next();
+        const auto fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (children[i].first != fieldName) {
+                continue;
+            }
+            const uint64_t bit = uint64_t{1} << i;
+            if (!(found & bit)) {
+                found |= bit;
+                ++numFound;
+                if (!matchesElement(_nodes[children[i].second], elem, doc)) {
+                    return false;
+                }
+            }
+            break;
+        }
+    }
+
+    // Evaluate the predicates on the paths missing from 'obj'.
+    for (size_t i = 0; numFound < children.size() && i < children.size(); ++i) {
+        if (!(found & (uint64_t{1} << i)) &&
+            !matchesElement(_nodes[children[i].second], BSONElement(), doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatchExpression::matchesElement(const PathNode& node,
+                                             const BSONElement& elem,
+                                             const BSONObj& doc) const {
+    if (elem.type() == BSONType::Array) {
+        return matchesGeneric(node, doc);
+    }
+
+    for (auto&& predicate : node.predicates) {
+        if (!predicate->matchesSingleElement(elem)) {
+            return false;
+        }
+    }
+
+    if (node.children.empty()) {
+        return true;
+    }
+
+    if (elem.type() == BSONType::Object) {
+        return matchesObject(node, elem.embeddedObject(), doc);
+    }
+
+    // The remainder of every path beneath this node is missing.
+    for (auto&& child : node.children) {
+        if (!matchesElement(_nodes[child.second], BSONElement(), doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatchExpression::matchesGeneric(const PathNode& node, const BSONObj& doc) const {
+    for (auto&& predicate : node.predicates) {
+        if (!predicate->matchesBSON(doc)) {
+            return false;
+        }
+    }
+    for (auto&& child : node.children) {
+        if (!matchesGeneric(_nodes[child.second], doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
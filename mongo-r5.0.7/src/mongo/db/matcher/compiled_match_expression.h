@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A MatchExpression flattened for repeated evaluation against BSON documents.
+ *
+ * The conjuncts of the expression which are simple predicates on a field path, such as {a: 1} or
+ * {'b.c': {$gt: 2}}, are gathered into a tree keyed on the components of their paths, so that
+ * predicates which share a path prefix also share its lookup. matchesBSON() resolves all of these
+ * paths in a single pass over the fields of each (sub)document, evaluating every predicate directly
+ * against the element it finds rather than allocating an ElementIterator for each predicate. Paths
+ * which run into an array fall back to the predicates' own matchesBSON(), which implements
+ * implicit array traversal. The remaining conjuncts are evaluated as usual once the compiled
+ * predicates have matched.
+ *
+ * The MatchExpression must outlive this object, and must not be modified while this object is in
+ * use.
+ */
+class CompiledMatchExpression {
+public:
+    explicit CompiledMatchExpression(const MatchExpression* expr);
+
+    /**
+     * Returns true if 'doc' matches the expression. Equivalent to 'expression()->matchesBSON(doc)'.
+     */
+    bool matchesBSON(const BSONObj& doc) const;
+
+    const MatchExpression* expression() const {
+        return _expr;
+    }
+
+    /**
+     * Returns the number of predicates which are evaluated through the path tree rather than by
+     * the MatchExpression itself.
+     */
+    size_t numCompiledPredicates() const {
+        return _numCompiledPredicates;
+    }
+
+private:
+    struct PathNode {
+        // The predicates whose path ends at this node.
+        std::vector<const MatchExpression*> predicates;
+
+        // The next component of the paths passing through this node, and the index of the node
+        // it leads to.
+        std::vector<std::pair<std::string, size_t>> children;
+    };
+
+    void addPredicate(const MatchExpression* expr);
+
+    /**
+     * Evaluates the predicates beneath 'node' against the fields of 'obj', a (sub)document of
+     * 'doc'.
+     */
+    bool matchesObject(const PathNode& node, const BSONObj& obj, const BSONObj& doc) const;
+
+    /**
+     * Evaluates the predicates at and beneath 'node' given that its path resolves to 'elem', or to
+     * nothing if 'elem' is EOO.
+     */
+    bool matchesElement(const PathNode& node, const BSONElement& elem, const BSONObj& doc) const;
+
+    /**
+     * Evaluates the predicates at and beneath 'node' using the generic path traversal.
+     */
+    bool matchesGeneric(const PathNode& node, const BSONObj& doc) const;
+
+    const MatchExpression* const _expr;
+
+    // _nodes[0] is the root of the path tree, standing for the document itself.
+    std::vector<PathNode> _nodes;
+    size_t _numCompiledPredicates = 0;
+
+    // The conjuncts which cannot be evaluated through the path tree.
+    std::vector<const MatchExpression*> _residual;
+};
+
+}  // namespace mongo
@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const char* filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    return uassertStatusOK(MatchExpressionParser::parse(fromjson(filter), expCtx));
+}
+
+const std::vector<BSONObj> kDocuments = {
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: 2, b: 'x'}"),
+    fromjson("{a: null, b: {c: 1}}"),
+    fromjson("{a: [1, 2], b: {c: [3, 4]}}"),
+    fromjson("{a: {b: 1}, b: {c: 2, d: 'y'}}"),
+    fromjson("{a: [{b: 1}, {b: 2}], b: 5}"),
+    fromjson("{a: 1, a: 2, b: {c: 1, c: 5}}"),
+    fromjson("{a: {'0': 1}, b: {c: {d: 1}}}"),
+    fromjson("{a: [[1]], b: {c: null}}"),
+    fromjson("{a: 'x', b: {c: 1, d: 'x'}, e: 7}"),
+};
+
+const std::vector<const char*> kFilters = {
+    "{}",
+    "{a: 1}",
+    "{a: null}",
+    "{a: {$exists: false}}",
+    "{a: {$gte: 1}, 'b.c': 1}",
+    "{'b.c': {$in: [1, 2, 3]}, 'b.d': {$type: 'string'}}",
+    "{'a.b': 1}",
+    "{'a.b': {$exists: true}, b: {$gt: 4}}",
+    "{'a.0': 1}",
+    "{a: [1]}",
+    "{a: {$size: 2}}",
+    "{a: {$elemMatch: {b: 2}}}",
+    "{'b.c.d': 1, 'b.c': {$exists: true}}",
+    "{a: 1, $or: [{b: 'x'}, {'b.c': 1}]}",
+    "{a: {$not: {$gt: 1}}, e: 7}",
+    "{$and: [{a: {$lt: 3}}, {$and: [{'b.c': {$ne: 2}}]}]}",
+    "{b: {$regex: '^x'}, a: {$mod: [2, 0]}}",
+};
+
+TEST(CompiledMatchExpressionTest, MatchesLikeMatchExpression) {
+    for (auto&& filter : kFilters) {
+        auto expr = parse(filter);
+        CompiledMatchExpression compiled(expr.get());
+        for (auto&& doc : kDocuments) {
+            ASSERT_EQ(compiled.matchesBSON(doc), expr->matchesBSON(doc))
+                << "filter: " << filter << " document: " << doc;
+        }
+    }
+}
+
+TEST(CompiledMatchExpressionTest, CompilesOnlyPathPredicatesOfTheTopLevelConjunction) {
+    auto expr =
+        parse("{a: 1, 'b.c': {$gt: 1, $lt: 5}, $or: [{d: 1}, {e: 1}], f: {$not: {$gt: 1}}}");
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numCompiledPredicates(), 3U);
+    ASSERT_EQ(compiled.expression(), expr.get());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -183,6 +183,9 @@ bool NamespaceString::isLegalClientSystemNS(
     if (isTimeseriesBucketsCollection()) {
         return true;
     }
+    if (isStatisticsCollection()) {
+        return true;
+    }
 
     return false;
 }
@@ -329,6 +332,10 @@ bool NamespaceString::isTimeseriesBucketsCollection() const {
     return coll().startsWith(kTimeseriesBucketsCollectionPrefix);
 }
 
+bool NamespaceString::isStatisticsCollection() const {
+    return coll().startsWith(kStatisticsCollectionPrefix);
+}
+
 bool NamespaceString::isChangeStreamPreImagesCollection() const {
     return ns() == kChangeStreamPreImagesNamespace.ns();
 }
@@ -346,6 +353,10 @@ NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
     return {db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size())};
 }
 
+NamespaceString NamespaceString::makeStatisticsNamespace() const {
+    return {db(), kStatisticsCollectionPrefix.toString() + coll()};
+}
+
 bool NamespaceString::isReplicated() const {
     if (isLocal()) {
         return false;
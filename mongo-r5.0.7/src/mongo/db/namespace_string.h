@@ -95,6 +95,9 @@ public:
     // Prefix for time-series buckets collection.
     static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
 
+    // Prefix for the collections holding the query planner statistics built by 'analyze'.
+    static constexpr StringData kStatisticsCollectionPrefix = "system.statistics."_sd;
+
     // Namespace for storing configuration data, which needs to be replicated if the server is
     // running as a replica set. Documents in this collection should represent some configuration
     // state of the server, which needs to be recovered/consulted at startup. Each document in this
@@ -372,6 +375,11 @@ public:
      */
     bool isTimeseriesBucketsCollection() const;
 
+    /**
+     * Returns whether the specified namespace is <database>.system.statistics.<>.
+     */
+    bool isStatisticsCollection() const;
+
     /**
      * Returns whether the specified namespace is config.system.preimages.
      */
@@ -392,6 +400,11 @@ public:
      */
     NamespaceString getTimeseriesViewNamespace() const;
 
+    /**
+     * Returns the namespace holding the query planner statistics for this collection.
+     */
+    NamespaceString makeStatisticsNamespace() const;
+
     /**
      * Returns whether a namespace is replicated, based only on its string value. One notable
      * omission is that map reduce `tmp.mr` collections may or may not be replicated. Callers must
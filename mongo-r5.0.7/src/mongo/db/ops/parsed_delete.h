@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/base/status.h"
+#include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/query/plan_executor.h"
 
 namespace mongo {
@@ -115,6 +116,18 @@ public:
         return _expCtx;
     }
 
+    /**
+     * Restricts the delete to the documents whose RecordIds lie within 'bounds', which are then
+     * visited with a forward collection scan rather than with a plan chosen by the query planner.
+     */
+    void setRecordIdBounds(RecordIdBounds bounds) {
+        _recordIdBounds = std::move(bounds);
+    }
+
+    const boost::optional<RecordIdBounds>& getRecordIdBounds() const {
+        return _recordIdBounds;
+    }
+
 private:
     // Transactional context.  Not owned by us.
     OperationContext* _opCtx;
@@ -126,6 +139,8 @@ private:
     std::unique_ptr<CanonicalQuery> _canonicalQuery;
 
     boost::intrusive_ptr<ExpressionContext> _expCtx;
+
+    boost::optional<RecordIdBounds> _recordIdBounds;
 };
 
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/base/status.h"
+#include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/matcher/expression_with_placeholder.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/plan_yield_policy.h"
@@ -134,6 +135,18 @@ public:
         return _expCtx;
     }
 
+    /**
+     * Restricts the update to the documents whose RecordIds lie within 'bounds', which are then
+     * visited with a forward collection scan rather than with a plan chosen by the query planner.
+     */
+    void setRecordIdBounds(RecordIdBounds bounds) {
+        _recordIdBounds = std::move(bounds);
+    }
+
+    const boost::optional<RecordIdBounds>& getRecordIdBounds() const {
+        return _recordIdBounds;
+    }
+
 private:
     /**
      * Parses the query portion of the update request.
@@ -164,6 +177,8 @@ private:
 
     // Reference to an extensions callback used when parsing to a canonical query.
     const ExtensionsCallback& _extensionsCallback;
+
+    boost::optional<RecordIdBounds> _recordIdBounds;
 };
 
 }  // namespace mongo
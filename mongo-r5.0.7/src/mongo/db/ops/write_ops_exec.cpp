@@ -31,9 +31,12 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/base/counter.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection_operation_source.h"
@@ -41,7 +44,9 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
@@ -62,7 +67,9 @@
 #include "mongo/db/ops/write_ops_retryability.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_executor_impl.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -72,6 +79,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_options.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/server_write_concern_metrics.h"
 #include "mongo/db/stats/top.h"
@@ -84,7 +92,10 @@
 #include "mongo/db/update/update_oplog_entry_serialization.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
@@ -582,6 +593,263 @@ SingleWriteResult makeWriteResultForInsertOrDeleteRetry() {
     return res;
 }
 
+// The number of RecordId ranges per worker into which a multi-document write applied by parallel
+// workers is split, so that a worker which finishes its ranges early takes over work from the
+// others.
+constexpr int64_t kMultiWriteRangesPerWorker = 8;
+
+Counter64 parallelMultiWritesCounter;
+ServerStatusMetricField<Counter64> displayParallelMultiWrites("query.parallelMultiWrites",
+                                                              &parallelMultiWritesCounter);
+
+/**
+ * Describes how a multi-document update or delete is split among parallel workers.
+ */
+struct ParallelMultiWritePlan {
+    NamespaceStringOrUUID nsOrUUID;
+    long long numRecords;
+    std::vector<RecordIdBounds> ranges;
+};
+
+/**
+ * Returns true if 'exec' applies an update or delete to the documents returned by a plain
+ * collection scan.
+ */
+bool isCollectionScanWrite(PlanExecutor* exec) {
+    auto execImpl = dynamic_cast<PlanExecutorImpl*>(exec);
+    if (!execImpl) {
+        return false;
+    }
+
+    const auto root = execImpl->getRootStage();
+    if (root->stageType() != STAGE_UPDATE && root->stageType() != STAGE_DELETE) {
+        return false;
+    }
+    const auto& children = root->getChildren();
+    return children.size() == 1 && children.front()->stageType() == STAGE_COLLSCAN;
+}
+
+/**
+ * Returns the RecordId ranges among which to split a multi-document update or delete of
+ * 'collection' that 'exec' would otherwise apply with a single collection scan, or boost::none if
+ * the write should be applied on this thread.
+ */
+boost::optional<ParallelMultiWritePlan> planParallelMultiWrite(OperationContext* opCtx,
+                                                               const CollectionPtr& collection,
+                                                               const BSONObj& hint,
+                                                               PlanExecutor* exec) {
+    const int maxWorkers = internalMultiWriteMaxParallelWorkers.load();
+    if (maxWorkers <= 1 || !collection || !hint.isEmpty()) {
+        return boost::none;
+    }
+
+    // Each worker writes in its own operation, so writes which must be atomic or retryable stay on
+    // this thread, as do writes nested within other locked operations. Shard servers are excluded
+    // since the workers do not carry the shard version of the operation. The RecordIds of
+    // clustered collections are not integers, and capped collections must be written in order.
+    const auto& ns = collection->ns();
+    if (opCtx->inMultiDocumentTransaction() || opCtx->getTxnNumber() ||
+        opCtx->getClient()->isInDirectClient() ||
+        opCtx->lockState()->isGlobalLockedRecursively() ||
+        serverGlobalParams.clusterRole == ClusterRole::ShardServer || ns.isSystem() ||
+        collection->isCapped() || collection->isClustered()) {
+        return boost::none;
+    }
+
+    const long long numRecords = collection->numRecords(opCtx);
+    if (numRecords < internalMultiWriteParallelMinRecords.load() ||
+        !isCollectionScanWrite(exec)) {
+        return boost::none;
+    }
+
+    auto first = collection->getCursor(opCtx, /*forward=*/true)->next();
+    auto last = collection->getCursor(opCtx, /*forward=*/false)->next();
+    if (!first || !last) {
+        return boost::none;
+    }
+
+    // Split the RecordIds between the first and last record into ranges of equal width. The first
+    // and last ranges are unbounded so that the workers see the same records a serial scan would.
+    const int64_t minId = first->id.getLong();
+    const int64_t maxId = last->id.getLong();
+    const int64_t width = (maxId - minId) / (maxWorkers * kMultiWriteRangesPerWorker) + 1;
+    ParallelMultiWritePlan plan{
+        NamespaceStringOrUUID(ns.db().toString(), collection->uuid()), numRecords, {}};
+    for (int64_t start = minId; start <= maxId; start += width) {
+        RecordIdBounds range;
+        if (start != minId) {
+            range.minRecord = RecordId(start);
+        }
+        if (maxId - start >= width) {
+            range.maxRecord = RecordId(start + width - 1);
+        }
+        plan.ranges.push_back(std::move(range));
+    }
+
+    if (plan.ranges.size() < 2) {
+        return boost::none;
+    }
+    return plan;
+}
+
+using MultiWriteRangeFn =
+    std::function<PlanSummaryStats(OperationContext*, const CollectionPtr&, const RecordIdBounds&)>;
+
+/**
+ * Applies a multi-document write to the ranges of RecordIds in 'plan' on up to
+ * 'internalMultiWriteMaxParallelWorkers' worker operations. Each worker repeatedly takes the next
+ * range no worker has started on, and calls 'applyToRange' for it while holding an intent lock on
+ * the collection. The workers yield independently of each other, and the progress of the write is
+ * reported in the $currentOp entry of this operation, which must not hold any locks. Returns the
+ * summary statistics of the plans of all the ranges.
+ *
+ * As for a serial multi-document write, the documents in ranges which the workers completed
+ * before an error remain written.
+ */
+PlanSummaryStats applyMultiWriteInParallel(OperationContext* opCtx,
+                                           const ParallelMultiWritePlan& plan,
+                                           const MultiWriteRangeFn& applyToRange) {
+    invariant(!opCtx->lockState()->isLocked());
+    parallelMultiWritesCounter.increment();
+
+    auto& curOp = *CurOp::get(opCtx);
+    const auto ns = curOp.getNS();
+    const auto networkOp = curOp.getNetworkOp();
+    const auto logicalOp = curOp.getLogicalOp();
+    const auto opDescription = curOp.opDescription();
+    const auto validationSettings = DocumentValidationSettings::get(opCtx);
+
+    ProgressMeterHolder progress;
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        progress.set(curOp.setProgress_inlock("Multi-document write: documents examined",
+                                              plan.numRecords));
+    }
+
+    const size_t numWorkers = std::min(
+        static_cast<size_t>(std::max(internalMultiWriteMaxParallelWorkers.load(), 1)),
+        plan.ranges.size());
+
+    auto mutex = MONGO_MAKE_LATCH("write_ops_exec::applyMultiWriteInParallel::mutex");
+    stdx::condition_variable workersDone;
+    size_t numRunning = numWorkers;
+    size_t nextRange = 0;
+    bool stopWrite = false;
+    std::vector<OperationContext*> workerOpCtxs;
+    Status workerStatus = Status::OK();
+    PlanSummaryStats summary;
+    OpDebug::AdditiveMetrics workerMetrics;
+
+    std::vector<stdx::thread> workers;
+    ON_BLOCK_EXIT([&] {
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            stopWrite = true;
+            for (auto workerOpCtx : workerOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                opCtx->getServiceContext()->killOperation(
+                    clientLock, workerOpCtx, ErrorCodes::Interrupted);
+            }
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Report the work of the workers even if the write failed.
+        curOp.debug().additiveMetrics.add(workerMetrics);
+    });
+
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([&, i] {
+            Status status = Status::OK();
+            try {
+                ThreadClient tc(str::stream() << "MultiWriteWorker-" << i,
+                                opCtx->getServiceContext());
+                AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+                {
+                    stdx::lock_guard<Client> lk(*tc.get());
+                    tc.get()->setSystemOperationKillableByStepdown(lk);
+                }
+
+                auto workerOpCtx = cc().makeOperationContext();
+                DocumentValidationSettings::get(workerOpCtx.get()) = validationSettings;
+                auto& workerCurOp = *CurOp::get(workerOpCtx.get());
+                {
+                    stdx::lock_guard<Client> lk(*tc.get());
+                    workerCurOp.setNS_inlock(ns);
+                    workerCurOp.setNetworkOp_inlock(networkOp);
+                    workerCurOp.setLogicalOp_inlock(logicalOp);
+                    workerCurOp.setOpDescription_inlock(opDescription);
+                    workerCurOp.ensureStarted();
+                }
+
+                {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    workerOpCtxs.push_back(workerOpCtx.get());
+                }
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    workerOpCtxs.erase(
+                        std::find(workerOpCtxs.begin(), workerOpCtxs.end(), workerOpCtx.get()));
+                    workerMetrics.add(workerCurOp.debug().additiveMetrics);
+                });
+
+                while (true) {
+                    RecordIdBounds range;
+                    {
+                        stdx::lock_guard<Latch> lk(mutex);
+                        if (stopWrite || nextRange == plan.ranges.size()) {
+                            break;
+                        }
+                        range = plan.ranges[nextRange++];
+                    }
+
+                    PlanSummaryStats rangeSummary;
+                    {
+                        AutoGetCollection collection(workerOpCtx.get(), plan.nsOrUUID, MODE_IX);
+                        uassert(ErrorCodes::NamespaceNotFound,
+                                str::stream()
+                                    << "Collection " << plan.nsOrUUID.toString()
+                                    << " was dropped during a multi-document write",
+                                collection);
+                        assertCanWrite_inlock(workerOpCtx.get(), collection.getNss());
+                        rangeSummary =
+                            applyToRange(workerOpCtx.get(), collection.getCollection(), range);
+                    }
+
+                    stdx::lock_guard<Latch> lk(mutex);
+                    summary.accumulate(rangeSummary);
+                }
+            } catch (...) {
+                status = exceptionToStatus();
+            }
+
+            stdx::lock_guard<Latch> lk(mutex);
+            if (!status.isOK() && workerStatus.isOK()) {
+                workerStatus = status;
+                stopWrite = true;
+            }
+            if (--numRunning == 0) {
+                workersDone.notify_all();
+            }
+        });
+    }
+
+    stdx::unique_lock<Latch> lk(mutex);
+    size_t numReported = 0;
+    auto reportProgress = [&] {
+        progress->hit(static_cast<int>(summary.totalDocsExamined - numReported));
+        numReported = summary.totalDocsExamined;
+    };
+    while (!opCtx->waitForConditionOrInterruptFor(
+        workersDone, lk, Milliseconds(500), [&] { return numRunning == 0; })) {
+        reportProgress();
+    }
+    reportProgress();
+    uassertStatusOK(workerStatus);
+    return summary;
+}
+
 }  // namespace
 
 WriteResult performInserts(OperationContext* opCtx,
@@ -716,6 +984,75 @@ WriteResult performInserts(OperationContext* opCtx,
     return out;
 }
 
+/**
+ * Applies a multi-document update, which the caller has checked with planParallelMultiWrite(), on
+ * parallel workers. The caller must have released its locks.
+ */
+static SingleWriteResult performParallelMultiUpdateOp(OperationContext* opCtx,
+                                                      UpdateRequest* updateRequest,
+                                                      const ParallelMultiWritePlan& plan,
+                                                      bool* containsDotsAndDollarsField) {
+    AtomicWord<long long> numMatched{0};
+    AtomicWord<long long> numDocsModified{0};
+    AtomicWord<bool> containsDotsAndDollars{false};
+    const auto summary = applyMultiWriteInParallel(
+        opCtx,
+        plan,
+        [&](OperationContext* workerOpCtx,
+            const CollectionPtr& collection,
+            const RecordIdBounds& range) {
+            const ExtensionsCallbackReal extensionsCallback(workerOpCtx,
+                                                            &updateRequest->getNamespaceString());
+            ParsedUpdate parsedUpdate(workerOpCtx,
+                                      updateRequest,
+                                      extensionsCallback,
+                                      true /* forgoOpCounterIncrements */);
+            parsedUpdate.setRecordIdBounds(range);
+            uassertStatusOK(parsedUpdate.parseRequest());
+
+            auto exec = uassertStatusOK(getExecutorUpdate(&CurOp::get(workerOpCtx)->debug(),
+                                                          &collection,
+                                                          &parsedUpdate,
+                                                          boost::none /* verbosity */));
+            auto updateResult = exec->executeUpdate();
+            numMatched.fetchAndAdd(updateResult.numMatched);
+            numDocsModified.fetchAndAdd(updateResult.numDocsModified);
+            if (updateResult.containsDotsAndDollarsField) {
+                containsDotsAndDollars.store(true);
+            }
+
+            PlanSummaryStats rangeSummary;
+            exec->getPlanExplainer().getSummaryStats(&rangeSummary);
+            CollectionQueryInfo::get(collection).notifyOfQuery(
+                workerOpCtx, collection, rangeSummary);
+            return rangeSummary;
+        });
+
+    const UpdateResult updateResult(numMatched.load() > 0 /* existing */,
+                                    false /* modifiers */,
+                                    numDocsModified.load(),
+                                    numMatched.load(),
+                                    BSONObj() /* upsertedObject */,
+                                    containsDotsAndDollars.load());
+
+    auto& curOp = *CurOp::get(opCtx);
+    recordUpdateResultInOpDebug(updateResult, &curOp.debug());
+    curOp.debug().setPlanSummaryMetrics(summary);
+
+    LastError::get(opCtx->getClient())
+        .recordUpdate(updateResult.existing, updateResult.numMatched, updateResult.upsertedId);
+
+    SingleWriteResult result;
+    result.setN(updateResult.numMatched);
+    result.setNModified(updateResult.numDocsModified);
+
+    if (containsDotsAndDollarsField && updateResult.containsDotsAndDollarsField) {
+        *containsDotsAndDollarsField = true;
+    }
+
+    return result;
+}
+
 static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
                                                const NamespaceString& ns,
                                                UpdateRequest* updateRequest,
@@ -836,6 +1173,17 @@ static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
         CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
     }
 
+    if (updateRequest->isMulti() && !updateRequest->isUpsert() &&
+        source == OperationSource::kStandard) {
+        if (auto plan = planParallelMultiWrite(
+                opCtx, collection->getCollection(), updateRequest->getHint(), exec.get())) {
+            exec.reset();
+            collection.reset();
+            return performParallelMultiUpdateOp(
+                opCtx, updateRequest, *plan, containsDotsAndDollarsField);
+        }
+    }
+
     auto updateResult = exec->executeUpdate();
 
     PlanSummaryStats summary;
@@ -1058,6 +1406,48 @@ WriteResult performUpdates(OperationContext* opCtx,
     return out;
 }
 
+/**
+ * Applies a multi-document delete, which the caller has checked with planParallelMultiWrite(), on
+ * parallel workers. The caller must have released its locks.
+ */
+static SingleWriteResult performParallelMultiDeleteOp(OperationContext* opCtx,
+                                                      const DeleteRequest* request,
+                                                      const ParallelMultiWritePlan& plan) {
+    AtomicWord<long long> nDeleted{0};
+    const auto summary = applyMultiWriteInParallel(
+        opCtx,
+        plan,
+        [&](OperationContext* workerOpCtx,
+            const CollectionPtr& collection,
+            const RecordIdBounds& range) {
+            ParsedDelete parsedDelete(workerOpCtx, request);
+            parsedDelete.setRecordIdBounds(range);
+            uassertStatusOK(parsedDelete.parseRequest());
+
+            auto exec = uassertStatusOK(getExecutorDelete(&CurOp::get(workerOpCtx)->debug(),
+                                                          &collection,
+                                                          &parsedDelete,
+                                                          boost::none /* verbosity */));
+            nDeleted.fetchAndAdd(exec->executeDelete());
+
+            PlanSummaryStats rangeSummary;
+            exec->getPlanExplainer().getSummaryStats(&rangeSummary);
+            CollectionQueryInfo::get(collection).notifyOfQuery(
+                workerOpCtx, collection, rangeSummary);
+            return rangeSummary;
+        });
+
+    auto& curOp = *CurOp::get(opCtx);
+    curOp.debug().additiveMetrics.ndeleted = nDeleted.load();
+    curOp.debug().setPlanSummaryMetrics(summary);
+
+    LastError::get(opCtx->getClient()).recordDelete(nDeleted.load());
+
+    SingleWriteResult result;
+    result.setN(nDeleted.load());
+    return result;
+}
+
 static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
                                                const NamespaceString& ns,
                                                StmtId stmtId,
@@ -1107,15 +1497,16 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         uasserted(ErrorCodes::InternalError, "failAllRemoves failpoint active!");
     }
 
-    AutoGetCollection collection(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
+    boost::optional<AutoGetCollection> collection;
+    collection.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
 
     DeleteStageParams::DocumentCounter documentCounter = nullptr;
 
     if (source == OperationSource::kTimeseriesDelete) {
         uassert(ErrorCodes::NamespaceNotFound,
                 "Could not find time-series buckets collection for write",
-                *collection);
-        auto timeseriesOptions = collection->getTimeseriesOptions();
+                collection->getCollection());
+        auto timeseriesOptions = collection->getCollection()->getTimeseriesOptions();
         uassert(ErrorCodes::InvalidOptions,
                 "Time-series buckets collection is missing time-series options",
                 timeseriesOptions);
@@ -1148,7 +1539,7 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
     ParsedDelete parsedDelete(opCtx, &request);
     uassertStatusOK(parsedDelete.parseRequest());
 
-    if (collection.getDb()) {
+    if (collection->getDb()) {
         curOp.raiseDbProfileLevel(CollectionCatalog::get(opCtx)->getDatabaseProfileLevel(ns.db()));
     }
 
@@ -1158,7 +1549,7 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         &hangWithLockDuringBatchRemove, opCtx, "hangWithLockDuringBatchRemove");
 
     auto exec = uassertStatusOK(getExecutorDelete(&curOp.debug(),
-                                                  &collection.getCollection(),
+                                                  &collection->getCollection(),
                                                   &parsedDelete,
                                                   boost::none /* verbosity */,
                                                   std::move(documentCounter)));
@@ -1168,13 +1559,22 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
         CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
     }
 
+    if (request.getMulti() && source == OperationSource::kStandard) {
+        if (auto plan = planParallelMultiWrite(
+                opCtx, collection->getCollection(), request.getHint(), exec.get())) {
+            exec.reset();
+            collection.reset();
+            return performParallelMultiDeleteOp(opCtx, &request, *plan);
+        }
+    }
+
     auto nDeleted = exec->executeDelete();
     curOp.debug().additiveMetrics.ndeleted = nDeleted;
 
     PlanSummaryStats summary;
     auto&& explainer = exec->getPlanExplainer();
     explainer.getSummaryStats(&summary);
-    if (const auto& coll = collection.getCollection()) {
+    if (const auto& coll = collection->getCollection()) {
         CollectionQueryInfo::get(coll).notifyOfQuery(opCtx, coll, summary);
     }
     curOp.debug().setPlanSummaryMetrics(summary);
@@ -46,6 +46,7 @@
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/ctype.h"
 #include "mongo/util/str.h"
 
@@ -81,6 +82,7 @@ intrusive_ptr<DocumentSource> DocumentSourceMatch::optimize() {
     }
 
     _expression = MatchExpression::optimize(std::move(_expression));
+    _compiledExpression = boost::none;
 
     return this;
 }
@@ -89,6 +91,10 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     // The user facing error should have been generated earlier.
     massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
 
+    if (!_compiledExpression && internalQueryEnableCompiledMatchExpressions.load()) {
+        _compiledExpression.emplace(_expression.get());
+    }
+
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
         // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
@@ -98,7 +104,8 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
             : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
                                                              _dependencies.fields);
 
-        if (_expression->matchesBSON(toMatch)) {
+        if (_compiledExpression ? _compiledExpression->matchesBSON(toMatch)
+                                : _expression->matchesBSON(toMatch)) {
             return nextInput;
         }
 
@@ -420,6 +427,7 @@ DocumentSourceMatch::splitSourceByFunc(const std::set<std::string>& fields,
                                        expression::ShouldSplitExprFunc func) && {
     pair<unique_ptr<MatchExpression>, unique_ptr<MatchExpression>> newExpr(
         expression::splitMatchExpressionBy(std::move(_expression), fields, renames, func));
+    _compiledExpression = boost::none;
 
     invariant(newExpr.first || newExpr.second);
 
@@ -537,6 +545,7 @@ DocumentSourceMatch::DocumentSourceMatch(const BSONObj& query,
 
 void DocumentSourceMatch::rebuild(BSONObj filter) {
     _predicate = filter.getOwned();
+    _compiledExpression = boost::none;
     _expression = uassertStatusOK(MatchExpressionParser::parse(
         _predicate, pExpCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures));
     _isTextQuery = isTextQuery(_predicate);
@@ -34,6 +34,7 @@
 #include <utility>
 
 #include "mongo/client/connpool.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/matcher.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -214,6 +215,10 @@ private:
 
     std::unique_ptr<MatchExpression> _expression;
 
+    // '_expression' compiled for matching. Built on the first call to getNext(), since the
+    // expression may be rewritten while the pipeline is optimized, and reset whenever it changes.
+    boost::optional<CompiledMatchExpression> _compiledExpression;
+
     bool _isTextQuery;
 
     // Cache the dependencies so that we know what fields we need to serialize to BSON for matching.
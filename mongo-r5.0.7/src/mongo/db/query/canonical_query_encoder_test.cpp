@@ -314,6 +314,14 @@ TEST(CanonicalQueryEncoderTest, ComputeKeyMatchInDependsOnPresenceOfRegexAndFlag
     testComputeKey("{a: {$not: {$in: [/foo/i]}}}", "{}", "{}", "nt[rea/i/]");
 }
 
+TEST(CanonicalQueryEncoderTest, ComputeKeyMatchInIsIndependentOfListLength) {
+    BSONArrayBuilder values;
+    for (int i = 0; i < 10000; ++i) {
+        values.append(i);
+    }
+    testComputeKey(BSON("a" << BSON("$in" << values.arr())), {}, {}, "ina");
+}
+
 TEST(CanonicalQueryEncoderTest, CheckCollationIsEncoded) {
 
     unique_ptr<CanonicalQuery> cq(canonicalize(
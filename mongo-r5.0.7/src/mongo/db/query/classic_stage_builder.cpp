@@ -63,6 +63,7 @@
 #include "mongo/db/exec/text_or.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/logv2/log.h"
 
@@ -112,6 +113,9 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.direction = ixn->direction;
             params.addKeyMetadata = ixn->addKeyMetadata;
             params.shouldDedup = ixn->shouldDedup;
+            if (auto it = _topKSortBounds.find(ixn); it != _topKSortBounds.end()) {
+                params.topKSortBound = it->second;
+            }
             return std::make_unique<IndexScan>(
                 expCtx, _collection, std::move(params), _ws, ixn->filter.get());
         }
@@ -123,8 +127,9 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_SORT_DEFAULT: {
             auto snDefault = static_cast<const SortNodeDefault*>(root);
+            auto topKSortBound = pushDownTopKSortBound(*snDefault);
             auto childStage = build(snDefault->children[0]);
-            return std::make_unique<SortStageDefault>(
+            auto sortStage = std::make_unique<SortStageDefault>(
                 _cq.getExpCtx(),
                 _ws,
                 SortPattern{snDefault->pattern, _cq.getExpCtx()},
@@ -132,11 +137,16 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                 snDefault->maxMemoryUsageBytes,
                 snDefault->addSortKeyMetadata,
                 std::move(childStage));
+            if (topKSortBound) {
+                sortStage->setTopKSortBound(std::move(topKSortBound));
+            }
+            return sortStage;
         }
         case STAGE_SORT_SIMPLE: {
             auto snSimple = static_cast<const SortNodeSimple*>(root);
+            auto topKSortBound = pushDownTopKSortBound(*snSimple);
             auto childStage = build(snSimple->children[0]);
-            return std::make_unique<SortStageSimple>(
+            auto sortStage = std::make_unique<SortStageSimple>(
                 _cq.getExpCtx(),
                 _ws,
                 SortPattern{snSimple->pattern, _cq.getExpCtx()},
@@ -144,6 +154,10 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                 snSimple->maxMemoryUsageBytes,
                 snSimple->addSortKeyMetadata,
                 std::move(childStage));
+            if (topKSortBound) {
+                sortStage->setTopKSortBound(std::move(topKSortBound));
+            }
+            return sortStage;
         }
         case STAGE_SORT_KEY_GENERATOR: {
             const SortKeyGeneratorNode* keyGenNode = static_cast<const SortKeyGeneratorNode*>(root);
@@ -279,8 +293,23 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                     _ftsKeyPrefixSize);
 
             auto node = static_cast<const TextOrNode*>(root);
-            auto ret = std::make_unique<TextOrStage>(
-                expCtx, *_ftsKeyPrefixSize, _ws, node->filter.get(), _collection);
+            boost::optional<TextOrStage::TopKParams> topKParams;
+            if (node->limit) {
+                tassert(6194502,
+                        "text match parameters must be defined to limit a TEXT_OR node",
+                        _textMatchParams);
+                topKParams.emplace(
+                    TextOrStage::TopKParams{node->limit,
+                                            _textMatchParams->spec,
+                                            _textMatchParams->query.getTermsForBounds()});
+            }
+            auto ret = std::make_unique<TextOrStage>(expCtx,
+                                                     *_ftsKeyPrefixSize,
+                                                     _ws,
+                                                     node->filter.get(),
+                                                     _collection,
+                                                     node->phraseTermScans,
+                                                     std::move(topKParams));
             for (auto childNode : root->children) {
                 ret->addChild(build(childNode));
             }
@@ -311,7 +340,11 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             // here before recursively descending into procession child nodes, and will reset once a
             // text sub-tree is constructed.
             _ftsKeyPrefixSize.emplace(params.spec.numExtraBefore());
-            ON_BLOCK_EXIT([&] { _ftsKeyPrefixSize = {}; });
+            _textMatchParams = &params;
+            ON_BLOCK_EXIT([&] {
+                _ftsKeyPrefixSize = {};
+                _textMatchParams = nullptr;
+            });
 
             return std::make_unique<TextMatchStage>(expCtx, build(root->children[0]), params, _ws);
         }
@@ -427,4 +460,60 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
 
     MONGO_UNREACHABLE;
 }
+
+std::shared_ptr<TopKSortBound> ClassicStageBuilder::pushDownTopKSortBound(const SortNode& sortNode) {
+    if (sortNode.limit == 0 || !internalQueryEnableTopKSortBoundPushdown.load()) {
+        return nullptr;
+    }
+
+    // Sort keys generated under a collation are comparison keys, which we cannot reproduce from
+    // the index keys without knowing that both use the same collator.
+    if (_cq.getCollator()) {
+        return nullptr;
+    }
+
+    // Only stages which pass through a subset of their input in the same form may sit between the
+    // sort and the index scan, since a document that cannot make it into the top-k may then be
+    // discarded at any point below the sort.
+    const QuerySolutionNode* node = sortNode.children[0];
+    while (node->getType() == STAGE_FETCH || node->getType() == STAGE_SHARDING_FILTER) {
+        node = node->children[0];
+    }
+    if (node->getType() != STAGE_IXSCAN) {
+        return nullptr;
+    }
+
+    // The sort key of a document is only guaranteed to match its index key if no indexed field
+    // holds an array, and if the key is not a hash or other derived value.
+    const auto ixn = static_cast<const IndexScanNode*>(node);
+    if (ixn->index.type != INDEX_BTREE || ixn->index.multikey || ixn->index.collator) {
+        return nullptr;
+    }
+
+    std::vector<size_t> keyPositions;
+    for (auto&& sortElt : sortNode.pattern) {
+        if (!sortElt.isNumber()) {
+            // A $meta sort cannot be answered from the index keys.
+            return nullptr;
+        }
+
+        size_t position = 0;
+        bool found = false;
+        for (auto&& keyElt : ixn->index.keyPattern) {
+            if (keyElt.fieldNameStringData() == sortElt.fieldNameStringData()) {
+                found = true;
+                break;
+            }
+            ++position;
+        }
+        if (!found) {
+            return nullptr;
+        }
+        keyPositions.push_back(position);
+    }
+
+    auto bound = std::make_shared<TopKSortBound>(sortNode.pattern, std::move(keyPositions));
+    _topKSortBounds[ixn] = bound;
+    return bound;
+}
 }  // namespace mongo::stage_builder
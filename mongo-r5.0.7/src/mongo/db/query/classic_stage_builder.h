@@ -30,7 +30,10 @@
 #pragma once
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/text_match.h"
+#include "mongo/db/exec/top_k_sort_bound.h"
 #include "mongo/db/query/stage_builder.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo::stage_builder {
 /**
@@ -48,8 +51,21 @@ public:
     std::unique_ptr<PlanStage> build(const QuerySolutionNode* root) final;
 
 private:
+    /**
+     * If 'sortNode' is a top-k sort whose sort key can be recovered from the keys of an index scan
+     * beneath it, creates a TopKSortBound to be shared between the two stages and registers it for
+     * that index scan. Returns null if the bound cannot be pushed down.
+     */
+    std::shared_ptr<TopKSortBound> pushDownTopKSortBound(const SortNode& sortNode);
+
     WorkingSet* _ws;
 
     boost::optional<size_t> _ftsKeyPrefixSize;
+
+    // Parameters of the TEXT_MATCH stage whose sub-tree is being built, if any.
+    const TextMatchParams* _textMatchParams = nullptr;
+
+    // Top-k sort bounds to attach to index scans, keyed by the index scan's solution node.
+    stdx::unordered_map<const QuerySolutionNode*, std::shared_ptr<TopKSortBound>> _topKSortBounds;
 };
 }  // namespace mongo::stage_builder
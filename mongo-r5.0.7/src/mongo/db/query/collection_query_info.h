@@ -30,9 +30,11 @@
 #pragma once
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -67,6 +69,13 @@ public:
     */
     const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const;
 
+    /**
+     * Returns true if an update which modified 'modifiedPaths' may change the keys generated for
+     * the index described by 'desc'. Returns true for indexes whose paths are not yet known.
+     */
+    bool updateMightAffectIndex(const IndexDescriptor* desc,
+                                const FieldRefSetWithStorage& modifiedPaths) const;
+
     /**
      * Builds internal cache state based on the current state of the Collection's IndexCatalog.
      */
@@ -105,6 +114,8 @@ private:
     // ---  index keys cache
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
+    // The paths indexed by each individual index, keyed by index name.
+    StringMap<UpdateIndexData> _indexedPathsByIndex;
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
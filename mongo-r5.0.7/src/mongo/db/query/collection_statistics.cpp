@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collection_statistics.h"
+
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getCollectionStatistics =
+    SharedCollectionDecorations::declareDecoration<CollectionStatistics>();
+
+}  // namespace
+
+CollectionStatistics& CollectionStatistics::get(const CollectionPtr& collection) {
+    return getCollectionStatistics(collection->getSharedDecorations());
+}
+
+std::shared_ptr<const CollectionStatistics::IndexStatisticsMap> CollectionStatistics::getSnapshot(
+    OperationContext* opCtx, const CollectionPtr& collection) {
+    const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_lastRefresh &&
+            now - *_lastRefresh < Seconds(internalQueryStatisticsRefreshIntervalSecs.load())) {
+            return _indexStats;
+        }
+    }
+
+    _refresh(opCtx, collection, now);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _indexStats;
+}
+
+void CollectionStatistics::_refresh(OperationContext* opCtx,
+                                    const CollectionPtr& collection,
+                                    Date_t now) {
+    // The statistics collection lives in the same database, so its lock can only be taken by
+    // callers which hold the database lock rather than reading lock-free.
+    const auto& nss = collection->ns();
+    if (!opCtx->lockState()->isDbLockedForMode(nss.db(), MODE_IS)) {
+        return;
+    }
+
+    const auto statsNss = nss.makeStatisticsNamespace();
+    IndexStatisticsMap indexStats;
+    {
+        Lock::CollectionLock statsLock(opCtx, statsNss, MODE_IS);
+        const auto statsColl =
+            CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, statsNss);
+        if (statsColl) {
+            auto cursor = statsColl->getCursor(opCtx);
+            while (auto record = cursor->next()) {
+                const auto doc = record->data.toBson();
+                // Left behind by a collection which previously had this name.
+                if (auto uuid = UUID::parse(doc[kCollectionUUIDField]);
+                    !uuid.isOK() || uuid.getValue() != collection->uuid()) {
+                    continue;
+                }
+
+                try {
+                    indexStats[doc["_id"].String()] =
+                        std::make_shared<const IndexStatistics>(IndexStatistics::parse(doc));
+                } catch (const DBException& ex) {
+                    LOGV2_WARNING(6194505,
+                                  "Ignoring malformed index statistics",
+                                  "namespace"_attr = statsNss,
+                                  "error"_attr = ex.toStatus());
+                }
+            }
+        }
+    }
+
+    set(std::move(indexStats), now);
+}
+
+void CollectionStatistics::set(IndexStatisticsMap indexStats, Date_t refreshedAt) {
+    auto snapshot = std::make_shared<const IndexStatisticsMap>(std::move(indexStats));
+    stdx::lock_guard<Latch> lk(_mutex);
+    _indexStats = std::move(snapshot);
+    _lastRefresh = refreshedAt;
+}
+
+}  // namespace mongo
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class NamespaceString;
+class OperationContext;
+
+/**
+ * The in-memory copy of the index statistics which 'analyze' persists in a collection's
+ * <db>.system.statistics.<coll> namespace, keyed by index name. All Collection instances for the
+ * same collection share one instance through their SharedCollectionDecorations.
+ *
+ * The statistics are loaded lazily by the planner and reloaded once they are older than
+ * 'internalQueryStatisticsRefreshIntervalSecs', which is how statistics gathered on another
+ * member of a replica set eventually take effect. Each persisted document records the UUID of the
+ * analyzed collection, so that the statistics of a collection which has since been dropped, or
+ * renamed away, are not applied to another collection with the same name.
+ */
+class CollectionStatistics {
+public:
+    using IndexStatisticsMap = StringMap<std::shared_ptr<const IndexStatistics>>;
+
+    // The field of each persisted document holding the UUID of the analyzed collection.
+    static constexpr StringData kCollectionUUIDField = "collectionUUID"_sd;
+
+    static CollectionStatistics& get(const CollectionPtr& collection);
+
+    /**
+     * Returns the statistics for all of the analyzed indexes of 'collection', reloading them from
+     * its statistics collection first if they have never been loaded or are older than the
+     * refresh interval. Reloading requires the database lock in at least MODE_IS; without it the
+     * statistics are left as they are. The returned map is never modified, and is replaced as a
+     * whole when the statistics change.
+     */
+    std::shared_ptr<const IndexStatisticsMap> getSnapshot(OperationContext* opCtx,
+                                                          const CollectionPtr& collection);
+
+    /**
+     * Replaces the statistics for all of the collection's indexes.
+     */
+    void set(IndexStatisticsMap indexStats, Date_t refreshedAt);
+
+private:
+    void _refresh(OperationContext* opCtx, const CollectionPtr& collection, Date_t now);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CollectionStatistics::_mutex");
+    std::shared_ptr<const IndexStatisticsMap> _indexStats =
+        std::make_shared<const IndexStatisticsMap>();
+    boost::optional<Date_t> _lastRefresh;
+};
+
+}  // namespace mongo
@@ -30,13 +30,18 @@
 #include "mongo/db/query/expression_index.h"
 
 #include <iostream>
+#include <limits>
 #include <unordered_set>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/r2_region_coverer.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -45,6 +50,50 @@ namespace mongo {
 
 using std::set;
 
+namespace {
+
+Counter64 s2CoveringCacheHits;
+Counter64 s2CoveringCacheMisses;
+ServerStatusMetricField<Counter64> s2CoveringCacheHitsMetric("query.s2CoveringCache.hits",
+                                                             &s2CoveringCacheHits);
+ServerStatusMetricField<Counter64> s2CoveringCacheMissesMetric("query.s2CoveringCache.misses",
+                                                               &s2CoveringCacheMisses);
+
+/**
+ * The index intervals of the most recently used 2dsphere query regions. Applications often query
+ * the same few regions over and over, e.g. fixed polygons for geofencing, and covering a complex
+ * region is expensive.
+ */
+class S2CoveringCache {
+public:
+    using Intervals = std::shared_ptr<const std::vector<Interval>>;
+
+    static S2CoveringCache& get() {
+        static S2CoveringCache cache(gInternalQueryS2CoveringCacheSize);
+        return cache;
+    }
+
+    explicit S2CoveringCache(size_t size) : _cache(size) {}
+
+    Intervals find(const BSONObj& key) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _cache.find(key);
+        return it == _cache.end() ? nullptr : it->second;
+    }
+
+    void add(const BSONObj& key, Intervals intervals) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(key.getOwned(), std::move(intervals));
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+    LRUCache<BSONObj, Intervals, SimpleBSONObjComparator::Hasher, SimpleBSONObjComparator::EqualTo>
+        _cache;
+};
+
+}  // namespace
+
 BSONObj ExpressionMapping::hash(const BSONElement& value) {
     BSONObjBuilder bob;
     bob.append("", BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED));
@@ -132,6 +181,40 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+void ExpressionMapping::cover2dsphereCached(const BSONObj& regionKey,
+                                            const S2Region& region,
+                                            const S2IndexingParams& indexingParams,
+                                            OrderedIntervalList* oilOut) {
+    if (gInternalQueryS2CoveringCacheSize == 0) {
+        cover2dsphere(region, indexingParams, oilOut);
+        return;
+    }
+
+    // The intervals also depend on the index and on the parameters of the covering.
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("region", regionKey);
+    keyBuilder.append("indexVersion", static_cast<int>(indexingParams.indexVersion));
+    keyBuilder.append("coarsestIndexedLevel", indexingParams.coarsestIndexedLevel);
+    keyBuilder.append("coarsestLevel", gInternalQueryS2GeoCoarsestLevel.load());
+    keyBuilder.append("finestLevel", gInternalQueryS2GeoFinestLevel.load());
+    keyBuilder.append("maxCells", gInternalQueryS2GeoMaxCells.load());
+    const BSONObj key = keyBuilder.obj();
+
+    auto& cache = S2CoveringCache::get();
+    auto intervals = cache.find(key);
+    if (intervals) {
+        s2CoveringCacheHits.increment();
+    } else {
+        s2CoveringCacheMisses.increment();
+        OrderedIntervalList covering;
+        cover2dsphere(region, indexingParams, &covering);
+        intervals = std::make_shared<const std::vector<Interval>>(std::move(covering.intervals));
+        cache.add(key, intervals);
+    }
+
+    oilOut->intervals.insert(oilOut->intervals.end(), intervals->begin(), intervals->end());
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -162,6 +245,51 @@ void S2CellIdsToIntervalsUnsorted(const std::vector<S2CellId>& intervalSet,
         }
     }
 }
+
+/**
+ * Merges the sorted intervals of a covering that are adjacent, i.e. the first cell id of one
+ * follows the last cell id of the previous one. The cell ranges of the children of a cell are
+ * separated by the id of the cell itself, so the ranges of sibling cells usually merge with the
+ * point interval of their parent. Each merge saves the index scan a seek.
+ */
+void coalesceAdjacentIntervals(const S2IndexVersion indexVersion, OrderedIntervalList* oilOut) {
+    // Earlier index versions index cell ids as strings, which cannot be adjacent.
+    if (indexVersion < S2_INDEX_VERSION_3 || oilOut->intervals.size() < 2) {
+        return;
+    }
+
+    std::vector<Interval> coalesced;
+    coalesced.reserve(oilOut->intervals.size());
+    long long start = 0;
+    long long end = 0;
+    auto flush = [&] {
+        if (start == end) {
+            coalesced.push_back(IndexBoundsBuilder::makePointInterval(BSON("" << start)));
+        } else {
+            coalesced.push_back(IndexBoundsBuilder::makeRangeInterval(
+                BSON("start" << start << "end" << end),
+                BoundInclusion::kIncludeBothStartAndEndKeys));
+        }
+    };
+
+    for (size_t i = 0; i < oilOut->intervals.size(); ++i) {
+        const Interval& interval = oilOut->intervals[i];
+        invariant(interval.startInclusive && interval.endInclusive);
+        if (i > 0 && end != std::numeric_limits<long long>::max() &&
+            interval.start.numberLong() == end + 1) {
+            end = interval.end.numberLong();
+            continue;
+        }
+        if (i > 0) {
+            flush();
+        }
+        start = interval.start.numberLong();
+        end = interval.end.numberLong();
+    }
+    flush();
+
+    oilOut->intervals = std::move(coalesced);
+}
 }  // namespace
 
 void ExpressionMapping::S2CellIdsToIntervals(const std::vector<S2CellId>& intervalSet,
@@ -219,6 +347,7 @@ void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2Cell
 
     S2CellIdsToIntervalsUnsorted(intervalSet, indexParams.indexVersion, oilOut);
     std::sort(oilOut->intervals.begin(), oilOut->intervals.end(), compareIntervals);
+    coalesceAdjacentIntervals(indexParams.indexVersion, oilOut);
     // Make sure that our intervals don't overlap each other and are ordered correctly.
     // This perhaps should only be done in debug mode.
     if (!oilOut->isValidFor(1)) {
@@ -78,6 +78,13 @@ public:
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    // Same as cover2dsphere, but reuses the intervals computed for recent queries on the same
+    // region. 'regionKey' must identify 'region', e.g. the geometry of the query predicate.
+    static void cover2dsphereCached(const BSONObj& regionKey,
+                                    const S2Region& region,
+                                    const S2IndexingParams& indexParams,
+                                    OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
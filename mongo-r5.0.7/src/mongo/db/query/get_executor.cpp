@@ -66,10 +66,12 @@
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_estimator.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -154,6 +156,20 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !findCommand.getTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns a forward collection scan over the documents within 'bounds' which match 'cq'. Used by
+ * writes which are split between several workers by RecordId range, instead of planning.
+ */
+std::unique_ptr<PlanStage> makeBoundedCollectionScan(const CollectionPtr& collection,
+                                                     WorkingSet* ws,
+                                                     const CanonicalQuery* cq,
+                                                     const RecordIdBounds& bounds) {
+    CollectionScanParams params;
+    params.minRecord = bounds.minRecord;
+    params.maxRecord = bounds.maxRecord;
+    return std::make_unique<CollectionScan>(cq->getExpCtxRaw(), collection, params, ws, cq->root());
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -389,6 +405,32 @@ bool shouldWaitForOplogVisibility(OperationContext* opCtx,
 }
 
 namespace {
+/**
+ * Returns the position in 'solutions' of the plan with the lowest estimated cost according to the
+ * index statistics gathered by 'analyze', or boost::none if any of the plans cannot be costed.
+ */
+boost::optional<size_t> pickLowestCostSolution(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions) {
+    const auto indexStats = CollectionStatistics::get(collection).getSnapshot(opCtx, collection);
+    if (indexStats->empty()) {
+        return boost::none;
+    }
+
+    return plan_cost_estimator::pickLowestCost(
+        solutions,
+        collection->numRecords(opCtx),
+        [&](const IndexEntry& index) -> const IndexStatistics* {
+            // An index may have been rebuilt under the same name since it was analyzed.
+            auto it = indexStats->find(index.identifier.catalogName);
+            if (it == indexStats->end() || it->second->keyPattern().woCompare(index.keyPattern)) {
+                return nullptr;
+            }
+            return it->second.get();
+        });
+}
+
 /**
  * A base class to hold the result returned by PrepareExecutionHelper::prepare call.
  */
@@ -685,6 +727,24 @@ public:
             }
         }
 
+        // When there are statistics for every index the candidates scan, pick the plan the cost
+        // model considers cheapest instead of running the candidates against each other. The
+        // choice is cheap to repeat, so it is not cached.
+        if (solutions.size() > 1 && internalQueryPlannerEnableCostBasedRanking.load()) {
+            if (auto best = pickLowestCostSolution(_opCtx, _collection, solutions)) {
+                auto result = makeResult();
+                auto root = buildExecutableTree(*solutions[*best]);
+                result->emplace(std::move(root), std::move(solutions[*best]));
+
+                LOGV2_DEBUG(6194506,
+                            2,
+                            "Picked the plan with the lowest estimated cost",
+                            "query"_attr = redact(_cq->toStringShort()),
+                            "planSummary"_attr = result->getPlanSummary());
+                return std::move(result);
+            }
+        }
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
@@ -777,9 +837,11 @@ public:
                                   WorkingSet* ws,
                                   CanonicalQuery* cq,
                                   PlanYieldPolicy* yieldPolicy,
-                                  size_t plannerOptions)
+                                  size_t plannerOptions,
+                                  bool allowMidQueryReplanning = false)
         : PrepareExecutionHelper{opCtx, collection, std::move(cq), yieldPolicy, plannerOptions},
-          _ws{ws} {}
+          _ws{ws},
+          _allowMidQueryReplanning{allowMidQueryReplanning} {}
 
 protected:
     std::unique_ptr<PlanStage> buildExecutableTree(const QuerySolution& solution) const final {
@@ -867,7 +929,8 @@ protected:
                                                           _cq,
                                                           plannerParams,
                                                           decisionWorks,
-                                                          std::move(root)),
+                                                          std::move(root),
+                                                          _allowMidQueryReplanning),
                         std::move(solution));
         return result;
     }
@@ -907,6 +970,10 @@ protected:
 
 private:
     WorkingSet* _ws;
+
+    // Whether a cached plan may be replanned after it has started returning results. Only set
+    // when the plan is read-only, since replanning may yield from within the root's work().
+    const bool _allowMidQueryReplanning;
 };
 
 /**
@@ -1030,8 +1097,15 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecu
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
     auto ws = std::make_unique<WorkingSet>();
-    ClassicPrepareExecutionHelper helper{
-        opCtx, *collection, ws.get(), canonicalQuery.get(), nullptr, plannerOptions};
+    // A cached plan is the root of a read-only plan here, so it may switch plans mid-query.
+    const bool allowMidQueryReplanning = true;
+    ClassicPrepareExecutionHelper helper{opCtx,
+                                         *collection,
+                                         ws.get(),
+                                         canonicalQuery.get(),
+                                         nullptr,
+                                         plannerOptions,
+                                         allowMidQueryReplanning};
     auto executionResult = helper.prepare();
     if (!executionResult.isOK()) {
         return executionResult.getStatus();
@@ -1391,8 +1465,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
 
     if (!parsedDelete->hasParsedQuery()) {
 
-        // Only consider using the idhack if no hint was provided.
-        if (request->getHint().isEmpty()) {
+        // Only consider using the idhack if no hint or RecordId bounds were provided.
+        if (request->getHint().isEmpty() && !parsedDelete->getRecordIdBounds()) {
             // This is the idhack fast-path for getting a PlanExecutor without doing the work to
             // create a CanonicalQuery.
             const BSONObj& unparsedQuery = request->getQuery();
@@ -1463,14 +1537,20 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     // identify the record to update.
     const size_t defaultPlannerOptions = QueryPlannerParams::PRESERVE_RECORD_ID;
 
-    ClassicPrepareExecutionHelper helper{
-        opCtx, collection, ws.get(), cq.get(), nullptr, defaultPlannerOptions};
-    auto executionResult = helper.prepare();
-    if (!executionResult.isOK()) {
-        return executionResult.getStatus();
+    std::unique_ptr<QuerySolution> querySolution;
+    std::unique_ptr<PlanStage> root;
+    if (const auto& bounds = parsedDelete->getRecordIdBounds()) {
+        root = makeBoundedCollectionScan(collection, ws.get(), cq.get(), *bounds);
+    } else {
+        ClassicPrepareExecutionHelper helper{
+            opCtx, collection, ws.get(), cq.get(), nullptr, defaultPlannerOptions};
+        auto executionResult = helper.prepare();
+        if (!executionResult.isOK()) {
+            return executionResult.getStatus();
+        }
+        querySolution = executionResult.getValue()->solution();
+        root = executionResult.getValue()->root();
     }
-    auto querySolution = executionResult.getValue()->solution();
-    auto root = executionResult.getValue()->root();
 
     deleteStageParams->canonicalQuery = cq.get();
 
@@ -1577,8 +1657,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
 
     if (!parsedUpdate->hasParsedQuery()) {
 
-        // Only consider using the idhack if no hint was provided.
-        if (request->getHint().isEmpty()) {
+        // Only consider using the idhack if no hint or RecordId bounds were provided.
+        if (request->getHint().isEmpty() && !parsedUpdate->getRecordIdBounds()) {
             // This is the idhack fast-path for getting a PlanExecutor without doing the work
             // to create a CanonicalQuery.
             const BSONObj& unparsedQuery = request->getQuery();
@@ -1633,14 +1713,20 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
     // identify the record to update.
     const size_t defaultPlannerOptions = QueryPlannerParams::PRESERVE_RECORD_ID;
 
-    ClassicPrepareExecutionHelper helper{
-        opCtx, collection, ws.get(), cq.get(), nullptr, defaultPlannerOptions};
-    auto executionResult = helper.prepare();
-    if (!executionResult.isOK()) {
-        return executionResult.getStatus();
+    std::unique_ptr<QuerySolution> querySolution;
+    std::unique_ptr<PlanStage> root;
+    if (const auto& bounds = parsedUpdate->getRecordIdBounds()) {
+        root = makeBoundedCollectionScan(collection, ws.get(), cq.get(), *bounds);
+    } else {
+        ClassicPrepareExecutionHelper helper{
+            opCtx, collection, ws.get(), cq.get(), nullptr, defaultPlannerOptions};
+        auto executionResult = helper.prepare();
+        if (!executionResult.isOK()) {
+            return executionResult.getStatus();
+        }
+        querySolution = executionResult.getValue()->solution();
+        root = executionResult.getValue()->root();
     }
-    auto querySolution = executionResult.getValue()->solution();
-    auto root = executionResult.getValue()->root();
 
     invariant(root);
     updateStageParams.canonicalQuery = cq.get();
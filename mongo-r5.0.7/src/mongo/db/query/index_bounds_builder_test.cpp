@@ -34,12 +34,15 @@
 #include <limits>
 #include <memory>
 
+#include "mongo/db/index/expression_params.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/expression_index.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "third_party/s2/s2cellid.h"
+#include "third_party/s2/s2latlng.h"
 
 namespace {
 
@@ -1742,4 +1745,59 @@ TEST_F(IndexBoundsBuilderTest, TranslateInternalExprLTESubObjectContainingBadVal
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
 }
 
+TEST_F(IndexBoundsBuilderTest, S2CellIdsToIntervalsCoalescesSiblingCells) {
+    S2IndexingParams indexParams;
+    ExpressionParams::initialize2dsphereParams(
+        BSON("2dsphereIndexVersion" << S2_INDEX_VERSION_3), nullptr, &indexParams);
+
+    // The ranges of the four children of a cell and the cell itself form a single interval.
+    const S2CellId cell = S2CellId::FromLatLng(S2LatLng::FromDegrees(40.7, -74.0))
+                              .parent(indexParams.coarsestIndexedLevel + 4);
+    std::vector<S2CellId> children;
+    for (S2CellId child = cell.child_begin(); child != cell.child_end(); child = child.next()) {
+        children.push_back(child);
+    }
+
+    OrderedIntervalList oil;
+    ExpressionMapping::S2CellIdsToIntervalsWithParents(children, indexParams, &oil);
+
+    // The other intervals are the points of the coarser ancestors of the cell.
+    ASSERT_LTE(oil.intervals.size(), 5U);
+    const Interval cellRange(BSON("" << static_cast<long long>(cell.range_min().id()) << ""
+                                     << static_cast<long long>(cell.range_max().id())),
+                             true,
+                             true);
+    ASSERT_TRUE(std::any_of(oil.intervals.begin(), oil.intervals.end(), [&](const auto& interval) {
+        return interval.compare(cellRange) == Interval::INTERVAL_EQUALS;
+    }));
+    for (size_t i = 1; i < oil.intervals.size(); ++i) {
+        ASSERT_NE(oil.intervals[i - 1].end.numberLong() + 1, oil.intervals[i].start.numberLong());
+    }
+}
+
+TEST_F(IndexBoundsBuilderTest, TranslateGeoWithinReusesCachedCovering) {
+    BSONObj keyPattern = fromjson("{a: '2dsphere'}");
+    BSONElement elt = keyPattern.firstElement();
+    auto testIndex = buildSimpleIndexEntry(keyPattern);
+    testIndex.infoObj = BSON("2dsphereIndexVersion" << S2_INDEX_VERSION_3);
+    auto expr = parseMatchExpression(
+        fromjson("{a: {$geoWithin: {$geometry: {type: 'Polygon', coordinates: [[[-74.0, 40.7], "
+                 "[-73.9, 40.7], [-73.9, 40.8], [-74.0, 40.8], [-74.0, 40.7]]]}}}}"));
+
+    OrderedIntervalList first;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &first, &tightness);
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
+    ASSERT_TRUE(first.isValidFor(1));
+    ASSERT_FALSE(first.intervals.empty());
+
+    OrderedIntervalList second;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &second, &tightness);
+    ASSERT_EQUALS(second.name, "a");
+    ASSERT_EQUALS(first.intervals.size(), second.intervals.size());
+    for (size_t i = 0; i < first.intervals.size(); ++i) {
+        ASSERT_EQUALS(Interval::INTERVAL_EQUALS, first.intervals[i].compare(second.intervals[i]));
+    }
+}
+
 }  // namespace
@@ -0,0 +1,234 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr auto kKeyPatternField = "keyPattern"_sd;
+constexpr auto kNumRecordsField = "numRecords"_sd;
+constexpr auto kNumKeysField = "numKeys"_sd;
+constexpr auto kNumDistinctField = "numDistinct"_sd;
+constexpr auto kBucketsField = "buckets"_sd;
+constexpr auto kUpperBoundField = "upperBound"_sd;
+constexpr auto kRangeCountField = "rangeCount"_sd;
+constexpr auto kRangeDistinctField = "rangeDistinct"_sd;
+constexpr auto kBoundCountField = "boundCount"_sd;
+
+/**
+ * Returns the estimated fraction of a bucket's range which lies below 'value'. Numeric ranges are
+ * interpolated linearly; for any other type we have no notion of distance and assume that 'value'
+ * splits the range in half.
+ */
+double fractionOfRangeBelow(const BSONElement& lowerBound,
+                            const BSONElement& value,
+                            const BSONElement& upperBound) {
+    if (lowerBound.isNumber() && value.isNumber() && upperBound.isNumber()) {
+        const double lo = lowerBound.numberDouble();
+        const double hi = upperBound.numberDouble();
+        const double fraction = (value.numberDouble() - lo) / (hi - lo);
+        if (hi > lo && !std::isnan(fraction)) {
+            return std::clamp(fraction, 0.0, 1.0);
+        }
+    }
+    return 0.5;
+}
+
+}  // namespace
+
+IndexStatistics::Builder::Builder(long long numKeys, size_t maxBuckets)
+    : _bucketDepth(std::max(1.0,
+                            static_cast<double>(numKeys) /
+                                static_cast<double>(std::max(maxBuckets, size_t{1})))) {}
+
+void IndexStatistics::Builder::addValue(const BSONElement& value) {
+    ++_numKeys;
+    if (_runCount > 0 && _runValue.firstElement().woCompare(value, false) == 0) {
+        ++_runCount;
+        return;
+    }
+
+    flushRun();
+    _runValue = value.wrap("");
+    _runCount = 1;
+    ++_numDistinct;
+}
+
+void IndexStatistics::Builder::flushRun() {
+    if (_runCount == 0) {
+        return;
+    }
+
+    // The smallest value gets a bucket of its own so that the histogram records its lower bound.
+    // After that, a run closes the current bucket once the bucket would reach its target depth.
+    // This makes every sufficiently frequent value a bucket boundary, where its count is exact.
+    if (_buckets.empty() || _current.rangeCount + _runCount >= _bucketDepth) {
+        _current.upperBound = _runValue;
+        _current.boundCount = _runCount;
+        _buckets.push_back(std::move(_current));
+        _current = Bucket();
+    } else {
+        _current.rangeCount += _runCount;
+        _current.rangeDistinct += 1;
+    }
+}
+
+IndexStatistics IndexStatistics::Builder::done(BSONObj keyPattern, long long numRecords) {
+    flushRun();
+
+    // The last value was folded into the range of an unfinished bucket. Make it the bucket's upper
+    // bound instead, so that the histogram covers every value in the index.
+    if (_current.rangeCount > 0) {
+        _current.rangeCount -= _runCount;
+        _current.rangeDistinct -= 1;
+        _current.upperBound = _runValue;
+        _current.boundCount = _runCount;
+        _buckets.push_back(std::move(_current));
+        _current = Bucket();
+    }
+
+    IndexStatistics stats;
+    stats._keyPattern = keyPattern.getOwned();
+    stats._numRecords = numRecords;
+    stats._numKeys = _numKeys;
+    stats._numDistinct = _numDistinct;
+    stats._buckets = std::move(_buckets);
+    return stats;
+}
+
+IndexStatistics IndexStatistics::parse(const BSONObj& obj) {
+    IndexStatistics stats;
+    stats._keyPattern = obj[kKeyPatternField].Obj().getOwned();
+    stats._numRecords = obj[kNumRecordsField].safeNumberLong();
+    stats._numKeys = obj[kNumKeysField].safeNumberLong();
+    stats._numDistinct = obj[kNumDistinctField].safeNumberLong();
+
+    for (auto&& bucketElem : obj[kBucketsField].Obj()) {
+        const auto bucketObj = bucketElem.Obj();
+        const auto upperBound = bucketObj[kUpperBoundField];
+        uassert(6194503,
+                str::stream() << "Index statistics bucket is missing its upper bound: "
+                              << bucketObj,
+                !upperBound.eoo());
+        uassert(6194504,
+                str::stream() << "Index statistics buckets are not in ascending order: " << obj,
+                stats._buckets.empty() ||
+                    stats._buckets.back().upperBound.firstElement().woCompare(upperBound,
+                                                                              false) < 0);
+
+        Bucket bucket;
+        bucket.upperBound = upperBound.wrap("");
+        bucket.rangeCount = bucketObj[kRangeCountField].numberDouble();
+        bucket.rangeDistinct = bucketObj[kRangeDistinctField].numberDouble();
+        bucket.boundCount = bucketObj[kBoundCountField].numberDouble();
+        stats._buckets.push_back(std::move(bucket));
+    }
+    return stats;
+}
+
+BSONObj IndexStatistics::toBSON() const {
+    BSONObjBuilder bob;
+    bob.append(kKeyPatternField, _keyPattern);
+    bob.append(kNumRecordsField, _numRecords);
+    bob.append(kNumKeysField, _numKeys);
+    bob.append(kNumDistinctField, _numDistinct);
+
+    BSONArrayBuilder bucketsBuilder(bob.subarrayStart(kBucketsField));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound.firstElement(), kUpperBoundField);
+        bucketBuilder.append(kRangeCountField, bucket.rangeCount);
+        bucketBuilder.append(kRangeDistinctField, bucket.rangeDistinct);
+        bucketBuilder.append(kBoundCountField, bucket.boundCount);
+    }
+    bucketsBuilder.doneFast();
+    return bob.obj();
+}
+
+double IndexStatistics::estimateKeysBelow(const BSONElement& value, bool inclusive) const {
+    double below = 0;
+    BSONElement lowerBound;
+    for (auto&& bucket : _buckets) {
+        const auto upperBound = bucket.upperBound.firstElement();
+        const int cmp = value.woCompare(upperBound, false);
+        if (cmp > 0) {
+            below += bucket.rangeCount + bucket.boundCount;
+            lowerBound = upperBound;
+            continue;
+        }
+        if (cmp == 0) {
+            return below + bucket.rangeCount + (inclusive ? bucket.boundCount : 0);
+        }
+
+        // 'value' falls strictly inside this bucket's range. Assume the distinct values in the
+        // range are equally frequent.
+        if (bucket.rangeCount > 0) {
+            below += bucket.rangeCount * fractionOfRangeBelow(lowerBound, value, upperBound);
+            if (inclusive) {
+                below += bucket.rangeCount / std::max(bucket.rangeDistinct, 1.0);
+            }
+        }
+        return std::min(below, static_cast<double>(_numKeys));
+    }
+    return below;
+}
+
+double IndexStatistics::estimateKeys(const Interval& interval) const {
+    BSONElement low = interval.start;
+    BSONElement high = interval.end;
+    bool lowInclusive = interval.startInclusive;
+    bool highInclusive = interval.endInclusive;
+    if (low.woCompare(high, false) > 0) {
+        std::swap(low, high);
+        std::swap(lowInclusive, highInclusive);
+    }
+
+    return std::max(0.0,
+                    estimateKeysBelow(high, highInclusive) - estimateKeysBelow(low, !lowInclusive));
+}
+
+double IndexStatistics::estimateKeys(const OrderedIntervalList& oil) const {
+    double keys = 0;
+    for (auto&& interval : oil.intervals) {
+        keys += estimateKeys(interval);
+    }
+    return std::min(keys, static_cast<double>(_numKeys));
+}
+
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_bounds.h"
+
+namespace mongo {
+
+/**
+ * Distribution statistics for the leading field of a btree index, built by the 'analyze' command
+ * and consulted by the plan cost estimator.
+ *
+ * The values are summarized by an equi-depth histogram. Each bucket describes the index keys in
+ * the half-open range (previous bucket's upper bound, upper bound]: 'rangeCount' and
+ * 'rangeDistinct' count the keys and distinct values strictly below the upper bound, and
+ * 'boundCount' counts the keys equal to it. The first bucket always has an empty range, so that
+ * its upper bound is the smallest value in the index.
+ */
+class IndexStatistics {
+public:
+    struct Bucket {
+        // Stored as {"": <value>} so that the bucket owns its bound.
+        BSONObj upperBound;
+        double rangeCount = 0;
+        double rangeDistinct = 0;
+        double boundCount = 0;
+    };
+
+    /**
+     * Builds the statistics for an index from its leading field values, which must be added in
+     * ascending order. 'numKeys' is the total number of keys which will be added and is used to
+     * size the buckets.
+     */
+    class Builder {
+    public:
+        Builder(long long numKeys, size_t maxBuckets);
+
+        void addValue(const BSONElement& value);
+
+        IndexStatistics done(BSONObj keyPattern, long long numRecords);
+
+    private:
+        void flushRun();
+
+        double _bucketDepth;
+        std::vector<Bucket> _buckets;
+        Bucket _current;
+
+        // The run of identical values currently being accumulated.
+        BSONObj _runValue;
+        long long _runCount = 0;
+
+        long long _numKeys = 0;
+        long long _numDistinct = 0;
+    };
+
+    IndexStatistics() = default;
+
+    /**
+     * Parses statistics previously serialized with toBSON(). Throws if 'obj' is malformed.
+     */
+    static IndexStatistics parse(const BSONObj& obj);
+
+    BSONObj toBSON() const;
+
+    /**
+     * Returns the estimated number of keys whose leading field is less than 'value', or less
+     * than or equal to it when 'inclusive' is true.
+     */
+    double estimateKeysBelow(const BSONElement& value, bool inclusive) const;
+
+    /**
+     * Returns the estimated number of keys whose leading field falls within 'interval'. The
+     * interval may be oriented in either direction.
+     */
+    double estimateKeys(const Interval& interval) const;
+
+    /**
+     * Returns the estimated number of keys whose leading field falls within any of the intervals
+     * in 'oil'.
+     */
+    double estimateKeys(const OrderedIntervalList& oil) const;
+
+    const BSONObj& keyPattern() const {
+        return _keyPattern;
+    }
+
+    long long numRecords() const {
+        return _numRecords;
+    }
+
+    long long numKeys() const {
+        return _numKeys;
+    }
+
+    long long numDistinct() const {
+        return _numDistinct;
+    }
+
+    const std::vector<Bucket>& buckets() const {
+        return _buckets;
+    }
+
+private:
+    BSONObj _keyPattern;
+    long long _numRecords = 0;
+    long long _numKeys = 0;
+    long long _numDistinct = 0;
+    std::vector<Bucket> _buckets;
+};
+
+}  // namespace mongo
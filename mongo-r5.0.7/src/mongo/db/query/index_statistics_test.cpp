@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds statistics for an index on {a: 1} holding the values 1 through 100 once each, except for
+ * 50, which appears 'numFifties' times.
+ */
+IndexStatistics buildSkewedStatistics(long long numFifties, size_t maxBuckets) {
+    const long long numKeys = 99 + numFifties;
+    IndexStatistics::Builder builder(numKeys, maxBuckets);
+    for (int value = 1; value <= 100; ++value) {
+        const auto count = value == 50 ? numFifties : 1;
+        for (long long i = 0; i < count; ++i) {
+            builder.addValue(BSON("" << value).firstElement());
+        }
+    }
+    return builder.done(BSON("a" << 1), numKeys);
+}
+
+double estimateInterval(const IndexStatistics& stats,
+                        BSONObj bounds,
+                        bool startInclusive,
+                        bool endInclusive) {
+    return stats.estimateKeys(Interval(bounds, startInclusive, endInclusive));
+}
+
+TEST(IndexStatisticsTest, BuilderCountsKeysAndDistinctValues) {
+    auto stats = buildSkewedStatistics(101, 10);
+    ASSERT_EQ(stats.numKeys(), 200);
+    ASSERT_EQ(stats.numDistinct(), 100);
+    ASSERT_LTE(stats.buckets().size(), 11U);
+
+    // The first bucket records the smallest value and the last one the largest.
+    ASSERT_EQ(stats.buckets().front().upperBound.firstElement().numberInt(), 1);
+    ASSERT_EQ(stats.buckets().front().rangeCount, 0);
+    ASSERT_EQ(stats.buckets().back().upperBound.firstElement().numberInt(), 100);
+}
+
+TEST(IndexStatisticsTest, FrequentValueIsEstimatedExactly) {
+    auto stats = buildSkewedStatistics(101, 10);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << 50 << "" << 50), true, true), 101);
+}
+
+TEST(IndexStatisticsTest, RareValueIsEstimatedFromItsBucket) {
+    auto stats = buildSkewedStatistics(101, 10);
+    const double estimate = estimateInterval(stats, BSON("" << 10 << "" << 10), true, true);
+    ASSERT_GT(estimate, 0.5);
+    ASSERT_LT(estimate, 2);
+}
+
+TEST(IndexStatisticsTest, ValuesOutsideTheHistogramAreEstimatedAsAbsent) {
+    auto stats = buildSkewedStatistics(101, 10);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << 1000 << "" << 1000), true, true), 0);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << -5 << "" << 0), true, true), 0);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << 100 << "" << 200), false, true), 0);
+}
+
+TEST(IndexStatisticsTest, RangesAreInterpolatedWithinBuckets) {
+    auto stats = buildSkewedStatistics(101, 10);
+    const double estimate = estimateInterval(stats, BSON("" << 0 << "" << 10), false, true);
+    ASSERT_GT(estimate, 8);
+    ASSERT_LT(estimate, 12);
+}
+
+TEST(IndexStatisticsTest, FullRangeCoversEveryKey) {
+    auto stats = buildSkewedStatistics(101, 10);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << MINKEY << "" << MAXKEY), true, true), 200);
+}
+
+TEST(IndexStatisticsTest, DescendingIntervalsMatchAscendingOnes) {
+    auto stats = buildSkewedStatistics(101, 10);
+    ASSERT_EQ(estimateInterval(stats, BSON("" << 60 << "" << 20), true, false),
+              estimateInterval(stats, BSON("" << 20 << "" << 60), false, true));
+}
+
+TEST(IndexStatisticsTest, RoundTripsThroughBSON) {
+    auto stats = buildSkewedStatistics(101, 10);
+    auto parsed = IndexStatistics::parse(stats.toBSON());
+    ASSERT_BSONOBJ_EQ(parsed.toBSON(), stats.toBSON());
+    ASSERT_EQ(estimateInterval(parsed, BSON("" << 0 << "" << 10), false, true),
+              estimateInterval(stats, BSON("" << 0 << "" << 10), false, true));
+}
+
+TEST(IndexStatisticsTest, ParseRejectsUnorderedBuckets) {
+    auto obj = BSON("keyPattern" << BSON("a" << 1) << "numRecords" << 2 << "numKeys" << 2
+                                 << "numDistinct" << 2 << "buckets"
+                                 << BSON_ARRAY(BSON("upperBound" << 5 << "rangeCount" << 0
+                                                                 << "rangeDistinct" << 0
+                                                                 << "boundCount" << 1)
+                                               << BSON("upperBound" << 1 << "rangeCount" << 0
+                                                                    << "rangeDistinct" << 0
+                                                                    << "boundCount" << 1)));
+    ASSERT_THROWS_CODE(IndexStatistics::parse(obj), DBException, 6194504);
+}
+
+}  // namespace
+}  // namespace mongo
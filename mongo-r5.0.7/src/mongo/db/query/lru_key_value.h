@@ -141,19 +141,39 @@ public:
             return Status(ErrorCodes::NoSuchKey, "no such key in LRU key-value store");
         }
         KVListIt found = i->second;
-        V* foundEntry = found->second;
 
         // Promote the kv-store entry to the front of the list.
-        // It is now the most recently used.
-        _kvMap.erase(i);
-        _kvList.erase(found);
-        _kvList.push_front(std::make_pair(key, foundEntry));
-        _kvMap[key] = _kvList.begin();
+        // It is now the most recently used. Splicing keeps the map's iterator valid, so neither
+        // the key nor the map entry needs to be copied.
+        _kvList.splice(_kvList.begin(), _kvList, found);
 
-        *entryOut = foundEntry;
+        *entryOut = found->second;
         return Status::OK();
     }
 
+    /**
+     * Returns the least recently used value without promoting it, or nullptr if the kv-store is
+     * empty. The kv-store retains ownership of the value.
+     */
+    const V* peekLeastRecentlyUsed() const {
+        return _kvList.empty() ? nullptr : _kvList.back().second;
+    }
+
+    /**
+     * Removes the least recently used entry, passing ownership of its value to the caller.
+     * Returns nullptr if the kv-store is empty.
+     */
+    std::unique_ptr<V> removeLeastRecentlyUsed() {
+        if (_kvList.empty()) {
+            return nullptr;
+        }
+        std::unique_ptr<V> evictedEntry(_kvList.back().second);
+        _kvMap.erase(_kvList.back().first);
+        _kvList.pop_back();
+        _currentSize--;
+        return evictedEntry;
+    }
+
     /**
      * Remove the kv-store entry keyed by 'key'.
      */
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <math.h>
 #include <memory>
+#include <queue>
 #include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -52,6 +53,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
@@ -63,6 +65,34 @@ namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
 
+// Number of entries evicted because the plan caches exceeded their combined size budget.
+Counter64 planCacheTotalSizeBudgetEvictions;
+ServerStatusMetricField<Counter64> planCacheTotalSizeBudgetEvictionsMetric(
+    "query.planCacheTotalSizeBudgetEvictions", &planCacheTotalSizeBudgetEvictions);
+
+// A cache is only partitioned once each partition can hold at least this many entries, so that
+// small caches keep an exact LRU policy.
+const size_t kMinEntriesPerPartition = 64;
+const size_t kMaxPartitions = 16;
+
+// Once the combined size budget is exceeded, entries are evicted until the plan caches are back
+// below this fraction of the budget, so that a full cache does not evict on every insertion.
+const double kTotalSizeBudgetLowWaterMark = 0.9;
+
+/**
+ * The plan caches of all collections, so that the combined size budget can be enforced across
+ * them. Lock ordering: the registry mutex is acquired before any partition mutex.
+ */
+struct PlanCacheRegistry {
+    Mutex mutex = MONGO_MAKE_LATCH("PlanCacheRegistry::mutex");
+    stdx::unordered_set<PlanCache*> caches;
+};
+
+PlanCacheRegistry& getPlanCacheRegistry() {
+    static auto registry = new PlanCacheRegistry();
+    return *registry;
+}
+
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
@@ -419,6 +449,10 @@ std::string SolutionCacheData::toString() const {
                                  << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(index skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case USE_INDEX_TAGS_SOLN:
             verify(this->tree.get());
             return str::stream() << "(index-tagged expression tree: "
@@ -433,9 +467,82 @@ std::string SolutionCacheData::toString() const {
 
 PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size) {
+    const size_t numPartitions =
+        std::max<size_t>(1, std::min(size / kMinEntriesPerPartition, kMaxPartitions));
+    const size_t entriesPerPartition = (size + numPartitions - 1) / numPartitions;
+    _partitions.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+        _partitions.push_back(std::make_unique<Partition>(entriesPerPartition));
+    }
+
+    auto& registry = getPlanCacheRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+    registry.caches.insert(this);
+}
+
+PlanCache::~PlanCache() {
+    auto& registry = getPlanCacheRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+    registry.caches.erase(this);
+}
 
-PlanCache::~PlanCache() {}
+PlanCache::Partition& PlanCache::getPartition(const PlanCacheKey& key) const {
+    return *_partitions[PlanCacheKeyHasher{}(key) % _partitions.size()];
+}
+
+void PlanCache::enforceTotalSizeBudget() {
+    const long long budget = internalQueryCacheMaxTotalSizeBytes.load();
+    if (budget == 0 || PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() <= budget) {
+        return;
+    }
+    const auto lowWaterMark = static_cast<long long>(budget * kTotalSizeBudgetLowWaterMark);
+
+    auto& registry = getPlanCacheRegistry();
+    stdx::lock_guard<Latch> registryLock(registry.mutex);
+
+    // Repeatedly evict from the partition whose least recently used entry is the oldest. The
+    // partitions are not locked in between evictions, so this is only an approximation of a
+    // global LRU policy.
+    using Candidate = std::pair<Date_t, Partition*>;
+    auto newerThan = [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.first > rhs.first;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(newerThan)> candidates(
+        newerThan);
+    auto addCandidate = [&](Partition* partition) {
+        stdx::lock_guard<Latch> partitionLock(partition->mutex);
+        if (auto entry = partition->cache.peekLeastRecentlyUsed()) {
+            candidates.emplace(entry->lastUsed, partition);
+        }
+    };
+    for (auto&& cache : registry.caches) {
+        for (auto&& partition : cache->_partitions) {
+            addCandidate(partition.get());
+        }
+    }
+
+    while (!candidates.empty() &&
+           PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() > lowWaterMark) {
+        auto partition = candidates.top().second;
+        candidates.pop();
+
+        std::unique_ptr<PlanCacheEntry> evictedEntry;
+        {
+            stdx::lock_guard<Latch> partitionLock(partition->mutex);
+            evictedEntry = partition->cache.removeLeastRecentlyUsed();
+        }
+        if (evictedEntry) {
+            planCacheTotalSizeBudgetEvictions.increment();
+            LOGV2_DEBUG(6194508,
+                        1,
+                        "Plan cache total size budget exceeded - removed least recently used entry",
+                        "budgetBytes"_attr = budget,
+                        "evictedEntry"_attr = redact(evictedEntry->debugString()));
+        }
+        addCandidate(partition);
+    }
+}
 
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
     PlanCache::GetResult res = get(key);
@@ -586,7 +693,8 @@ Status PlanCache::set(const CanonicalQuery& query,
                                              }},
                     why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::unique_lock<Latch> partitionLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -597,7 +705,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -624,7 +732,9 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    newEntry->lastUsed = now;
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, newEntry.release());
+    partitionLock.unlock();
 
     if (nullptr != evictedEntry.get()) {
         LOGV2_DEBUG(20942,
@@ -634,6 +744,7 @@ Status PlanCache::set(const CanonicalQuery& query,
                     "evictedEntry"_attr = redact(evictedEntry->debugString()));
     }
 
+    enforceTotalSizeBudget();
     return Status::OK();
 }
 
@@ -644,9 +755,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> partitionLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -661,14 +773,16 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> partitionLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return {CacheEntryState::kNotPresent, nullptr};
     }
     invariant(entry);
+    entry->lastUsed = Date_t::now();
 
     auto state =
         entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
@@ -676,13 +790,17 @@ PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const auto key = computeKey(canonicalQuery);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> partitionLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> partitionLock(partition->mutex);
+        partition->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -698,9 +816,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = getPartition(key);
+    stdx::lock_guard<Latch> partitionLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -710,20 +829,26 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> partitionLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> partitionLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -734,13 +859,15 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> partitionLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
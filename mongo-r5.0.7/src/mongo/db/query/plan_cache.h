@@ -260,6 +260,10 @@ struct SolutionCacheData {
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
+        // The cached plan skip-scans the index stored in 'tree' over the
+        // bounds of the query's predicates on its second field.
+        SKIP_SCAN_SOLN,
+
         // Build the solution by using 'tree'
         // to tag the match expression.
         USE_INDEX_TAGS_SOLN
@@ -414,6 +418,13 @@ public:
     // turn own, and so on.
     const uint64_t estimatedEntrySizeBytes;
 
+    // When the entry was last added or looked up. Used to evict the least recently used entries
+    // across collections once the plan caches exceed their combined size budget. This is a wall
+    // clock time rather than a shared counter, so that lookups in different partitions do not
+    // contend on it, and entries used within the same millisecond are evicted in any order.
+    // Protected by the owning partition's mutex.
+    Date_t lastUsed;
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -488,6 +499,11 @@ public:
      */
     PlanCache();
 
+    /**
+     * Creates a cache holding at most 'size' entries. Large caches are split into independently
+     * locked partitions by key hash, each holding an equal share of the entries and applying the
+     * LRU policy on its own.
+     */
     PlanCache(size_t size);
 
     ~PlanCache();
@@ -613,10 +629,29 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * A slice of the cache's entries, selected by key hash, so that lookups of different query
+     * shapes do not contend on a single mutex.
+     */
+    struct Partition {
+        explicit Partition(size_t maxEntries) : cache(maxEntries) {}
+
+        // Protects 'cache'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+    };
+
+    Partition& getPartition(const PlanCacheKey& key) const;
+
+    /**
+     * Evicts the least recently used entries across the plan caches of all collections until
+     * their combined size is back within 'internalQueryCacheMaxTotalSizeBytes'. Must be called
+     * without holding any partition's mutex.
+     */
+    static void enforceTotalSizeBudget();
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
@@ -1294,6 +1294,18 @@ TEST_F(CachePlanSelectionTest, EqualityIndexScanWithTrailingFields) {
         BSON("x" << 5), "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1}}}}}");
 }
 
+TEST_F(CachePlanSelectionTest, IndexSkipScan) {
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableIndexSkipScan",
+                                                    true};
+    addIndex(BSON("x" << 1 << "y" << 1), "x_1_y_1");
+    runQuery(BSON("y" << 5));
+
+    assertPlanCacheRecoversSolution(
+        BSON("y" << 5),
+        "{fetch: {filter: {y: 5}, node: {ixscan: {pattern: {x: 1, y: 1}, bounds: "
+        "{x: [['MinKey','MaxKey',true,true]], y: [[5,5,true,true]]}}}}}");
+}
+
 //
 // Geo
 //
@@ -2514,6 +2526,56 @@ TEST(PlanCacheTest, PlanCacheSizeWithMultiplePlanCaches) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheRespectsMaxEntries) {
+    // Large enough to be split into several partitions.
+    const size_t kCacheSize = 256;
+    PlanCache planCache(kCacheSize);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    unique_ptr<CanonicalQuery> lastQuery;
+    for (size_t i = 0; i < 2 * kCacheSize; ++i) {
+        lastQuery = canonicalize(BSON(("a" + std::to_string(i)) << 1));
+        ASSERT_OK(planCache.set(*lastQuery, solns, createDecision(1U), Date_t{}));
+        ASSERT_LTE(planCache.size(), kCacheSize);
+    }
+
+    // The most recently added entry is never the one evicted from its partition.
+    ASSERT_NE(planCache.get(*lastQuery).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.getAllEntries().size(), planCache.size());
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
+TEST(PlanCacheTest, TotalSizeBudgetEvictsLeastRecentlyUsedEntryAcrossPlanCaches) {
+    PlanCache planCache1;
+    PlanCache planCache2;
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+
+    long long previousSize = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get();
+    ASSERT_OK(planCache1.set(*cqA, solns, createDecision(1U), Date_t{}));
+    const long long entrySize =
+        PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() - previousSize;
+    ASSERT_OK(planCache2.set(*cqB, solns, createDecision(1U), Date_t{}));
+
+    // Looking up 'cqA' makes the entry for 'cqB' the least recently used one.
+    ASSERT_NE(planCache1.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
+
+    // Leave room for half an entry, so that the next insertion exceeds the budget.
+    const long long budget = PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() + entrySize / 2;
+    RAIIServerParameterControllerForTest controller{"internalQueryCacheMaxTotalSizeBytes", budget};
+
+    ASSERT_OK(planCache1.set(*cqC, solns, createDecision(1U), Date_t{}));
+    ASSERT_LTE(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), budget);
+    ASSERT_EQ(planCache2.get(*cqB).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_NE(planCache1.get(*cqC).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
 TEST(PlanCacheTest, DifferentQueryEngines) {
     // Helper to construct a plan cache key given the 'enableSlotBasedExecutionEngine' flag.
     auto constructPlanCacheKey = [](const PlanCache& pc,
@@ -0,0 +1,314 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo {
+namespace plan_cost_estimator {
+
+namespace {
+
+// Relative costs of the units of work done by a plan. An index key read is the unit; fetching a
+// document by RecordId costs a random read into the collection, whereas a collection scan reads
+// documents sequentially.
+constexpr double kIndexKeyCost = 1.0;
+constexpr double kIndexSeekCost = 10.0;
+constexpr double kFetchCost = 10.0;
+constexpr double kCollScanDocumentCost = 2.0;
+constexpr double kSortComparisonCost = 0.5;
+constexpr double kPerResultCost = 0.1;
+
+// Selectivities assumed for predicates which are not answered by the histograms.
+constexpr double kEqualitySelectivity = 0.1;
+constexpr double kRangeSelectivity = 0.3;
+constexpr double kDefaultSelectivity = 0.5;
+
+struct NodeEstimate {
+    double cost = 0;
+
+    // The estimated number of results produced by the node.
+    double outputs = 0;
+
+    // Whether the subtree must consume all of its input before it can return results, in which
+    // case a limit above it does not shorten its work.
+    bool blocking = false;
+};
+
+/**
+ * Returns the fraction of the keys matching the leading field's bounds which also match the
+ * bounds on the remaining fields of the index. The histograms only describe the leading field, so
+ * these use the default selectivities.
+ */
+double trailingBoundsSelectivity(const IndexBounds& bounds) {
+    double selectivity = 1.0;
+    for (size_t i = 1; i < bounds.fields.size(); ++i) {
+        const auto& intervals = bounds.fields[i].intervals;
+        if (intervals.size() == 1 && (intervals[0].isMinToMax() || intervals[0].isMaxToMin())) {
+            continue;
+        }
+
+        const bool allPoints =
+            std::all_of(intervals.begin(), intervals.end(), [](const Interval& interval) {
+                return interval.isPoint();
+            });
+        selectivity *= allPoints ? std::min(1.0, intervals.size() * kEqualitySelectivity)
+                                 : kRangeSelectivity;
+    }
+    return selectivity;
+}
+
+boost::optional<NodeEstimate> estimateNode(const QuerySolutionNode* node,
+                                           double numRecords,
+                                           const IndexStatisticsLookupFn& lookupStats) {
+    std::vector<NodeEstimate> children;
+    for (auto&& child : node->children) {
+        auto childEstimate = estimateNode(child, numRecords, lookupStats);
+        if (!childEstimate) {
+            return boost::none;
+        }
+        children.push_back(*childEstimate);
+    }
+
+    NodeEstimate estimate;
+    switch (node->getType()) {
+        case STAGE_COLLSCAN: {
+            estimate.cost = numRecords * kCollScanDocumentCost;
+            estimate.outputs = numRecords * estimateSelectivity(node->filter.get());
+            return estimate;
+        }
+        case STAGE_IXSCAN: {
+            const auto ixn = static_cast<const IndexScanNode*>(node);
+            if (ixn->index.type != INDEX_BTREE) {
+                return boost::none;
+            }
+            const auto stats = lookupStats(ixn->index);
+            if (!stats) {
+                return boost::none;
+            }
+
+            double keys = stats->numKeys();
+            double seeks = 1;
+            if (!ixn->bounds.isSimpleRange && !ixn->bounds.fields.empty()) {
+                const auto& leadingIntervals = ixn->bounds.fields[0].intervals;
+                const double trailingSelectivity = trailingBoundsSelectivity(ixn->bounds);
+                keys = stats->estimateKeys(ixn->bounds.fields[0]) * trailingSelectivity;
+                seeks = std::max<size_t>(leadingIntervals.size(), 1);
+
+                // A skip scan seeks past the out-of-bounds keys of each distinct leading value.
+                if (leadingIntervals.size() == 1 &&
+                    (leadingIntervals[0].isMinToMax() || leadingIntervals[0].isMaxToMin()) &&
+                    trailingSelectivity < 1.0) {
+                    seeks = std::max<long long>(stats->numDistinct(), 1);
+                }
+            }
+
+            // Scale the estimate by the growth or shrinkage of the collection since the statistics
+            // were gathered.
+            if (stats->numRecords() > 0) {
+                keys *= numRecords / stats->numRecords();
+            }
+
+            estimate.cost = keys * kIndexKeyCost + seeks * kIndexSeekCost;
+            estimate.outputs = keys * estimateSelectivity(node->filter.get());
+            return estimate;
+        }
+        case STAGE_FETCH: {
+            estimate = children[0];
+            estimate.cost += estimate.outputs * kFetchCost;
+            estimate.outputs *= estimateSelectivity(node->filter.get());
+            return estimate;
+        }
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_SIMPLE: {
+            const auto sn = static_cast<const SortNode*>(node);
+            estimate = children[0];
+            const double n = estimate.outputs;
+            estimate.cost += n * std::log2(std::max(n, 2.0)) * kSortComparisonCost;
+            if (sn->limit > 0) {
+                estimate.outputs = std::min(n, static_cast<double>(sn->limit));
+            }
+            estimate.blocking = true;
+            return estimate;
+        }
+        case STAGE_LIMIT: {
+            const auto ln = static_cast<const LimitNode*>(node);
+            estimate = children[0];
+            const double limit = ln->limit;
+            if (estimate.outputs > limit) {
+                // A streaming plan stops as soon as it has produced enough results.
+                if (!estimate.blocking) {
+                    estimate.cost *= limit / estimate.outputs;
+                }
+                estimate.outputs = limit;
+            }
+            return estimate;
+        }
+        case STAGE_SKIP: {
+            const auto sn = static_cast<const SkipNode*>(node);
+            estimate = children[0];
+            estimate.outputs = std::max(0.0, estimate.outputs - sn->skip);
+            return estimate;
+        }
+        case STAGE_OR:
+        case STAGE_SORT_MERGE: {
+            for (auto&& child : children) {
+                estimate.cost += child.cost;
+                estimate.outputs += child.outputs;
+                estimate.blocking = estimate.blocking || child.blocking;
+            }
+            estimate.outputs = std::min(estimate.outputs, numRecords) *
+                estimateSelectivity(node->filter.get());
+            return estimate;
+        }
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            // Assume the children's predicates are independent, so the fraction of the collection
+            // surviving the intersection is the product of the fractions produced by each child.
+            estimate.outputs = numRecords;
+            for (auto&& child : children) {
+                estimate.cost += child.cost;
+                estimate.outputs *= numRecords > 0 ? std::min(child.outputs / numRecords, 1.0) : 0;
+                estimate.blocking = estimate.blocking || child.blocking;
+            }
+            estimate.outputs *= estimateSelectivity(node->filter.get());
+
+            // A hash intersection must read all but its last child before producing any results,
+            // whereas a sort-merge intersection of RecordId-ordered streams returns each match as
+            // soon as every child reaches it.
+            if (node->getType() == STAGE_AND_HASH) {
+                estimate.blocking = true;
+            }
+            return estimate;
+        }
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_RETURN_KEY:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SORT_KEY_GENERATOR: {
+            estimate = children[0];
+            estimate.cost += estimate.outputs * kPerResultCost;
+            return estimate;
+        }
+        case STAGE_EOF:
+            return estimate;
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+boost::optional<double> estimateCost(const QuerySolution& solution,
+                                     double numRecords,
+                                     const IndexStatisticsLookupFn& lookupStats) {
+    if (!solution.root()) {
+        return boost::none;
+    }
+    auto estimate = estimateNode(solution.root(), numRecords, lookupStats);
+    if (!estimate) {
+        return boost::none;
+    }
+    return estimate->cost;
+}
+
+boost::optional<size_t> pickLowestCost(const std::vector<std::unique_ptr<QuerySolution>>& solutions,
+                                       double numRecords,
+                                       const IndexStatisticsLookupFn& lookupStats) {
+    boost::optional<size_t> best;
+    double bestCost = 0;
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        auto cost = estimateCost(*solutions[i], numRecords, lookupStats);
+        if (!cost) {
+            return boost::none;
+        }
+        // Ties go to the earlier candidate, as they do when the plans are ranked by running them.
+        if (!best || *cost < bestCost) {
+            best = i;
+            bestCost = *cost;
+        }
+    }
+    return best;
+}
+
+double estimateSelectivity(const MatchExpression* expr) {
+    if (!expr) {
+        return 1.0;
+    }
+
+    switch (expr->matchType()) {
+        case MatchExpression::AND: {
+            double selectivity = 1.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity *= estimateSelectivity(expr->getChild(i));
+            }
+            return selectivity;
+        }
+        case MatchExpression::OR: {
+            double selectivity = 0.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity += estimateSelectivity(expr->getChild(i));
+            }
+            return std::min(selectivity, 1.0);
+        }
+        case MatchExpression::NOR: {
+            double selectivity = 1.0;
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                selectivity *= 1.0 - estimateSelectivity(expr->getChild(i));
+            }
+            return selectivity;
+        }
+        case MatchExpression::NOT:
+            return 1.0 - estimateSelectivity(expr->getChild(0));
+        case MatchExpression::EQ:
+            return kEqualitySelectivity;
+        case MatchExpression::MATCH_IN: {
+            const auto in = static_cast<const InMatchExpression*>(expr);
+            const auto numAlternatives = in->getEqualities().size() + in->getRegexes().size();
+            return std::min(1.0, numAlternatives * kEqualitySelectivity);
+        }
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return kRangeSelectivity;
+        default:
+            return kDefaultSelectivity;
+    }
+}
+
+}  // namespace plan_cost_estimator
+}  // namespace mongo
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+namespace plan_cost_estimator {
+
+/**
+ * Returns the statistics gathered for the given index, or nullptr if there are none.
+ */
+using IndexStatisticsLookupFn = std::function<const IndexStatistics*(const IndexEntry&)>;
+
+/**
+ * Estimates the cost of executing 'solution' against a collection which currently holds
+ * 'numRecords' documents. Costs are in abstract units proportional to the work done by the plan,
+ * with document fetches weighing more than index key reads. Returns boost::none if the plan scans
+ * an index without statistics or contains a stage which the cost model does not cover.
+ */
+boost::optional<double> estimateCost(const QuerySolution& solution,
+                                     double numRecords,
+                                     const IndexStatisticsLookupFn& lookupStats);
+
+/**
+ * Returns the position in 'solutions' of the plan with the lowest estimated cost, or boost::none
+ * if any of the candidates cannot be costed, in which case the caller should fall back to ranking
+ * the plans by running them.
+ */
+boost::optional<size_t> pickLowestCost(const std::vector<std::unique_ptr<QuerySolution>>& solutions,
+                                       double numRecords,
+                                       const IndexStatisticsLookupFn& lookupStats);
+
+/**
+ * Returns the estimated fraction of documents which match 'expr'. A null 'expr' matches
+ * everything.
+ */
+double estimateSelectivity(const MatchExpression* expr);
+
+}  // namespace plan_cost_estimator
+}  // namespace mongo
@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include <memory>
+
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kNumRecords = 1000;
+
+IndexEntry buildSimpleIndexEntry(const BSONObj& kp, const std::string& indexName) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            false,
+            CoreIndexInfo::Identifier(indexName),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Statistics for an index on {a: 1} over 1000 documents with the distinct values 0 through 999.
+ */
+IndexStatistics buildUniformStatistics() {
+    IndexStatistics::Builder builder(kNumRecords, 100);
+    for (int value = 0; value < kNumRecords; ++value) {
+        builder.addValue(BSON("" << value).firstElement());
+    }
+    return builder.done(BSON("a" << 1), kNumRecords);
+}
+
+std::unique_ptr<QuerySolution> makeCollScanSolution() {
+    auto soln = std::make_unique<QuerySolution>();
+    soln->setRoot(std::make_unique<CollectionScanNode>());
+    return soln;
+}
+
+/**
+ * Makes a FETCH over an IXSCAN of {a: 1} with the given bounds, optionally under a LIMIT.
+ */
+std::unique_ptr<QuerySolution> makeIndexScanSolution(BSONObj bounds, long long limit = 0) {
+    auto ixscan = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON("a" << 1), "a_1"));
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(Interval(bounds, true, true));
+    ixscan->bounds.fields.push_back(oil);
+
+    std::unique_ptr<QuerySolutionNode> root = std::make_unique<FetchNode>(std::move(ixscan));
+    if (limit > 0) {
+        auto limitNode = std::make_unique<LimitNode>();
+        limitNode->limit = limit;
+        limitNode->children.push_back(root.release());
+        root = std::move(limitNode);
+    }
+
+    auto soln = std::make_unique<QuerySolution>();
+    soln->setRoot(std::move(root));
+    return soln;
+}
+
+/**
+ * Makes a LIMIT over a FETCH of an intersection of two overlapping scans of {a: 1} which each
+ * match half of the collection, as either an AND_SORTED or an AND_HASH.
+ */
+std::unique_ptr<QuerySolution> makeIntersectionSolution(bool sorted, long long limit) {
+    std::unique_ptr<QuerySolutionNode> andNode;
+    if (sorted) {
+        andNode = std::make_unique<AndSortedNode>();
+    } else {
+        andNode = std::make_unique<AndHashNode>();
+    }
+    for (int start : {0, 250}) {
+        auto ixscan =
+            std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON("a" << 1), "a_1"));
+        OrderedIntervalList oil("a");
+        oil.intervals.push_back(Interval(BSON("" << start << "" << start + 499), true, true));
+        ixscan->bounds.fields.push_back(oil);
+        andNode->children.push_back(ixscan.release());
+    }
+
+    auto limitNode = std::make_unique<LimitNode>();
+    limitNode->limit = limit;
+    limitNode->children.push_back(new FetchNode(std::move(andNode)));
+
+    auto soln = std::make_unique<QuerySolution>();
+    soln->setRoot(std::move(limitNode));
+    return soln;
+}
+
+class PlanCostEstimatorTest : public unittest::Test {
+protected:
+    plan_cost_estimator::IndexStatisticsLookupFn lookup() const {
+        return [this](const IndexEntry& index) -> const IndexStatistics* {
+            return index.identifier.catalogName == "a_1" ? &_stats : nullptr;
+        };
+    }
+
+    IndexStatistics _stats = buildUniformStatistics();
+};
+
+TEST_F(PlanCostEstimatorTest, SelectiveIndexScanBeatsCollectionScan) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeCollScanSolution());
+    solutions.push_back(makeIndexScanSolution(BSON("" << 5 << "" << 5)));
+
+    auto best = plan_cost_estimator::pickLowestCost(solutions, kNumRecords, lookup());
+    ASSERT(best);
+    ASSERT_EQ(*best, 1U);
+}
+
+TEST_F(PlanCostEstimatorTest, CollectionScanBeatsFetchingEveryDocumentThroughAnIndex) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeIndexScanSolution(BSON("" << MINKEY << "" << MAXKEY)));
+    solutions.push_back(makeCollScanSolution());
+
+    auto best = plan_cost_estimator::pickLowestCost(solutions, kNumRecords, lookup());
+    ASSERT(best);
+    ASSERT_EQ(*best, 1U);
+}
+
+TEST_F(PlanCostEstimatorTest, LimitShortensStreamingPlans) {
+    auto bounds = BSON("" << MINKEY << "" << MAXKEY);
+    auto unlimited =
+        plan_cost_estimator::estimateCost(*makeIndexScanSolution(bounds), kNumRecords, lookup());
+    auto limited = plan_cost_estimator::estimateCost(
+        *makeIndexScanSolution(bounds, 10), kNumRecords, lookup());
+    ASSERT(unlimited);
+    ASSERT(limited);
+    ASSERT_LT(*limited * 10, *unlimited);
+}
+
+TEST_F(PlanCostEstimatorTest, PlansScanningIndexesWithoutStatisticsAreNotCosted) {
+    auto ixscan = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON("b" << 1), "b_1"));
+    auto soln = std::make_unique<QuerySolution>();
+    soln->setRoot(std::make_unique<FetchNode>(std::move(ixscan)));
+
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeIndexScanSolution(BSON("" << 5 << "" << 5)));
+    solutions.push_back(std::move(soln));
+    ASSERT_FALSE(plan_cost_estimator::pickLowestCost(solutions, kNumRecords, lookup()));
+}
+
+TEST_F(PlanCostEstimatorTest, LimitShortensSortMergeIntersectionButNotHashIntersection) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeIntersectionSolution(false /* sorted */, 1));
+    solutions.push_back(makeIntersectionSolution(true /* sorted */, 1));
+
+    auto best = plan_cost_estimator::pickLowestCost(solutions, kNumRecords, lookup());
+    ASSERT(best);
+    ASSERT_EQ(*best, 1U);
+}
+
+TEST(PlanCostEstimatorSelectivityTest, ConjunctionMultipliesSelectivities) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = uassertStatusOK(
+        MatchExpressionParser::parse(BSON("a" << 1 << "b" << BSON("$gt" << 1)), expCtx));
+    ASSERT_APPROX_EQUAL(plan_cost_estimator::estimateSelectivity(expr.get()), 0.03, 1e-9);
+    ASSERT_EQ(plan_cost_estimator::estimateSelectivity(nullptr), 1.0);
+}
+
+}  // namespace
+}  // namespace mongo
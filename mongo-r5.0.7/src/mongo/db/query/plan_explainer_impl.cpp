@@ -252,6 +252,7 @@ void statsToBSON(const PlanStageStats& stats,
                 bob->appendNumber(std::string(str::stream() << "failedAnd_" << i),
                                   static_cast<long long>(spec->failedAnd[i]));
             }
+            bob->appendNumber("seeksToTarget", static_cast<long long>(spec->seeksToTarget));
         }
     } else if (STAGE_COLLSCAN == stats.stageType) {
         CollectionScanStats* spec = static_cast<CollectionScanStats*>(stats.specific.get());
@@ -401,6 +402,10 @@ void statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("seeks", static_cast<long long>(spec->seeks));
             bob->appendNumber("dupsTested", static_cast<long long>(spec->dupsTested));
             bob->appendNumber("dupsDropped", static_cast<long long>(spec->dupsDropped));
+            if (spec->keysSkippedByTopKBound > 0) {
+                bob->appendNumber("keysSkippedByTopKBound",
+                                  static_cast<long long>(spec->keysSkippedByTopKBound));
+            }
         }
     } else if (STAGE_OR == stats.stageType) {
         OrStats* spec = static_cast<OrStats*>(stats.specific.get());
@@ -478,8 +483,17 @@ void statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_TEXT_OR == stats.stageType) {
         TextOrStats* spec = static_cast<TextOrStats*>(stats.specific.get());
 
+        if (spec->limit) {
+            bob->appendNumber("limitAmount", static_cast<long long>(spec->limit));
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", static_cast<long long>(spec->fetches));
+            if (spec->limit) {
+                bob->appendBool("stoppedEarly", spec->stoppedEarly);
+            }
+            bob->appendNumber("docsRejectedByPhrase",
+                              static_cast<long long>(spec->docsRejectedByPhrase));
         }
     } else if (STAGE_UNPACK_TIMESERIES_BUCKET == stats.stageType) {
         UnpackTimeseriesBucketStats* spec =
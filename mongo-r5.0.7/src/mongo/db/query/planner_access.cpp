@@ -48,6 +48,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
@@ -630,16 +631,63 @@ void buildTextSubPlan(TextMatchNode* tn) {
         return;
     }
 
-    // If the query requires the "textScore" field or involves multiple search terms, a TEXT_OR or
-    // OR stage is needed. Otherwise, we can use a single index scan directly.
-    const bool needOrStage = tn->wantTextScore || query->getTermsForBounds().size() > 1;
-
     tassert(5432208,
             "failed to obtain text index version",
             tn->index.infoObj.hasField("textIndexVersion"));
     const auto textIndexVersion =
         static_cast<fts::TextIndexVersion>(tn->index.infoObj["textIndexVersion"].numberInt());
 
+    // Text indexes that store term positions let the TEXT_OR stage check the positive phrases of
+    // the query from the index, before fetching any document. Each term of each phrase gets a scan
+    // of its positions. Positions are only stored for the documents written entirely in the
+    // default language of the index, and can only be compared with the terms of queries in that
+    // language. The scans of positions are therefore preceded by a scan of the documents with
+    // strings in other languages, which are never rejected.
+    std::vector<std::unique_ptr<QuerySolutionNode>> phraseScanList;
+    std::vector<fts::PhraseTermPosition> phraseTermScans;
+    const auto& phrases = query->getPositivePhraseTerms();
+    if (textIndexVersion >= fts::TEXT_INDEX_VERSION_4 && !phrases.empty() &&
+        &fts::FTSLanguage::make(query->getLanguage(), textIndexVersion) ==
+            &fts::FTSSpec(tn->index.infoObj).defaultLanguage()) {
+        for (size_t phrase = 0; phrase < phrases.size(); ++phrase) {
+            for (const auto& phraseTerm : phrases[phrase]) {
+                auto ixscan = std::make_unique<IndexScanNode>(tn->index);
+                ixscan->bounds.startKey = fts::FTSIndexFormat::getPositionIndexKey(
+                    0, phraseTerm.term, tn->indexPrefix, textIndexVersion);
+                ixscan->bounds.endKey = fts::FTSIndexFormat::getPositionIndexKey(
+                    static_cast<size_t>(fts::MAX_WEIGHT),
+                    phraseTerm.term,
+                    tn->indexPrefix,
+                    textIndexVersion);
+                ixscan->bounds.boundInclusion = BoundInclusion::kIncludeBothStartAndEndKeys;
+                ixscan->bounds.isSimpleRange = true;
+                ixscan->direction = 1;
+                // A document has one entry per position of the term, and all of them are needed.
+                ixscan->shouldDedup = false;
+
+                phraseScanList.push_back(std::move(ixscan));
+                phraseTermScans.push_back({phrase, phraseTerm.offset});
+            }
+        }
+
+        if (!phraseTermScans.empty()) {
+            auto otherLanguageScan = std::make_unique<IndexScanNode>(tn->index);
+            otherLanguageScan->bounds.startKey =
+                fts::FTSIndexFormat::getOtherLanguageIndexKey(tn->indexPrefix, textIndexVersion);
+            otherLanguageScan->bounds.endKey = otherLanguageScan->bounds.startKey;
+            otherLanguageScan->bounds.boundInclusion = BoundInclusion::kIncludeBothStartAndEndKeys;
+            otherLanguageScan->bounds.isSimpleRange = true;
+            otherLanguageScan->direction = 1;
+            phraseScanList.insert(phraseScanList.begin(), std::move(otherLanguageScan));
+        }
+    }
+
+    // If the query requires the "textScore" field, involves multiple search terms, or has phrases
+    // to check from the index, a TEXT_OR or OR stage is needed. Otherwise, we can use a single
+    // index scan directly.
+    const bool needOrStage = tn->wantTextScore || query->getTermsForBounds().size() > 1 ||
+        !phraseTermScans.empty();
+
     // Get all the index scans for each term in our query.
     std::vector<std::unique_ptr<QuerySolutionNode>> indexScanList;
     indexScanList.reserve(query->getTermsForBounds().size());
@@ -670,8 +718,8 @@ void buildTextSubPlan(TextMatchNode* tn) {
     }
 
     // Build the union of the index scans as a TEXT_OR or an OR stage, depending on whether the
-    // projection requires the "textScore" $meta field.
-    if (tn->wantTextScore) {
+    // projection requires the "textScore" $meta field or phrases are checked from the index.
+    if (tn->wantTextScore || !phraseTermScans.empty()) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
         // compute their text scores. This is a blocking operation.
         auto textScorer = std::make_unique<TextOrNode>();
@@ -679,6 +727,10 @@ void buildTextSubPlan(TextMatchNode* tn) {
         for (auto&& ixscan : indexScanList) {
             textScorer->children.push_back(ixscan.release());
         }
+        for (auto&& ixscan : phraseScanList) {
+            textScorer->children.push_back(ixscan.release());
+        }
+        textScorer->phraseTermScans = std::move(phraseTermScans);
 
         tn->children.push_back(textScorer.release());
     } else {
@@ -1314,13 +1366,16 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::buildIndexedAnd(
     if (ixscanNodes.size() == 1) {
         andResult = std::move(ixscanNodes[0]);
     } else {
-        // $** indexes are prohibited from participating in either AND_SORTED or AND_HASH.
+        // $** indexes may only participate in AND_SORTED. A scan of a single point of a $**
+        // index, i.e. of an equality predicate on a single path, returns RecordIds in order like
+        // any other index, so the predicates on several paths can be intersected without fetching.
         const bool wildcardIndexInvolvedInIntersection =
             std::any_of(ixscanNodes.begin(), ixscanNodes.end(), [](const auto& ixScan) {
                 return ixScan->getType() == StageType::STAGE_IXSCAN &&
                     static_cast<IndexScanNode*>(ixScan.get())->index.type == INDEX_WILDCARD;
             });
-        if (wildcardIndexInvolvedInIntersection) {
+        if (wildcardIndexInvolvedInIntersection &&
+            !internalQueryPlannerEnableWildcardIndexIntersection.load()) {
             return nullptr;
         }
 
@@ -1336,6 +1391,8 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::buildIndexedAnd(
             auto asn = std::make_unique<AndSortedNode>();
             asn->addChildren(std::move(ixscanNodes));
             andResult = std::move(asn);
+        } else if (wildcardIndexInvolvedInIntersection) {
+            return nullptr;
         } else if (internalQueryPlannerEnableHashIntersection.load()) {
             {
                 auto ahn = std::make_unique<AndHashNode>();
@@ -1617,6 +1674,75 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeIndexSkipScan(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    invariant(index.type == INDEX_BTREE);
+    invariant(index.keyPattern.nFields() >= 2);
+
+    // Rate a copy of the query against 'index' alone, so that the usual compatibility rules decide
+    // which predicates on the second field can generate bounds.
+    auto ratedTree = query.root()->shallowClone();
+    QueryPlannerIXSelect::rateIndices(ratedTree.get(), "", {index}, query.getCollator());
+
+    std::vector<const MatchExpression*> conjuncts;
+    if (MatchExpression::AND == ratedTree->matchType()) {
+        for (size_t i = 0; i < ratedTree->numChildren(); ++i) {
+            conjuncts.push_back(ratedTree->getChild(i));
+        }
+    } else {
+        conjuncts.push_back(ratedTree.get());
+    }
+
+    BSONObjIterator kpIt(index.keyPattern);
+    const BSONElement leadingElt = kpIt.next();
+    const BSONElement secondElt = kpIt.next();
+
+    // Bounds from several predicates on a multikey path cannot be intersected.
+    const bool canIntersect = !index.multikey ||
+        (!index.multikeyPaths.empty() && index.multikeyPaths[1].empty());
+
+    OrderedIntervalList secondOil;
+    bool hasSecondBounds = false;
+    for (auto&& conjunct : conjuncts) {
+        auto rt = static_cast<const RelevantTag*>(conjunct->getTag());
+        if (!rt || rt->path != secondElt.fieldNameStringData() ||
+            std::find(rt->notFirst.begin(), rt->notFirst.end(), 0U) == rt->notFirst.end()) {
+            continue;
+        }
+
+        // The fetch below applies the whole filter, so the tightness of the bounds is irrelevant.
+        IndexBoundsBuilder::BoundsTightness tightness;
+        if (!hasSecondBounds) {
+            IndexBoundsBuilder::translate(conjunct, secondElt, index, &secondOil, &tightness);
+            hasSecondBounds = true;
+        } else if (canIntersect) {
+            IndexBoundsBuilder::translateAndIntersect(
+                conjunct, secondElt, index, &secondOil, &tightness);
+        }
+    }
+    if (!hasSecondBounds) {
+        return nullptr;
+    }
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+    isn->bounds.fields.resize(index.keyPattern.nFields());
+    IndexBoundsBuilder::allValuesForField(leadingElt, &isn->bounds.fields[0]);
+    secondOil.name = secondElt.fieldName();
+    isn->bounds.fields[1] = std::move(secondOil);
+    size_t pos = 2;
+    while (kpIt.more()) {
+        IndexBoundsBuilder::allValuesForField(kpIt.next(), &isn->bounds.fields[pos++]);
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch;
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  std::unique_ptr<MatchExpression> match,
                                                  MatchExpression::MatchType type) {
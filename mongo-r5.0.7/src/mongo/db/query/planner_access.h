@@ -112,6 +112,17 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Returns a plan which scans 'index' over all values of its leading field, and over the bounds
+     * generated by the query's top-level predicates on the index's second field. The index scan
+     * seeks from one leading value to the next past any keys which are out of bounds, so it reads
+     * roughly as many keys as there are distinct leading values plus matching keys. Returns
+     * nullptr if the query has no predicate which can generate such bounds.
+     */
+    static std::unique_ptr<QuerySolutionNode> makeIndexSkipScan(const IndexEntry& index,
+                                                                const CanonicalQuery& query,
+                                                                const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
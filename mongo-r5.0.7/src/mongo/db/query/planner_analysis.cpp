@@ -36,6 +36,7 @@
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
@@ -561,6 +562,41 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         && !splitLimitedSortEligible;
 }
 
+/**
+ * If 'sortNode' has a limit and sorts by text score alone, and its input is a TEXT_MATCH stage that
+ * cannot reject any document scored by the TEXT_OR stage below it, lets the TEXT_OR stage know that
+ * only the documents with the highest scores are needed.
+ */
+void pushLimitIntoTextOr(SortNode* sortNode) {
+    if (!sortNode->limit || sortNode->pattern.nFields() != 1 ||
+        !internalQueryTextOrUseTopK.load()) {
+        return;
+    }
+
+    if (!query_request_helper::isTextScoreMeta(sortNode->pattern.firstElement())) {
+        return;
+    }
+
+    auto child = sortNode->children[0];
+    if (child->getType() != STAGE_TEXT_MATCH || child->filter) {
+        return;
+    }
+
+    // The TEXT_MATCH stage only rejects documents to check phrases and negated terms, and positive
+    // terms when matching is case or diacritic sensitive.
+    auto textNode = static_cast<TextMatchNode*>(child);
+    auto query = dynamic_cast<const fts::FTSQueryImpl*>(textNode->ftsQuery.get());
+    if (!query || !query->getNegatedTerms().empty() || !query->getPositivePhr().empty() ||
+        !query->getNegatedPhr().empty() || query->getCaseSensitive() ||
+        query->getDiacriticSensitive()) {
+        return;
+    }
+
+    if (textNode->children.size() == 1 && textNode->children[0]->getType() == STAGE_TEXT_OR) {
+        static_cast<TextOrNode*>(textNode->children[0])->limit = sortNode->limit;
+    }
+}
+
 }  // namespace
 
 // static
@@ -904,6 +940,10 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNodeRaw->limit = 0;
     }
 
+    if (solnRoot == sortNodeRaw) {
+        pushLimitIntoTextOr(sortNodeRaw);
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
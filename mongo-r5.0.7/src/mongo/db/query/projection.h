@@ -137,6 +137,15 @@ public:
             _deps.metadataRequested.none() && !_deps.requiresDocument && !_deps.hasExpressions;
     }
 
+    /**
+     * Check if this an exclusion only projection, without expressions, metadata, or positional
+     * and find-only operators. An exclusion projection always requires the entire document.
+     */
+    bool isExclusionOnly() const {
+        return _type == ProjectType::kExclusion && !_deps.requiresMatchDetails &&
+            _deps.metadataRequested.none() && !_deps.hasExpressions;
+    }
+
 private:
     ProjectionPathASTNode _root;
     ProjectType _type;
@@ -337,6 +337,36 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    auto solnRoot = QueryPlannerAccess::makeIndexSkipScan(index, query, params);
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
+/**
+ * Returns true if 'index' can be skip-scanned for 'query': the query has no predicate on the
+ * leading field of the index, but does have one on its second field.
+ */
+bool isSkipScanCandidate(const IndexEntry& index,
+                         const CanonicalQuery& query,
+                         const stdx::unordered_set<std::string>& fields) {
+    if (index.type != INDEX_BTREE || index.sparse || index.keyPattern.nFields() < 2) {
+        return false;
+    }
+    if (index.filterExpr && !expression::isSubsetOf(query.root(), index.filterExpr)) {
+        return false;
+    }
+
+    BSONObjIterator kpIt(index.keyPattern);
+    const auto leadingField = kpIt.next().fieldName();
+    const auto secondField = kpIt.next().fieldName();
+    return !fields.count(leadingField) && fields.count(secondField);
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getFindCommandRequest().getSort().isPrefixOf(
         kp, SimpleBSONElementComparator::kInstance);
@@ -494,7 +524,15 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
     // Look up winning solution in cached solution's array.
     const auto& winnerCacheData = *cachedSoln.plannerData;
 
-    if (SolutionCacheData::WHOLE_IXSCAN_SOLN == winnerCacheData.solnType) {
+    if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: soln that skip-scans an index");
+        } else {
+            return {std::move(soln)};
+        }
+    } else if (SolutionCacheData::WHOLE_IXSCAN_SOLN == winnerCacheData.solnType) {
         // The solution can be constructed by a scan over the entire index.
         auto soln = buildWholeIXSoln(
             *winnerCacheData.tree->entry, query, params, winnerCacheData.wholeIXSolnDir);
@@ -1057,6 +1095,40 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // An index whose leading field has no predicate can still be used by skipping from one value of
+    // the leading field to the next, seeking straight to the bounds on the second field each time.
+    // Such a scan beats a collection scan when the leading field has few distinct values.
+    size_t numSkipScanSolns = 0;
+    if (internalQueryPlannerEnableIndexSkipScan.load() && hintedIndex.isEmpty() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (auto&& index : fullIndexList) {
+            if (out.size() >= params.maxIndexedSolutions) {
+                break;
+            }
+            if (!isSkipScanCandidate(index, query, fields)) {
+                continue;
+            }
+
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (soln) {
+                LOGV2_DEBUG(6194511,
+                            5,
+                            "Planner: outputting soln that skip-scans an index",
+                            "index"_attr = index.toString());
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+                soln->cacheData.reset(scd);
+
+                out.push_back(std::move(soln));
+                ++numSkipScanSolns;
+            }
+        }
+    }
+
     // If a projection exists, there may be an index that allows for a covered plan, even if none
     // were considered earlier.
     const auto projection = query.getProj();
@@ -1095,6 +1167,10 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collScanRequired = 0 == out.size();
+
+    // A skip scan reads every distinct value of the index's leading field, so unless another index
+    // applies, it has to compete with a collection scan.
+    bool collscanAsAlternative = canTableScan && out.size() > 0 && numSkipScanSolns == out.size();
     if (collScanRequired && !canTableScan) {
         return Status(ErrorCodes::NoQueryExecutionPlans,
                       "No indexed plans available, and running with 'notablescan'");
@@ -1109,7 +1185,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         return Status(ErrorCodes::NoQueryExecutionPlans, "No query solutions");
     }
 
-    if (possibleToCollscan && (collscanRequested || collScanRequired)) {
+    if (possibleToCollscan && (collscanRequested || collScanRequired || collscanAsAlternative)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
         if (!collscan && collScanRequired) {
             return Status(ErrorCodes::NoQueryExecutionPlans,
@@ -33,6 +33,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -1558,5 +1559,66 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+//
+// Index skip scan
+//
+
+TEST_F(QueryPlannerTest, SkipScanCompoundIndexWithoutPredicateOnLeadingField) {
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableIndexSkipScan",
+                                                    true};
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    // The skip scan must still compete with a collection scan.
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5}, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanIntersectsBoundsOnSecondFieldAndAlignsThem) {
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableIndexSkipScan",
+                                                    true};
+    addIndex(BSON("a" << 1 << "b" << -1 << "c" << 1));
+    runQuery(fromjson("{b: {$gt: 3, $lt: 7}, c: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {node: {ixscan: {pattern: {a: 1, b: -1, c: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[7,3,false,false]], "
+        " c: [['MinKey','MaxKey',true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenSecondFieldHasNoPredicate) {
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableIndexSkipScan",
+                                                    true};
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+    runQuery(fromjson("{c: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanOverSparseIndex) {
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableIndexSkipScan",
+                                                    true};
+    addIndex(BSON("a" << 1 << "b" << 1), false, true);
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, NoSkipScanWhenDisabled) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
 }  // namespace
 }  // namespace mongo
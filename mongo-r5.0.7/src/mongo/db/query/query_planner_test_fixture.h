@@ -41,6 +41,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/query_test_service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -242,6 +243,13 @@ protected:
 
     static const NamespaceString nss;
 
+    // Skip scans add a candidate to many plans which the tests expect to be collection scans, so
+    // they are disabled for the duration of each test, and the tests which exercise them enable
+    // them with a controller of their own. The server default is restored afterwards, so that
+    // other suites in the same binary still plan with it.
+    RAIIServerParameterControllerForTest indexSkipScanController{
+        "internalQueryPlannerEnableIndexSkipScan", false};
+
     QueryTestServiceContext serviceContext;
     ServiceContext::UniqueOperationContext opCtx;
     boost::intrusive_ptr<ExpressionContext> expCtx;
@@ -33,6 +33,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 
 namespace mongo {
@@ -819,10 +820,12 @@ TEST_F(QueryPlannerWildcardTest, PartialIndexWithExistsTrueFilterCanAnswerExiste
 // Index intersection tests.
 //
 
-TEST_F(QueryPlannerWildcardTest, WildcardIndexDoesNotParticipateInIndexIntersection) {
+TEST_F(QueryPlannerWildcardTest, WildcardIndexDoesNotParticipateInIndexIntersectionWhenDisabled) {
     // Enable both AND_SORTED and AND_HASH index intersection for this test.
     params.options |= QueryPlannerParams::INDEX_INTERSECTION;
     internalQueryPlannerEnableHashIntersection.store(true);
+    RAIIServerParameterControllerForTest controller{
+        "internalQueryPlannerEnableWildcardIndexIntersection", false};
 
     // Add two standard single-field indexes.
     addIndex(BSON("a" << 1));
@@ -892,6 +895,34 @@ TEST_F(QueryPlannerWildcardTest, WildcardIndexDoesNotParticipateInIndexIntersect
         "{fetch: {filter:{b:{$gt:10}}, node: {ixscan: {filter: null, pattern: {$_path:1, a:1}}}}}");
 }
 
+TEST_F(QueryPlannerWildcardTest, WildcardIndexPathsParticipateInSortedIndexIntersection) {
+    // Enable both AND_SORTED and AND_HASH index intersection for this test.
+    params.options |= QueryPlannerParams::INDEX_INTERSECTION;
+    RAIIServerParameterControllerForTest controller{"internalQueryPlannerEnableHashIntersection",
+                                                    true};
+    addWildcardIndex(BSON("$**" << 1));
+
+    // The scans of point predicates on two paths of the $** index are intersected.
+    runQuery(fromjson("{a:10, b:10}"));
+    assertNumSolutions(3U);
+    assertSolutionExists(
+        "{fetch: {filter: {b:10}, node: {ixscan: {filter: null, pattern: {$_path:1, a:1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a:10}, node: {ixscan: {filter: null, pattern: {$_path:1, b:1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {a:10, b:10}, node: {andSorted: {nodes: [{ixscan: {filter: null, "
+        "pattern: {$_path:1, a:1}}},{ixscan: {filter: null, pattern: {$_path:1, b:1}}}]}}}}");
+
+    // Scans of ranges do not return RecordIds in order, and $** indexes do not participate in
+    // AND_HASH.
+    runQuery(fromjson("{a:{$gt:10}, b:{$gt:10}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter:{a:{$gt:10}}, node: {ixscan: {filter: null, pattern: {$_path:1, b:1}}}}}");
+    assertSolutionExists(
+        "{fetch: {filter:{b:{$gt:10}}, node: {ixscan: {filter: null, pattern: {$_path:1, a:1}}}}}");
+}
+
 //
 // Wildcard and $text index tests.
 //
@@ -0,0 +1,302 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_result_cache_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryResultCache = ServiceContext::declareDecoration<QueryResultCache>();
+
+Counter64 resultCacheHits;
+Counter64 resultCacheMisses;
+Counter64 resultCacheEvictions;
+Counter64 resultCacheInvalidations;
+Counter64 resultCacheSizeBytes;
+ServerStatusMetricField<Counter64> resultCacheHitsMetric("query.resultCache.hits",
+                                                         &resultCacheHits);
+ServerStatusMetricField<Counter64> resultCacheMissesMetric("query.resultCache.misses",
+                                                           &resultCacheMisses);
+ServerStatusMetricField<Counter64> resultCacheEvictionsMetric("query.resultCache.evictions",
+                                                              &resultCacheEvictions);
+ServerStatusMetricField<Counter64> resultCacheInvalidationsMetric(
+    "query.resultCache.invalidations", &resultCacheInvalidations);
+ServerStatusMetricField<Counter64> resultCacheSizeBytesMetric("query.resultCache.sizeBytes",
+                                                              &resultCacheSizeBytes);
+
+// Rough per-entry bookkeeping cost, on top of the size of the key and of the cached documents.
+const size_t kEntryOverheadBytes = 256;
+
+/**
+ * The namespaces opted in to result caching, as parsed from 'internalQueryResultCacheNamespaces'.
+ * 'anyEnabled' lets the write path skip the latch while the cache is not in use.
+ */
+struct EnabledNamespaces {
+    Mutex mutex = MONGO_MAKE_LATCH("QueryResultCache::EnabledNamespaces::mutex");
+    StringSet namespaces;
+    AtomicWord<bool> anyEnabled{false};
+} enabledNamespaces;
+
+// The find command fields which determine the results of a query. All the other fields, e.g.
+// 'maxTimeMS', 'comment' or the read concern, only affect how the results are produced.
+const BSONObj kResultDeterminingFields = BSON("filter" << 1 << "projection" << 1 << "sort" << 1
+                                                       << "hint" << 1 << "collation" << 1
+                                                       << "skip" << 1 << "limit" << 1
+                                                       << "batchSize" << 1 << "ntoreturn" << 1
+                                                       << "singleBatch" << 1 << "min" << 1
+                                                       << "max" << 1 << "returnKey" << 1
+                                                       << "showRecordId" << 1 << "let" << 1);
+
+/**
+ * Returns true if 'obj' uses an operator or a system variable whose value may differ between two
+ * executions of the same query over the same data.
+ */
+bool containsNonDeterministicOperator(const BSONObj& obj) {
+    for (auto&& elt : obj) {
+        auto fieldName = elt.fieldNameStringData();
+        if (fieldName == "$where"_sd || fieldName == "$rand"_sd || fieldName == "$function"_sd ||
+            fieldName == "$accumulator"_sd || fieldName == "$sampleRate"_sd) {
+            return true;
+        }
+        if (elt.type() == BSONType::String) {
+            auto value = elt.valueStringData();
+            if (value.startsWith("$$NOW"_sd) || value.startsWith("$$CLUSTER_TIME"_sd)) {
+                return true;
+            }
+        }
+        if (elt.isABSONObj() && containsNonDeterministicOperator(elt.embeddedObject())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::get(ServiceContext* serviceContext) {
+    return getQueryResultCache(serviceContext);
+}
+
+QueryResultCache& QueryResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool QueryResultCache::isEnabledFor(const NamespaceString& nss) {
+    if (!enabledNamespaces.anyEnabled.load()) {
+        return false;
+    }
+    stdx::lock_guard<Latch> lk(enabledNamespaces.mutex);
+    return enabledNamespaces.namespaces.count(nss.ns()) > 0;
+}
+
+boost::optional<BSONObj> QueryResultCache::makeKey(const UUID& collectionUUID,
+                                                   const CanonicalQuery& cq) {
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (findCommand.getTailable() || findCommand.getAwaitData() ||
+        findCommand.getRequestResumeToken() || !findCommand.getResumeAfter().isEmpty() ||
+        findCommand.getTerm() || findCommand.getAllowSpeculativeMajorityRead()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder queryBob;
+    findCommand.toBSON(BSONObj()).filterFieldsUndotted(&queryBob, kResultDeterminingFields, true);
+    auto query = queryBob.obj();
+    if (containsNonDeterministicOperator(query)) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBob;
+    collectionUUID.appendToBuilder(&keyBob, "collectionUUID");
+    keyBob.append("query", query);
+    return keyBob.obj();
+}
+
+uint64_t QueryResultCache::getGeneration(const NamespaceString& nss) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _generations.find(nss.ns());
+    return _clearGeneration + (it == _generations.end() ? 0 : it->second);
+}
+
+QueryResultCache::Documents QueryResultCache::lookup(const BSONObj& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entriesByKey.find(key);
+    if (it == _entriesByKey.end()) {
+        resultCacheMisses.increment();
+        return nullptr;
+    }
+
+    // Move the entry to the front of the list, as the most recently used one.
+    _entries.splice(_entries.begin(), _entries, it->second);
+    resultCacheHits.increment();
+    return it->second->docs;
+}
+
+void QueryResultCache::insert(const NamespaceString& nss,
+                              const BSONObj& key,
+                              uint64_t generation,
+                              std::vector<BSONObj> docs) {
+    const auto maxSizeBytes = static_cast<size_t>(gInternalQueryResultCacheMaxSizeBytes.load());
+    size_t sizeBytes = kEntryOverheadBytes + key.objsize();
+    for (auto&& doc : docs) {
+        sizeBytes += doc.objsize() + sizeof(BSONObj);
+    }
+    if (sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    // Make the documents owned before taking the latch, they may point into the storage engine's
+    // buffers.
+    for (auto&& doc : docs) {
+        doc = doc.getOwned();
+    }
+    auto ownedKey = key.getOwned();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto genIt = _generations.find(nss.ns());
+    if (_clearGeneration + (genIt == _generations.end() ? 0 : genIt->second) != generation) {
+        // The collection has been written to since the results were read.
+        return;
+    }
+
+    if (auto it = _entriesByKey.find(ownedKey); it != _entriesByKey.end()) {
+        _erase(lk, it->second);
+    }
+
+    _entries.push_front(
+        {nss,
+         ownedKey,
+         std::make_shared<const std::vector<BSONObj>>(std::move(docs)),
+         sizeBytes});
+    _entriesByKey.emplace(ownedKey, _entries.begin());
+    _sizeBytes += sizeBytes;
+    resultCacheSizeBytes.increment(sizeBytes);
+
+    while (_sizeBytes > maxSizeBytes) {
+        _erase(lk, std::prev(_entries.end()));
+        resultCacheEvictions.increment();
+    }
+}
+
+void QueryResultCache::invalidate(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _invalidate(lk, nss);
+}
+
+void QueryResultCache::invalidateDatabase(StringData dbName) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // Collections of the database which have never been written to have no generation of their
+    // own, so bump the generation of every namespace.
+    ++_clearGeneration;
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto next = std::next(it);
+        if (it->nss.db() == dbName) {
+            _erase(lk, it);
+        }
+        it = next;
+    }
+    resultCacheInvalidations.increment();
+}
+
+void QueryResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_clearGeneration;
+    while (!_entries.empty()) {
+        _erase(lk, _entries.begin());
+    }
+    resultCacheInvalidations.increment();
+}
+
+size_t QueryResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+size_t QueryResultCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+void QueryResultCache::_invalidate(WithLock lk, const NamespaceString& nss) {
+    ++_generations[nss.ns()];
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto next = std::next(it);
+        if (it->nss == nss) {
+            _erase(lk, it);
+        }
+        it = next;
+    }
+    resultCacheInvalidations.increment();
+}
+
+void QueryResultCache::_erase(WithLock, EntryList::iterator it) {
+    _sizeBytes -= it->sizeBytes;
+    resultCacheSizeBytes.decrement(it->sizeBytes);
+    _entriesByKey.erase(it->key);
+    _entries.erase(it);
+}
+
+Status onUpdateQueryResultCacheNamespaces(const std::vector<std::string>& namespaces) {
+    {
+        stdx::lock_guard<Latch> lk(enabledNamespaces.mutex);
+        enabledNamespaces.namespaces = StringSet(namespaces.begin(), namespaces.end());
+        enabledNamespaces.anyEnabled.store(!namespaces.empty());
+    }
+
+    // Writes to the namespaces which were not opted in have not been tracked, so start over.
+    if (hasGlobalServiceContext()) {
+        QueryResultCache::get(getGlobalServiceContext()).clear();
+    }
+    return Status::OK();
+}
+
+Status validateQueryResultCacheNamespaces(const std::vector<std::string>& namespaces) {
+    try {
+        for (const auto& ns : namespaces) {
+            if (!NamespaceString(ns).isValid()) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "'" << ns << "' is not a valid namespace"};
+            }
+        }
+    } catch (...) {
+        return exceptionToStatus();
+    }
+    return Status::OK();
+}
+
+}  // namespace mongo
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+class OperationContext;
+class ServiceContext;
+class UUID;
+
+/**
+ * A cache of complete find command results for the collections opted in through the
+ * 'internalQueryResultCacheNamespaces' server parameter. It is meant for small, rarely written
+ * collections which serve the same queries over and over, e.g. catalog and configuration
+ * collections.
+ *
+ * Entries are keyed by the collection and the parts of the find command which determine its
+ * results, i.e. the query shape together with its constants. Only results which fit entirely in the
+ * first batch are cached, so that a hit can be answered without creating a cursor. The cache is
+ * bounded by 'internalQueryResultCacheMaxSizeBytes' and evicts the least recently used entries.
+ *
+ * Writes to a cached collection invalidate all of its entries when they commit; see
+ * QueryResultCacheOpObserver. Every namespace also has a generation which is bumped on each
+ * invalidation. A reader records the generation before it opens its storage snapshot and the
+ * results it computed are only inserted if the generation has not changed in the meantime, so that
+ * results read from a snapshot older than a committed write are never cached.
+ *
+ * This class is thread-safe.
+ */
+class QueryResultCache {
+public:
+    using Documents = std::shared_ptr<const std::vector<BSONObj>>;
+
+    static QueryResultCache& get(ServiceContext* serviceContext);
+    static QueryResultCache& get(OperationContext* opCtx);
+
+    /**
+     * Returns whether 'nss' has been opted in to result caching. This is cheap when no namespace
+     * has been opted in, so that write paths can call it unconditionally.
+     */
+    static bool isEnabledFor(const NamespaceString& nss);
+
+    /**
+     * Returns the cache key for the results of 'cq' over the collection 'collectionUUID', or
+     * boost::none if the results of the query may not be cached. Queries are not cacheable if they
+     * are tailable, or if they use operators whose results may change between executions over the
+     * same data, such as $rand, $where or $$NOW.
+     */
+    static boost::optional<BSONObj> makeKey(const UUID& collectionUUID, const CanonicalQuery& cq);
+
+    /**
+     * Returns the current generation of 'nss'. Must be called before the storage snapshot used to
+     * compute the results to be inserted for 'nss' is opened.
+     */
+    uint64_t getGeneration(const NamespaceString& nss) const;
+
+    /**
+     * Returns the cached results for 'key', or nullptr if there are none. Records a hit or a miss.
+     */
+    Documents lookup(const BSONObj& key);
+
+    /**
+     * Caches 'docs' as the results for 'key' over 'nss', unless 'nss' has been invalidated since
+     * 'generation' was obtained from getGeneration(), or the results do not fit in the cache.
+     */
+    void insert(const NamespaceString& nss,
+                const BSONObj& key,
+                uint64_t generation,
+                std::vector<BSONObj> docs);
+
+    /**
+     * Drops all the entries for 'nss', and bumps its generation.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Drops all the entries for collections in the database 'dbName', and bumps their generations.
+     */
+    void invalidateDatabase(StringData dbName);
+
+    /**
+     * Drops all the entries, and bumps the generation of every namespace.
+     */
+    void clear();
+
+    /**
+     * Returns the estimated number of bytes used by the cached results.
+     */
+    size_t getSizeBytes() const;
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        NamespaceString nss;
+        BSONObj key;
+        Documents docs;
+        size_t sizeBytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    void _invalidate(WithLock, const NamespaceString& nss);
+    void _erase(WithLock, EntryList::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryResultCache::_mutex");
+
+    // Entries in order of use, most recently used first.
+    EntryList _entries;
+    stdx::unordered_map<BSONObj,
+                        EntryList::iterator,
+                        SimpleBSONObjComparator::Hasher,
+                        SimpleBSONObjComparator::EqualTo>
+        _entriesByKey;
+
+    // Namespaces which have been invalidated at least once, keyed by their full name.
+    StringMap<uint64_t> _generations;
+
+    // Bumped when the whole cache is cleared, and added to the generation of every namespace.
+    uint64_t _clearGeneration = 0;
+
+    size_t _sizeBytes = 0;
+};
+
+/**
+ * Called when the 'internalQueryResultCacheNamespaces' server parameter is updated.
+ */
+Status onUpdateQueryResultCacheNamespaces(const std::vector<std::string>& namespaces);
+
+/**
+ * Validates the 'internalQueryResultCacheNamespaces' server parameter.
+ */
+Status validateQueryResultCacheNamespaces(const std::vector<std::string>& namespaces);
+
+}  // namespace mongo
@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Invalidates the cached results for 'nss' once the write unit of work of 'opCtx' commits. Readers
+ * which opened their snapshot before the commit recorded an older generation of 'nss', so they
+ * cannot cache their results after the invalidation either.
+ */
+void invalidateOnCommit(OperationContext* opCtx, const NamespaceString& nss) {
+    if (!QueryResultCache::isEnabledFor(nss)) {
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [serviceContext = opCtx->getServiceContext(), nss](boost::optional<Timestamp>) {
+            QueryResultCache::get(serviceContext).invalidate(nss);
+        });
+}
+
+}  // namespace
+
+void QueryResultCacheOpObserver::onDropIndex(OperationContext* opCtx,
+                                             const NamespaceString& nss,
+                                             OptionalCollectionUUID uuid,
+                                             const std::string& indexName,
+                                             const BSONObj& idxDescriptor) {
+    // A cached query may have hinted the index which is dropped.
+    invalidateOnCommit(opCtx, nss);
+}
+
+void QueryResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           std::vector<InsertStatement>::const_iterator begin,
+                                           std::vector<InsertStatement>::const_iterator end,
+                                           bool fromMigrate) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void QueryResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.nss);
+}
+
+void QueryResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          OptionalCollectionUUID uuid,
+                                          StmtId stmtId,
+                                          const OplogDeleteEntryArgs& args) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void QueryResultCacheOpObserver::onCollMod(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           const UUID& uuid,
+                                           const BSONObj& collModCmd,
+                                           const CollectionOptions& oldCollOptions,
+                                           boost::optional<IndexCollModInfo> indexInfo) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void QueryResultCacheOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                const std::string& dbName) {
+    opCtx->recoveryUnit()->onCommit(
+        [serviceContext = opCtx->getServiceContext(), dbName](boost::optional<Timestamp>) {
+            QueryResultCache::get(serviceContext).invalidateDatabase(dbName);
+        });
+}
+
+repl::OpTime QueryResultCacheOpObserver::onDropCollection(OperationContext* opCtx,
+                                                          const NamespaceString& collectionName,
+                                                          OptionalCollectionUUID uuid,
+                                                          std::uint64_t numRecords,
+                                                          CollectionDropType dropType) {
+    invalidateOnCommit(opCtx, collectionName);
+    return {};
+}
+
+void QueryResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                    const NamespaceString& fromCollection,
+                                                    const NamespaceString& toCollection,
+                                                    OptionalCollectionUUID uuid,
+                                                    OptionalCollectionUUID dropTargetUUID,
+                                                    std::uint64_t numRecords,
+                                                    bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+}
+
+void QueryResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                      const NamespaceString& fromCollection,
+                                                      const NamespaceString& toCollection,
+                                                      OptionalCollectionUUID uuid,
+                                                      OptionalCollectionUUID dropTargetUUID,
+                                                      bool stayTemp) {
+    invalidateOnCommit(opCtx, fromCollection);
+    invalidateOnCommit(opCtx, toCollection);
+}
+
+void QueryResultCacheOpObserver::onImportCollection(OperationContext* opCtx,
+                                                    const UUID& importUUID,
+                                                    const NamespaceString& nss,
+                                                    long long numRecords,
+                                                    long long dataSize,
+                                                    const BSONObj& catalogEntry,
+                                                    const BSONObj& storageMetadata,
+                                                    bool isDryRun) {
+    invalidateOnCommit(opCtx, nss);
+}
+
+void QueryResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                               const NamespaceString& collectionName,
+                                               OptionalCollectionUUID uuid) {
+    invalidateOnCommit(opCtx, collectionName);
+}
+
+void QueryResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                       const RollbackObserverInfo& rbInfo) {
+    // Rollback rewinds the data of any number of collections without going through the write
+    // paths above.
+    QueryResultCache::get(opCtx).clear();
+}
+
+}  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_request_helper.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString nss("testdb.testcoll");
+const NamespaceString otherNss("testdb.othercoll");
+
+boost::optional<BSONObj> makeKey(const UUID& uuid, const char* findCmdStr) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    auto findCommand = query_request_helper::makeFromFindCommandForTests(fromjson(findCmdStr));
+    auto cq = uassertStatusOK(
+        CanonicalQuery::canonicalize(opCtx.get(),
+                                     std::move(findCommand),
+                                     false,
+                                     nullptr,
+                                     ExtensionsCallbackNoop(),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures));
+    return QueryResultCache::makeKey(uuid, *cq);
+}
+
+BSONObj makeKey(int i) {
+    return BSON("collectionUUID" << 1 << "query" << BSON("filter" << BSON("a" << i)));
+}
+
+std::vector<BSONObj> makeDocs(int n) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < n; ++i) {
+        docs.push_back(BSON("_id" << i << "a" << std::string(100, 'x')));
+    }
+    return docs;
+}
+
+TEST(QueryResultCacheTest, LookupReturnsInsertedResults) {
+    QueryResultCache cache;
+    ASSERT_FALSE(cache.lookup(makeKey(1)));
+
+    cache.insert(nss, makeKey(1), cache.getGeneration(nss), makeDocs(3));
+    auto docs = cache.lookup(makeKey(1));
+    ASSERT(docs);
+    ASSERT_EQ(docs->size(), 3U);
+    ASSERT_BSONOBJ_EQ(docs->at(2), makeDocs(3)[2]);
+    ASSERT_FALSE(cache.lookup(makeKey(2)));
+}
+
+TEST(QueryResultCacheTest, InvalidateDropsOnlyEntriesOfNamespace) {
+    QueryResultCache cache;
+    cache.insert(nss, makeKey(1), cache.getGeneration(nss), makeDocs(1));
+    cache.insert(otherNss, makeKey(2), cache.getGeneration(otherNss), makeDocs(1));
+    ASSERT_EQ(cache.size(), 2U);
+
+    auto generation = cache.getGeneration(nss);
+    cache.invalidate(nss);
+    ASSERT_NE(cache.getGeneration(nss), generation);
+    ASSERT_FALSE(cache.lookup(makeKey(1)));
+    ASSERT(cache.lookup(makeKey(2)));
+    ASSERT_EQ(cache.size(), 1U);
+
+    cache.invalidateDatabase(nss.db());
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_EQ(cache.getSizeBytes(), 0U);
+}
+
+TEST(QueryResultCacheTest, ResultsReadBeforeInvalidationAreNotInserted) {
+    QueryResultCache cache;
+    auto generation = cache.getGeneration(nss);
+    cache.invalidate(nss);
+    cache.insert(nss, makeKey(1), generation, makeDocs(1));
+    ASSERT_FALSE(cache.lookup(makeKey(1)));
+
+    generation = cache.getGeneration(nss);
+    cache.clear();
+    cache.insert(nss, makeKey(1), generation, makeDocs(1));
+    ASSERT_FALSE(cache.lookup(makeKey(1)));
+
+    cache.insert(nss, makeKey(1), cache.getGeneration(nss), makeDocs(1));
+    ASSERT(cache.lookup(makeKey(1)));
+}
+
+TEST(QueryResultCacheTest, EvictsLeastRecentlyUsedEntriesOverBudget) {
+    RAIIServerParameterControllerForTest controller("internalQueryResultCacheMaxSizeBytes",
+                                                    4 * 1024);
+    QueryResultCache cache;
+    cache.insert(nss, makeKey(1), cache.getGeneration(nss), makeDocs(10));
+    cache.insert(nss, makeKey(2), cache.getGeneration(nss), makeDocs(10));
+    ASSERT(cache.lookup(makeKey(1)));
+
+    // Key 2 is now the least recently used entry, and makes room for key 3.
+    cache.insert(nss, makeKey(3), cache.getGeneration(nss), makeDocs(10));
+    ASSERT(cache.lookup(makeKey(1)));
+    ASSERT_FALSE(cache.lookup(makeKey(2)));
+    ASSERT(cache.lookup(makeKey(3)));
+    ASSERT_LTE(cache.getSizeBytes(), 4U * 1024);
+
+    // Results larger than the whole budget are never cached.
+    cache.insert(nss, makeKey(4), cache.getGeneration(nss), makeDocs(100));
+    ASSERT_FALSE(cache.lookup(makeKey(4)));
+    ASSERT(cache.lookup(makeKey(3)));
+}
+
+TEST(QueryResultCacheTest, KeyDependsOnlyOnResultDeterminingFields) {
+    auto uuid = UUID::gen();
+    auto key = makeKey(uuid, "{find: 'testcoll', filter: {a: 1}, sort: {b: 1}, '$db': 'testdb'}");
+    ASSERT(key);
+    ASSERT_BSONOBJ_EQ(*key,
+                      *makeKey(uuid,
+                               "{find: 'testcoll', filter: {a: 1}, sort: {b: 1}, maxTimeMS: 100, "
+                               "comment: 'c', '$db': 'testdb'}"));
+    ASSERT_BSONOBJ_NE(
+        *key, *makeKey(uuid, "{find: 'testcoll', filter: {a: 2}, sort: {b: 1}, '$db': 'testdb'}"));
+    ASSERT_BSONOBJ_NE(*key,
+                      *makeKey(UUID::gen(),
+                               "{find: 'testcoll', filter: {a: 1}, sort: {b: 1}, "
+                               "'$db': 'testdb'}"));
+}
+
+TEST(QueryResultCacheTest, NonDeterministicQueriesAreNotCacheable) {
+    auto uuid = UUID::gen();
+    ASSERT_FALSE(makeKey(uuid, "{find: 'testcoll', filter: {$where: 'true'}, '$db': 'testdb'}"));
+    ASSERT_FALSE(makeKey(
+        uuid, "{find: 'testcoll', filter: {$expr: {$lt: [{$rand: {}}, 0.5]}}, '$db': 'testdb'}"));
+    ASSERT_FALSE(makeKey(
+        uuid, "{find: 'testcoll', filter: {$expr: {$lt: ['$a', '$$NOW']}}, '$db': 'testdb'}"));
+    ASSERT_FALSE(
+        makeKey(uuid, "{find: 'testcoll', filter: {}, tailable: true, '$db': 'testdb'}"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -1344,6 +1344,14 @@ void TextOrNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString() << '\n';
     }
+    if (limit) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
+    if (!phraseTermScans.empty()) {
+        addIndent(ss, indent + 1);
+        *ss << "phraseTermScans = " << phraseTermScans.size() << '\n';
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -1357,6 +1365,8 @@ QuerySolutionNode* TextOrNode::clone() const {
     auto copy = std::make_unique<TextOrNode>();
     cloneBaseData(copy.get());
     copy->dedup = this->dedup;
+    copy->limit = this->limit;
+    copy->phraseTermScans = this->phraseTermScans;
     return copy.release();
 }
 
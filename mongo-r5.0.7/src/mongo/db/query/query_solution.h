@@ -1237,6 +1237,16 @@ struct TextOrNode : public OrNode {
 
     void appendToString(str::stream* ss, int indent) const override;
     QuerySolutionNode* clone() const override;
+
+    // If non-zero, only the 'limit' documents with the highest text scores are needed.
+    size_t limit = 0;
+
+    // With text indexes that store term positions, the last 'phraseTermScans.size()' children scan
+    // the positions of the terms of the positive phrases of the query, so that documents which
+    // cannot match the phrases are not fetched. Entry i describes the term scanned by the i-th of
+    // these children. They are preceded by a scan of the documents with strings in a language other
+    // than the default language of the index, whose positions are not indexed.
+    std::vector<fts::PhraseTermPosition> phraseTermScans;
 };
 
 struct TextMatchNode : public QuerySolutionNodeWithSortSet {
@@ -26,6 +26,9 @@
  *    exception statement from all source files in the program, then also delete
  *    it in the license file.
  */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/query/sbe_runtime_planner.h"
@@ -35,6 +38,7 @@
 #include "mongo/db/exec/trial_period_utils.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/query/plan_executor_sbe.h"
+#include "mongo/logv2/log.h"
 
 namespace mongo::sbe {
 namespace {
@@ -78,6 +82,58 @@ bool fetchNextDocument(plan_ranker::CandidatePlan* candidate,
     }
     return false;
 }
+
+/**
+ * Marks as failed the candidates without blocking stages which have been so much less productive,
+ * in results per storage read, than the leading candidate that they cannot win the trial run, so
+ * that the rest of the trial run is not spent on them. The leading candidate is never abandoned.
+ */
+void abandonOutperformedCandidates(
+    std::vector<plan_ranker::CandidatePlan>* candidates,
+    const std::vector<std::pair<PlanStage*, std::unique_ptr<TrialRunTracker>>>& trialRunTrackers,
+    size_t maxNumResults) {
+    auto readsOf = [&](size_t ix) {
+        return trialRunTrackers[ix].second->getMetric<TrialRunTracker::kNumReads>();
+    };
+
+    boost::optional<size_t> leaderIdx;
+    for (size_t ix = 0; ix < candidates->size(); ++ix) {
+        if ((*candidates)[ix].status.isOK() &&
+            (!leaderIdx ||
+             (*candidates)[ix].results.size() * readsOf(*leaderIdx) >
+                 (*candidates)[*leaderIdx].results.size() * readsOf(ix))) {
+            leaderIdx = ix;
+        }
+    }
+    if (!leaderIdx) {
+        return;
+    }
+
+    const auto leaderResults = (*candidates)[*leaderIdx].results.size();
+    for (size_t ix = 0; ix < candidates->size(); ++ix) {
+        auto&& candidate = (*candidates)[ix];
+        if (ix == *leaderIdx || !candidate.status.isOK() || candidate.exitedEarly ||
+            candidate.solution->hasBlockingStage) {
+            continue;
+        }
+        if (trial_period::isOutperformedByLeader(candidate.results.size(),
+                                                 readsOf(ix),
+                                                 leaderResults,
+                                                 readsOf(*leaderIdx),
+                                                 maxNumResults)) {
+            LOGV2_DEBUG(6194510,
+                        5,
+                        "Abandoning candidate plan outperformed during the trial run",
+                        "results"_attr = candidate.results.size(),
+                        "reads"_attr = readsOf(ix),
+                        "leaderResults"_attr = leaderResults,
+                        "leaderReads"_attr = readsOf(*leaderIdx));
+            candidate.root->close();
+            candidate.status = {ErrorCodes::QueryPlanKilled,
+                                "candidate plan was outperformed during the trial run"};
+        }
+    }
+}
 }  // namespace
 
 StatusWith<std::tuple<value::SlotAccessor*, value::SlotAccessor*, bool>>
@@ -181,6 +237,9 @@ std::vector<plan_ranker::CandidatePlan> BaseRuntimePlanner::collectExecutionStat
             done = done || candidateDone;
         }
         done = done || (numCandidatesFailedOrExitedEarly == candidates.size());
+        if (!done) {
+            abandonOutperformedCandidates(&candidates, trialRunTrackers, maxNumResults);
+        }
     }
 
     return candidates;
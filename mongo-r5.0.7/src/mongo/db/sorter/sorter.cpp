@@ -49,6 +49,7 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <exception>
 #include <snappy.h>
 #include <vector>
 
@@ -62,7 +63,10 @@
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -116,6 +120,23 @@ inline std::string myErrnoWithDescription() {
     return sb.str();
 }
 
+/**
+ * Returns the pool shared by all sorters of the process to sort and write runs in the background.
+ * It is inline so that every translation unit including this file uses the same pool.
+ */
+inline ThreadPool& backgroundSpillPool() {
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "SorterBackgroundSpill";
+        options.minThreads = 0;
+        options.maxThreads = 4;
+        auto pool = new ThreadPool(options);
+        pool->startup();
+        return pool;
+    }();
+    return *pool;
+}
+
 template <typename Data, typename Comparator>
 void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs) {
 #if defined(MONGO_CONFIG_DEBUG_BUILD) && !defined(_MSC_VER)
@@ -255,6 +276,12 @@ public:
         return {_fileStartOffset, _fileEndOffset, _originalChecksum};
     }
 
+    void setReadAheadBytes(size_t bytes) {
+        _readAheadBytes = bytes;
+        _readAheadBuffer.reset();
+        _readAheadLength = 0;
+    }
+
 private:
     /**
      * Attempts to refill the _bufferReader if it is empty. Expects _done to be false.
@@ -336,10 +363,36 @@ private:
                   str::stream() << "Current file offset (" << _fileCurrentOffset
                                 << ") greater than end offset (" << _fileEndOffset << ")");
 
-        _file->read(_fileCurrentOffset, size, out);
+        if (size >= _readAheadBytes) {
+            _file->read(_fileCurrentOffset, size, out);
+        } else {
+            if (_fileCurrentOffset < _readAheadStartOffset ||
+                _fileCurrentOffset + std::streamoff(size) >
+                    _readAheadStartOffset + std::streamoff(_readAheadLength)) {
+                _fillReadAheadBuffer(size);
+            }
+            memcpy(out, _readAheadBuffer.get() + (_fileCurrentOffset - _readAheadStartOffset), size);
+        }
         _fileCurrentOffset += size;
     }
 
+    /**
+     * Reads as much of the remaining range as the read-ahead budget allows, but at least 'size'
+     * bytes, starting at the current file offset.
+     */
+    void _fillReadAheadBuffer(size_t size) {
+        if (!_readAheadBuffer) {
+            _readAheadBuffer.reset(new char[_readAheadBytes]);
+        }
+
+        const size_t remaining = _fileEndOffset - _fileCurrentOffset;
+        _readAheadLength = std::max(size, std::min(_readAheadBytes, remaining));
+        invariant(_readAheadLength <= _readAheadBytes);
+
+        _file->read(_fileCurrentOffset, _readAheadLength, _readAheadBuffer.get());
+        _readAheadStartOffset = _fileCurrentOffset;
+    }
+
     const Settings _settings;
     bool _done = false;
 
@@ -352,6 +405,14 @@ private:
     std::streamoff _fileEndOffset;      // File offset at which the sorted data range ends.
     boost::optional<std::string> _dbName;
 
+    // Holds bytes read from the file ahead of the current offset, so that consecutive blocks of
+    // the sorted data range are fetched with one read rather than two reads per block. A budget of
+    // 0 disables read-ahead.
+    size_t _readAheadBytes = 0;
+    std::unique_ptr<char[]> _readAheadBuffer;
+    std::streamoff _readAheadStartOffset = 0;  // File offset of the first buffered byte.
+    size_t _readAheadLength = 0;               // Number of valid bytes in _readAheadBuffer.
+
     // Checksum value that is updated with each read of a data object from disk. We can compare
     // this value with _originalChecksum to check for data corruption if and only if the
     // FileIterator is exhausted.
@@ -367,6 +428,11 @@ private:
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The streams are merged with a tournament tree of losers: each internal node remembers the stream
+ * that lost the match played there, and the overall winner is kept separately. Advancing the winner
+ * replays only the matches on the path from its leaf to the root, which costs one comparison per
+ * level rather than the two per level a binary heap needs to sift down.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -380,37 +446,41 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _comp(comp) {
+        const size_t readAheadBytes = iters.empty()
+            ? 0
+            : std::min(static_cast<size_t>(internalSorterMaxReadAheadBytes.load()),
+                       opts.maxMemoryUsageBytes / iters.size());
+
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
+            iters[i]->setReadAheadBytes(readAheadBytes);
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _numLive = _streams.size();
+        _tree.resize(_streams.size());
+        _tree[0] = _streams.size() > 1 ? _playMatches(1) : 0;
     }
 
     ~MergeIterator() {
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
     }
 
     void openSource() {}
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _numLive > 1 || _streams[_tree[0]]->more()))
             return true;
 
         _remaining = 0;
@@ -424,21 +494,19 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        const size_t winner = _tree[0];
+        if (!_streams[winner]->advance()) {
+            // Release the exhausted stream so that its source is closed as soon as possible.
+            verify(_numLive > 1);
+            _streams[winner].reset();
+            _numLive--;
         }
+        _replayMatches(winner);
 
-        return _current->current();
+        return _streams[_tree[0]]->current();
     }
 
 
@@ -480,32 +548,62 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
+    /**
+     * Returns true if stream 'lhs' must be returned from before stream 'rhs'. Exhausted streams
+     * lose against every live stream, and ties are broken by stream position, which follows file
+     * order, to keep the merge stable.
+     */
+    bool _less(size_t lhs, size_t rhs) const {
+        if (!_streams[lhs] || !_streams[rhs])
+            return _streams[lhs] && !_streams[rhs];
+
+        dassertCompIsSane(_comp, _streams[lhs]->current(), _streams[rhs]->current());
+        int ret = _comp(_streams[lhs]->current(), _streams[rhs]->current());
+        if (ret)
+            return ret < 0;
 
-        template <typename Ptr>
-        bool operator()(const Ptr& lhs, const Ptr& rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
+        return lhs < rhs;
+    }
 
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
+    /**
+     * Plays all the matches of the subtree rooted at internal node 'node', recording the loser of
+     * each match in the tree, and returns the winner of the subtree. The tree is laid out like a
+     * binary heap with internal nodes 1..k-1 and the leaf for stream i at node k+i.
+     */
+    size_t _playMatches(size_t node) {
+        const size_t k = _streams.size();
+        if (node >= k)
+            return node - k;
+
+        const size_t left = _playMatches(2 * node);
+        const size_t right = _playMatches(2 * node + 1);
+        if (_less(right, left)) {
+            _tree[node] = left;
+            return right;
         }
+        _tree[node] = right;
+        return left;
+    }
 
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Replays the matches on the path from the leaf of stream 'winner' to the root after that
+     * stream has advanced or been exhausted.
+     */
+    void _replayMatches(size_t winner) {
+        for (size_t node = (winner + _streams.size()) / 2; node > 0; node /= 2) {
+            if (_less(_tree[node], winner))
+                std::swap(_tree[node], winner);
+        }
+        _tree[0] = winner;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    const Comparator _comp;
+    std::vector<std::shared_ptr<Stream>> _streams;  // Null once a stream is exhausted.
+    std::vector<size_t> _tree;  // _tree[0] is the current winner, _tree[1..k-1] the losers.
+    size_t _numLive = 0;        // Number of streams that are not yet exhausted.
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -552,6 +650,13 @@ public:
                        });
     }
 
+    ~NoLimitSorter() {
+        // The result of a background spill that is still in progress is no longer needed, but it
+        // must finish before the file it writes to is removed.
+        if (_backgroundSpill)
+            _backgroundSpill->waitNoThrow().ignore();
+    }
+
     void add(const Key& key, const Value& val) {
         invariant(!_done);
 
@@ -561,8 +666,8 @@ public:
         _memUsed += memUsage;
         this->_totalDataSizeSorted += memUsage;
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        if (_memUsed > _runMemoryLimit())
+            _spillRun();
     }
 
     void emplace(Key&& key, Value&& val) override {
@@ -574,14 +679,57 @@ public:
 
         _data.emplace_back(std::move(key), std::move(val));
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
-            spill();
+        if (_memUsed > _runMemoryLimit())
+            _spillRun();
+    }
+
+    void addAlreadySortedRun(Iterator* sortedData) override {
+        invariant(!_done);
+
+        sortedData->openSource();
+        ON_BLOCK_EXIT([&] { sortedData->closeSource(); });
+        if (!sortedData->more())
+            return;
+
+        // The run is appended to the same file as spills, so a background spill must not be
+        // writing to it concurrently.
+        _waitForBackgroundSpill();
+        _assertExtSortAllowed();
+
+        this->_numSpills++;
+        SortedFileWriter<Key, Value> writer(this->_opts, this->_file, _settings);
+        while (sortedData->more()) {
+            auto data = sortedData->next();
+            this->_totalDataSizeSorted +=
+                data.first.memUsageForSorter() + data.second.memUsageForSorter();
+            this->_numSorted++;
+            writer.addAlreadySorted(data.first, data.second);
+        }
+        this->_iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+    }
+
+    std::vector<std::shared_ptr<Iterator>> releaseSpilledRuns() override {
+        invariant(!std::exchange(_done, true));
+
+        spill();
+        auto runs = std::exchange(this->_iters, {});
+        std::move(_adoptedRuns.begin(), _adoptedRuns.end(), std::back_inserter(runs));
+        _adoptedRuns.clear();
+        return runs;
+    }
+
+    void addSpilledRuns(std::vector<std::shared_ptr<Iterator>> runs) override {
+        invariant(!_done);
+
+        this->_numSpills += runs.size();
+        std::move(runs.begin(), runs.end(), std::back_inserter(_adoptedRuns));
     }
 
     Iterator* done() {
         invariant(!std::exchange(_done, true));
 
-        if (this->_iters.empty()) {
+        _waitForBackgroundSpill();
+        if (this->_iters.empty() && _adoptedRuns.empty()) {
             sort();
             if (this->_opts.moveSortedDataIntoIterator) {
                 return new InMemIterator<Key, Value>(std::move(_data));
@@ -590,7 +738,9 @@ public:
         }
 
         spill();
-        return Iterator::merge(this->_iters, this->_opts, _comp);
+        auto runs = this->_iters;
+        runs.insert(runs.end(), _adoptedRuns.begin(), _adoptedRuns.end());
+        return Iterator::merge(runs, this->_opts, _comp);
     }
 
 private:
@@ -612,11 +762,87 @@ private:
         this->_numSorted += _data.size();
     }
 
+    void copyAdoptedRunsToFile() override {
+        for (auto&& run : std::exchange(_adoptedRuns, {})) {
+            this->_numSpills--;
+            addAlreadySortedRun(run.get());
+        }
+    }
+
     void spill() {
+        // Runs must be added to _iters in the order in which they were spilled.
+        _waitForBackgroundSpill();
+
         this->_numSpills++;
         if (_data.empty())
             return;
 
+        _assertExtSortAllowed();
+
+        sort();
+        this->_iters.push_back(_writeRun(_data, this->_opts, this->_file, _settings));
+
+        _memUsed = 0;
+    }
+
+    /**
+     * Returns the amount of memory the run being filled may use before it is spilled.
+     */
+    size_t _runMemoryLimit() const {
+        return this->_opts.spillInBackground ? this->_opts.maxMemoryUsageBytes / 2
+                                             : this->_opts.maxMemoryUsageBytes;
+    }
+
+    /**
+     * Spills the run being filled because it exceeded its memory limit. With spillInBackground,
+     * the run is handed to the background spill pool to be sorted and written, once the previous
+     * background spill (if any) has finished.
+     */
+    void _spillRun() {
+        if (!this->_opts.spillInBackground) {
+            spill();
+            return;
+        }
+
+        _waitForBackgroundSpill();
+        _assertExtSortAllowed();
+
+        this->_numSpills++;
+        this->_numSorted += _data.size();
+
+        auto data = std::exchange(_data, {});
+        _memUsed = 0;
+
+        auto pf = makePromiseFuture<std::shared_ptr<Iterator>>();
+        _backgroundSpill.emplace(std::move(pf.future));
+        sorter::backgroundSpillPool().schedule(
+            [this, data = std::move(data), promise = std::move(pf.promise)](Status status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(status);
+                    return;
+                }
+                promise.setWith([&] {
+                    STLComparator less(_comp);
+                    std::stable_sort(data.begin(), data.end(), less);
+                    return _writeRun(data, this->_opts, this->_file, _settings);
+                });
+            });
+    }
+
+    /**
+     * Waits for the background spill in progress, if any, and records its run. Rethrows any error
+     * the background spill encountered.
+     */
+    void _waitForBackgroundSpill() {
+        if (!_backgroundSpill)
+            return;
+
+        auto future = std::move(*_backgroundSpill);
+        _backgroundSpill.reset();
+        this->_iters.push_back(std::move(future).get());
+    }
+
+    void _assertExtSortAllowed() const {
         if (!this->_opts.extSortAllowed) {
             // This error message only applies to sorts from user queries made through the find or
             // aggregation commands. Other clients, such as bulk index builds, should suppress this
@@ -627,18 +853,21 @@ private:
                           << "Sort exceeded memory limit of " << this->_opts.maxMemoryUsageBytes
                           << " bytes, but did not opt in to external sorting.");
         }
+    }
 
-        sort();
-
-        SortedFileWriter<Key, Value> writer(this->_opts, this->_file, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+    /**
+     * Appends the already sorted 'data' to 'file' as a new run, consuming 'data'. Only touches its
+     * arguments, so that it may run on the background spill pool.
+     */
+    static std::shared_ptr<Iterator> _writeRun(std::deque<Data>& data,
+                                               const SortOptions& opts,
+                                               std::shared_ptr<typename Sorter<Key, Value>::File> file,
+                                               const Settings& settings) {
+        SortedFileWriter<Key, Value> writer(opts, std::move(file), settings);
+        for (; !data.empty(); data.pop_front()) {
+            writer.addAlreadySorted(data.front().first, data.front().second);
         }
-        Iterator* iteratorPtr = writer.done();
-
-        this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
-
-        _memUsed = 0;
+        return std::shared_ptr<Iterator>(writer.done());
     }
 
     const Comparator _comp;
@@ -646,6 +875,13 @@ private:
     bool _done = false;
     size_t _memUsed = 0;
     std::deque<Data> _data;  // Data that has not been spilled.
+
+    // Runs spilled by other sorters to their own files, merged with ours by done().
+    std::vector<std::shared_ptr<Iterator>> _adoptedRuns;
+
+    // At most one run is sorted and written in the background at a time. Resolves to its run once
+    // it has been written.
+    boost::optional<Future<std::shared_ptr<Iterator>>> _backgroundSpill;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -687,6 +923,13 @@ public:
         }
     }
 
+    boost::optional<Key> getCutoffKey() const override {
+        if (!_haveData) {
+            return boost::none;
+        }
+        return _best.first;
+    }
+
 private:
     void spill() {
         invariant(false, "LimitOneSorter does not spill to disk");
@@ -792,6 +1035,18 @@ public:
         return iterator;
     }
 
+    boost::optional<Key> getCutoffKey() const override {
+        // Once the in-memory heap is full, its root is the worst value we are keeping. Otherwise,
+        // fall back to the cutoff established by updateCutoff() during a previous spill, if any.
+        if (_data.size() == this->_opts.limit) {
+            return _data.front().first;
+        }
+        if (_haveCutoff) {
+            return _cutoff.first;
+        }
+        return boost::none;
+    }
+
 private:
     class STLComparator {
     public:
@@ -969,6 +1224,7 @@ Sorter<Key, Value>::Sorter(const SortOptions& opts, const std::string& fileName)
 template <typename Key, typename Value>
 typename Sorter<Key, Value>::PersistedState Sorter<Key, Value>::persistDataForShutdown() {
     spill();
+    copyAdoptedRunsToFile();
     this->_file->keep();
 
     std::vector<SorterRange> ranges;
@@ -119,11 +119,18 @@ struct SortOptions {
     // instead of copying.
     bool moveSortedDataIntoIterator;
 
+    // If set to true, runs that are spilled because in-memory usage exceeded the limit are sorted
+    // and written to disk on a background thread while more data is added. Only one run is spilled
+    // at a time, and each in-memory run is limited to half of maxMemoryUsageBytes so that the run
+    // being spilled and the run being filled together stay within the limit.
+    bool spillInBackground;
+
     SortOptions()
         : limit(0),
           maxMemoryUsageBytes(64 * 1024 * 1024),
           extSortAllowed(false),
-          moveSortedDataIntoIterator(false) {}
+          moveSortedDataIntoIterator(false),
+          spillInBackground(false) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -156,6 +163,11 @@ struct SortOptions {
         moveSortedDataIntoIterator = newMoveSortedDataIntoIterator;
         return *this;
     }
+
+    SortOptions& SpillInBackground(bool newSpillInBackground = true) {
+        spillInBackground = newSpillInBackground;
+        return *this;
+    }
 };
 
 /**
@@ -215,6 +227,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    // Allows an iterator that reads from disk to buffer up to 'bytes' bytes of its source ahead of
+    // the data it has returned, trading memory for fewer and larger reads. Ignored by iterators
+    // that do not read from disk.
+    virtual void setReadAheadBytes(size_t bytes) {}
+
 protected:
     SortIteratorInterface() {}  // can only be constructed as a base
 };
@@ -334,6 +351,45 @@ public:
      */
     virtual Iterator* done() = 0;
 
+    /**
+     * Returns the key which any further input must compare strictly better than in order to be
+     * retained by this sorter. Only sorters with a limit can establish such a key, and only once
+     * they have seen enough input; all other sorters return boost::none.
+     */
+    virtual boost::optional<Key> getCutoffKey() const {
+        return boost::none;
+    }
+
+    /**
+     * Appends the already sorted data from 'sortedData' to this sorter's file as a single spilled
+     * run, without sorting it or holding it in memory. Only sorters without a limit that are
+     * allowed to spill accept already sorted runs. Cannot be called after done().
+     */
+    virtual void addAlreadySortedRun(Iterator* sortedData) {
+        invariant(false, "Only NoLimitSorter accepts already sorted runs");
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Spills any data still held in memory and hands over all of this sorter's runs. The runs keep
+     * the files they are stored in alive. Cannot add more data afterwards, nor call done().
+     */
+    virtual std::vector<std::shared_ptr<Iterator>> releaseSpilledRuns() {
+        invariant(false, "Only NoLimitSorter releases its spilled runs");
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Merges the runs released by other sorters with the same comparator into the output of this
+     * one, reading them from the other sorters' files rather than copying them. They are only
+     * copied to this sorter's file if its data is persisted for shutdown. Cannot be called after
+     * done().
+     */
+    virtual void addSpilledRuns(std::vector<std::shared_ptr<Iterator>> runs) {
+        invariant(false, "Only NoLimitSorter accepts spilled runs");
+        MONGO_UNREACHABLE;
+    }
+
     virtual ~Sorter() {}
 
     size_t numSpills() const {
@@ -355,6 +411,12 @@ protected:
 
     virtual void spill() = 0;
 
+    /**
+     * Copies any runs stored in the files of other sorters to this sorter's file, so that all of
+     * its runs can be described by ranges of its file.
+     */
+    virtual void copyAdoptedRunsToFile() {}
+
     size_t _numSpills = 0;  // Keeps track of the number of times data was spilled to disk.
     size_t _numSorted = 0;  // Keeps track of the number of keys sorted.
     uint64_t _totalDataSizeSorted = 0;  // Keeps track of the total size of data sorted.
@@ -304,6 +304,17 @@ public:
             ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
                                         std::make_shared<IntIterator>(0, 10 * 1000 * 1000));
         }
+        {  // big, with read-ahead budgets both larger and smaller than a block
+            for (size_t readAheadBytes : {size_t(1024 * 1024), size_t(100)}) {
+                SortedFileWriter<IntWrapper, IntWrapper> sorter(opts, makeFile());
+                for (int i = 0; i < 1000 * 1000; i++)
+                    sorter.addAlreadySorted(i, -i);
+
+                std::shared_ptr<IWIterator> iter(sorter.done());
+                iter->setReadAheadBytes(readAheadBytes);
+                ASSERT_ITERATORS_EQUIVALENT(iter, std::make_shared<IntIterator>(0, 1000 * 1000));
+            }
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -358,6 +369,30 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 std::make_shared<LimitIterator>(10, std::make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test that ties keep input order with a number of inputs that is not a power of two
+            const int kNumInputs = 5;
+            std::vector<std::shared_ptr<IWIterator>> vec;
+            for (int input = 0; input < kNumInputs; input++) {
+                std::vector<IWPair> data;
+                for (int key = 0; key < 10; key += input % 3 + 1)
+                    data.push_back(IWPair(key, input));
+                vec.push_back(std::make_shared<sorter::InMemIterator<IntWrapper, IntWrapper>>(data));
+            }
+
+            std::vector<IWPair> expected;
+            for (int key = 0; key < 10; key++) {
+                for (int input = 0; input < kNumInputs; input++) {
+                    if (key % (input % 3 + 1) == 0)
+                        expected.push_back(IWPair(key, input));
+                }
+            }
+
+            std::shared_ptr<IWIterator> mergeIter(
+                IWIterator::merge(vec, SortOptions(), IWComparator()));
+            std::shared_ptr<IWIterator> expectedIter(
+                new sorter::InMemIterator<IntWrapper, IntWrapper>(expected));
+            ASSERT_ITERATORS_EQUIVALENT(mergeIter, expectedIter);
+        }
     }
 };
 
@@ -623,6 +658,18 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataLittleMemorySpilledInBackground : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return Parent::adjustSortOptions(opts).SpillInBackground();
+    }
+    size_t correctNumRanges() const override {
+        // Runs spilled in the background are limited to half of the memory budget.
+        return Parent::NUM_ITEMS * sizeof(IWPair) / (Parent::MEM_LIMIT / 2) + 1;
+    }
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -669,6 +716,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemorySpilledInBackground</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemorySpilledInBackground</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -696,6 +745,108 @@ public:
 
 mongo::unittest::OldStyleSuiteInitializer<SorterSuite> extSortTests;
 
+TEST(SorterCutoffKeyTest, NoLimitSorterHasNoCutoff) {
+    auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(SortOptions(), IWComparator(ASC)));
+    sorter->add(1, -1);
+    sorter->add(2, -2);
+    ASSERT_FALSE(sorter->getCutoffKey());
+}
+
+TEST(SorterCutoffKeyTest, LimitOneSorterCutoffIsBestSeen) {
+    auto sorter =
+        std::unique_ptr<IWSorter>(IWSorter::make(SortOptions().Limit(1), IWComparator(DESC)));
+    ASSERT_FALSE(sorter->getCutoffKey());
+    sorter->add(3, -3);
+    ASSERT_EQ(3, *sorter->getCutoffKey());
+    sorter->add(7, -7);
+    ASSERT_EQ(7, *sorter->getCutoffKey());
+    sorter->add(5, -5);
+    ASSERT_EQ(7, *sorter->getCutoffKey());
+}
+
+TEST(SorterCutoffKeyTest, TopKSorterCutoffIsWorstKept) {
+    auto sorter =
+        std::unique_ptr<IWSorter>(IWSorter::make(SortOptions().Limit(3), IWComparator(ASC)));
+    sorter->add(10, -10);
+    sorter->add(20, -20);
+    ASSERT_FALSE(sorter->getCutoffKey());
+    sorter->add(30, -30);
+    ASSERT_EQ(30, *sorter->getCutoffKey());
+    sorter->add(5, -5);
+    ASSERT_EQ(20, *sorter->getCutoffKey());
+    sorter->add(40, -40);
+    ASSERT_EQ(20, *sorter->getCutoffKey());
+}
+
+TEST(SorterAddAlreadySortedRunTest, RunIsMergedWithAddedData) {
+    unittest::TempDir tempDir("sorterAddAlreadySortedRunTests");
+    auto sorter = std::unique_ptr<IWSorter>(
+        IWSorter::make(SortOptions().TempDir(tempDir.path()).ExtSortAllowed(), IWComparator(ASC)));
+
+    for (int i = 9; i > 0; i -= 2) {
+        sorter->add(i, -i);
+    }
+
+    IntIterator evens(0, 10, 2);
+    sorter->addAlreadySortedRun(&evens);
+    ASSERT_EQ(1U, sorter->numSpills());
+
+    // An empty run is not written to disk.
+    EmptyIterator empty;
+    sorter->addAlreadySortedRun(&empty);
+    ASSERT_EQ(1U, sorter->numSpills());
+
+    ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                std::make_shared<IntIterator>(0, 10));
+}
+
+TEST(SorterAddSpilledRunsTest, RunsAreMergedWithoutBeingCopied) {
+    unittest::TempDir tempDir("sorterAddSpilledRunsTests");
+    const auto opts = SortOptions().TempDir(tempDir.path()).ExtSortAllowed();
+    auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+    for (int i = 9; i > 0; i -= 2) {
+        sorter->add(i, -i);
+    }
+
+    std::vector<std::shared_ptr<IWIterator>> runs;
+    {
+        auto other = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+        for (int i = 8; i >= 0; i -= 2) {
+            other->add(i, -i);
+        }
+        runs = other->releaseSpilledRuns();
+        ASSERT_EQ(1U, runs.size());
+    }
+
+    // The runs outlive the sorter which spilled them.
+    sorter->addSpilledRuns(std::move(runs));
+    ASSERT_EQ(1U, sorter->numSpills());
+    ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                std::make_shared<IntIterator>(0, 10));
+}
+
+TEST(SorterAddSpilledRunsTest, RunsAreCopiedWhenPersistingDataForShutdown) {
+    unittest::TempDir tempDir("sorterAddSpilledRunsTests");
+    const auto opts = SortOptions().TempDir(tempDir.path()).ExtSortAllowed();
+    IWSorter::PersistedState state;
+    {
+        auto sorter = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+        sorter->add(1, -1);
+
+        auto other = std::unique_ptr<IWSorter>(IWSorter::make(opts, IWComparator(ASC)));
+        other->add(0, 0);
+        sorter->addSpilledRuns(other->releaseSpilledRuns());
+
+        state = sorter->persistDataForShutdown();
+        ASSERT_EQ(2U, state.ranges.size());
+    }
+
+    auto sorter = std::unique_ptr<IWSorter>(
+        IWSorter::makeFromExistingRanges(state.fileName, state.ranges, opts, IWComparator(ASC)));
+    ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                std::make_shared<IntIterator>(0, 2));
+}
+
 /**
  * This suite includes test cases for resumable index builds where the Sorter is reconstructed from
  * state persisted to disk during a previous clean shutdown.
@@ -51,6 +51,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -584,6 +585,20 @@ protected:
         WT_SESSION* session = _session->getSession();
         int err = session->open_cursor(
             session, idx->uri().c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+
+        // EBUSY usually means that a checkpoint is writing out the empty table. Loading every key
+        // through a regular cursor costs far more than waiting for that checkpoint, because each
+        // insert then goes through the cache and gets written again by later checkpoints, so retry
+        // for a little while before falling back.
+        const auto deadline =
+            Date_t::now() + Milliseconds(gWiredTigerBulkCursorOpenMaxWaitMillis.load());
+        Milliseconds backoff{1};
+        while (err == EBUSY && Date_t::now() < deadline) {
+            _opCtx->sleepFor(backoff);
+            backoff = std::min(backoff * 2, Milliseconds(100));
+            err = session->open_cursor(
+                session, idx->uri().c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+        }
         if (!err)
             return cursor;
 
@@ -59,9 +59,13 @@
 #include "mongo/db/ttl_gen.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -71,6 +75,8 @@ namespace {
 
 const auto getTTLMonitor = ServiceContext::declareDecoration<std::unique_ptr<TTLMonitor>>();
 
+const Date_t kDawnOfTime = Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
+
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
@@ -81,6 +87,21 @@ Counter64 ttlDeletedDocuments;
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+
+// Catch-up metrics of the deletes done through TTL indexes.
+Counter64 ttlDeleteBatches;
+Counter64 ttlParallelIndexPasses;
+Counter64 ttlIncompleteIndexPasses;
+Counter64 ttlReplicationLagThrottles;
+
+ServerStatusMetricField<Counter64> ttlDeleteBatchesDisplay("ttl.deleteBatches", &ttlDeleteBatches);
+ServerStatusMetricField<Counter64> ttlParallelIndexPassesDisplay("ttl.parallelIndexPasses",
+                                                                 &ttlParallelIndexPasses);
+ServerStatusMetricField<Counter64> ttlIncompleteIndexPassesDisplay("ttl.incompleteIndexPasses",
+                                                                   &ttlIncompleteIndexPasses);
+ServerStatusMetricField<Counter64> ttlReplicationLagThrottlesDisplay(
+    "ttl.replicationLagThrottles", &ttlReplicationLagThrottles);
+
 using MtabType = TenantMigrationAccessBlocker::BlockerType;
 
 class TTLMonitor : public BackgroundJob {
@@ -172,6 +193,11 @@ public:
     }
 
 private:
+    bool _isShuttingDown() const {
+        stdx::lock_guard<Latch> lk(_stateMutex);
+        return _shuttingDown;
+    }
+
     /**
      * Gets all TTL specifications for every collection and deletes expired documents.
      */
@@ -194,6 +220,11 @@ private:
         // Perform a pass for every collection and index described as being TTL.
         for (const auto& [uuid, infos] : ttlInfos) {
             for (const auto& info : infos) {
+                // Leave the rest of the pass for later rather than adding to the replication lag.
+                if (replicationLagExceeded(opCtx)) {
+                    return;
+                }
+
                 // Skip collections that have not been made visible yet. The TTLCollectionCache
                 // already has the index information available, so we want to avoid removing it
                 // until the collection is visible.
@@ -247,53 +278,64 @@ private:
 
         uassertStatusOK(userAllowedWriteNS(opCtx, nss));
 
-        AutoGetCollection coll(opCtx, nss, MODE_IX);
-        // The collection with `uuid` might be renamed before the lock and the wrong namespace would
-        // be locked and looked up so we double check here.
-        if (!coll || coll->uuid() != uuid)
-            return;
+        boost::optional<ResourceConsumption::ScopedMetricsCollector> scopedMetrics;
+        boost::optional<IndexDeleteJob> indexDeleteJob;
+        {
+            AutoGetCollection coll(opCtx, nss, MODE_IX);
+            // The collection with `uuid` might be renamed before the lock and the wrong namespace
+            // would be locked and looked up so we double check here.
+            if (!coll || coll->uuid() != uuid)
+                return;
+
+            // TTL indexes are not compatible with capped collections.
+            invariant(!coll->isCapped());
+
+            if (MONGO_unlikely(hangTTLMonitorWithLock.shouldFail())) {
+                LOGV2(22534,
+                      "Hanging due to hangTTLMonitorWithLock fail point",
+                      "ttlPasses"_attr = ttlPasses.get());
+                hangTTLMonitorWithLock.pauseWhileSet(opCtx);
+            }
 
-        // TTL indexes are not compatible with capped collections.
-        invariant(!coll->isCapped());
+            if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
+                return;
+            }
 
-        if (MONGO_unlikely(hangTTLMonitorWithLock.shouldFail())) {
-            LOGV2(22534,
-                  "Hanging due to hangTTLMonitorWithLock fail point",
-                  "ttlPasses"_attr = ttlPasses.get());
-            hangTTLMonitorWithLock.pauseWhileSet(opCtx);
-        }
+            std::shared_ptr<TenantMigrationAccessBlocker> mtab;
+            if (coll.getDb() &&
+                nullptr !=
+                    (mtab = TenantMigrationAccessBlockerRegistry::get(opCtx->getServiceContext())
+                                .getTenantMigrationAccessBlockerForDbName(coll.getDb()->name(),
+                                                                          MtabType::kRecipient)) &&
+                mtab->checkIfShouldBlockTTL()) {
+                LOGV2_DEBUG(53768,
+                            1,
+                            "Postpone TTL of DB because of active tenant migration",
+                            "tenantMigrationAccessBlocker"_attr = mtab->getDebugInfo().jsonString(),
+                            "database"_attr = coll.getDb()->name());
+                return;
+            }
 
-        if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
-            return;
+            scopedMetrics.emplace(opCtx, nss.db().toString());
+
+            const auto& collection = coll.getCollection();
+            stdx::visit(
+                visit_helper::Overloaded{
+                    [&](const TTLCollectionCache::ClusteredId&) {
+                        deleteExpiredWithCollscan(opCtx, ttlCollectionCache, collection);
+                    },
+                    [&](const TTLCollectionCache::IndexName& indexName) {
+                        indexDeleteJob = prepareDeleteExpiredWithIndex(
+                            opCtx, ttlCollectionCache, collection, indexName);
+                    }},
+                info);
         }
 
-        std::shared_ptr<TenantMigrationAccessBlocker> mtab;
-        if (coll.getDb() &&
-            nullptr !=
-                (mtab = TenantMigrationAccessBlockerRegistry::get(opCtx->getServiceContext())
-                            .getTenantMigrationAccessBlockerForDbName(coll.getDb()->name(),
-                                                                      MtabType::kRecipient)) &&
-            mtab->checkIfShouldBlockTTL()) {
-            LOGV2_DEBUG(53768,
-                        1,
-                        "Postpone TTL of DB because of active tenant migration",
-                        "tenantMigrationAccessBlocker"_attr = mtab->getDebugInfo().jsonString(),
-                        "database"_attr = coll.getDb()->name());
-            return;
+        // Index deletes take the collection lock again for every batch, so that they do not hold
+        // it for the whole duration of a large backlog.
+        if (indexDeleteJob) {
+            deleteExpiredWithIndex(opCtx, *indexDeleteJob);
         }
-
-        ResourceConsumption::ScopedMetricsCollector scopedMetrics(opCtx, nss.db().toString());
-
-        const auto& collection = coll.getCollection();
-        stdx::visit(
-            visit_helper::Overloaded{
-                [&](const TTLCollectionCache::ClusteredId&) {
-                    deleteExpiredWithCollscan(opCtx, ttlCollectionCache, collection);
-                },
-                [&](const TTLCollectionCache::IndexName& indexName) {
-                    deleteExpiredWithIndex(opCtx, ttlCollectionCache, collection, indexName);
-                }},
-            info);
     }
 
     /**
@@ -318,26 +360,52 @@ private:
     }
 
     /**
-     * Removes documents from the collection using the specified TTL index after a sufficient
-     * amount of time has passed according to its expiry specification.
+     * Describes the deletion of the expired documents of one TTL index, split into contiguous
+     * ranges of the indexed date that can be deleted independently of each other.
+     */
+    struct IndexDeleteJob {
+        NamespaceStringOrUUID nsOrUUID;
+
+        // The namespace of the collection when the job was prepared, for logging.
+        NamespaceString nss;
+
+        std::string indexName;
+        std::string keyFieldName;
+        InternalPlanner::Direction direction;
+
+        // Every document whose indexed date is at or before this date is expired.
+        Date_t expirationDate;
+
+        // The oldest expired date found in the index when the job was prepared.
+        Date_t oldestExpiredDate;
+
+        // Start of each range, in increasing order. A range ends where the next one starts, and
+        // the last range ends at 'expirationDate' inclusively.
+        std::vector<Date_t> rangeStarts;
+    };
+
+    /**
+     * Checks that the specified TTL index can be used to remove expired documents and, if there are
+     * any, returns the job describing their removal.
      */
-    void deleteExpiredWithIndex(OperationContext* opCtx,
-                                TTLCollectionCache* ttlCollectionCache,
-                                const CollectionPtr& collection,
-                                std::string indexName) {
+    boost::optional<IndexDeleteJob> prepareDeleteExpiredWithIndex(
+        OperationContext* opCtx,
+        TTLCollectionCache* ttlCollectionCache,
+        const CollectionPtr& collection,
+        std::string indexName) {
         if (!collection->isIndexPresent(indexName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
-            return;
+            return boost::none;
         }
 
         BSONObj spec = collection->getIndexSpec(indexName);
         if (!spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
-            return;
+            return boost::none;
         }
 
         if (!collection->isIndexReady(indexName)) {
-            return;
+            return boost::none;
         }
 
         const BSONObj key = spec["key"].Obj();
@@ -346,7 +414,7 @@ private:
             LOGV2_ERROR(22540,
                         "key for ttl index can only have 1 field, skipping TTL job",
                         "index"_attr = spec);
-            return;
+            return boost::none;
         }
 
         LOGV2_DEBUG(22533,
@@ -359,14 +427,14 @@ private:
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOGV2_DEBUG(22535, 1, "index not found; skipping ttl job", "index"_attr = spec);
-            return;
+            return boost::none;
         }
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             LOGV2_ERROR(22541,
                         "special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = spec);
-            return;
+            return boost::none;
         }
 
         BSONElement secondsExpireElt = spec[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -376,27 +444,194 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = spec);
-            return;
+            return boost::none;
         }
 
-        const Date_t kDawnOfTime =
-            Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min());
         const auto expirationDate =
             safeExpirationDate(opCtx, collection, secondsExpireElt.safeNumberLong());
-        const BSONObj startKey = BSON("" << kDawnOfTime);
-        const BSONObj endKey = BSON("" << expirationDate);
         // The canonical check as to whether a key pattern element is "ascending" or
         // "descending" is (elt.number() >= 0).  This is defined by the Ordering class.
         const InternalPlanner::Direction direction = (key.firstElement().number() >= 0)
             ? InternalPlanner::Direction::FORWARD
             : InternalPlanner::Direction::BACKWARD;
 
+        // Find the oldest expired date in the index. It bounds the range to delete from below, and
+        // there is nothing to do when there is none.
+        BSONObj oldestKey;
+        auto probe = InternalPlanner::indexScan(opCtx,
+                                                &collection,
+                                                desc,
+                                                BSON("" << kDawnOfTime),
+                                                BSON("" << expirationDate),
+                                                BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                                direction);
+        if (probe->getNext(&oldestKey, nullptr) != PlanExecutor::ADVANCED ||
+            oldestKey.firstElement().type() != BSONType::Date) {
+            return boost::none;
+        }
+
+        IndexDeleteJob job{NamespaceStringOrUUID(collection->ns().db().toString(),
+                                                 collection->uuid()),
+                           collection->ns(),
+                           std::string(name),
+                           key.firstElement().fieldName(),
+                           direction,
+                           expirationDate,
+                           oldestKey.firstElement().date(),
+                           {kDawnOfTime}};
+
+        // A backlog spanning several TTL monitor periods is split into ranges of equal duration,
+        // each deleted by its own worker. Each range starts at a split point of the index, so the
+        // workers do not contend on the same keys.
+        const Milliseconds backlog = job.expirationDate - job.oldestExpiredDate;
+        const Milliseconds period = Seconds(ttlMonitorSleepSecs.load());
+        const int numWorkers = ttlMonitorMaxDeleteWorkersPerIndex.load();
+        if (numWorkers > 1 && backlog > period * 2) {
+            const Milliseconds rangeWidth = backlog / numWorkers;
+            for (int i = 1; i < numWorkers; ++i) {
+                job.rangeStarts.push_back(job.oldestExpiredDate + rangeWidth * i);
+            }
+        }
+        return job;
+    }
+
+    /**
+     * Removes the expired documents described by 'job', deleting its ranges on parallel threads
+     * when there is more than one.
+     */
+    void deleteExpiredWithIndex(OperationContext* opCtx, const IndexDeleteJob& job) {
+        Timer timer;
+        long long numDeleted = 0;
+        if (job.rangeStarts.size() == 1) {
+            numDeleted = deleteExpiredRange(opCtx, job, 0);
+        } else {
+            ttlParallelIndexPasses.increment();
+
+            AtomicWord<long long> totalDeleted{0};
+            const auto dbName = job.nsOrUUID.dbname();
+            std::vector<stdx::thread> workers;
+            for (size_t i = 0; i < job.rangeStarts.size(); ++i) {
+                workers.emplace_back([this, &job, &totalDeleted, dbName, i] {
+                    ThreadClient tc(name() + "-" + std::to_string(i),
+                                    getGlobalServiceContext());
+                    AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+                    {
+                        stdx::lock_guard<Client> lk(*tc.get());
+                        tc.get()->setSystemOperationKillableByStepdown(lk);
+                    }
+
+                    const auto workerOpCtx = cc().makeOperationContext();
+                    ResourceConsumption::ScopedMetricsCollector scopedMetrics(workerOpCtx.get(),
+                                                                              dbName);
+                    try {
+                        totalDeleted.fetchAndAdd(deleteExpiredRange(workerOpCtx.get(), job, i));
+                    } catch (const DBException& ex) {
+                        LOGV2_WARNING(6194500,
+                                      "Error deleting a range of expired documents",
+                                      "index"_attr = job.indexName,
+                                      "rangeStart"_attr = job.rangeStarts[i],
+                                      "error"_attr = ex);
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            numDeleted = totalDeleted.load();
+        }
+
+        const auto duration = Milliseconds(timer.millis());
+        if (shouldLogSlowOpWithSampling(opCtx,
+                                        logv2::LogComponent::kIndex,
+                                        duration,
+                                        Milliseconds(serverGlobalParams.slowMS))
+                .first) {
+            LOGV2(5479200,
+                  "Deleted expired documents using index",
+                  logAttrs(job.nss),
+                  "index"_attr = job.indexName,
+                  "numDeleted"_attr = numDeleted,
+                  "numRanges"_attr = job.rangeStarts.size(),
+                  "duration"_attr = duration);
+        }
+    }
+
+    /**
+     * Deletes the expired documents in the range 'rangeIdx' of 'job' and returns how many were
+     * deleted. The range is deleted in slices, each taking the collection lock anew, whose width
+     * adapts so that every slice deletes about ttlMonitorDeleteBatchSize documents.
+     */
+    long long deleteExpiredRange(OperationContext* opCtx,
+                                 const IndexDeleteJob& job,
+                                 size_t rangeIdx) {
+        const bool isLastRange = rangeIdx + 1 == job.rangeStarts.size();
+        const Date_t rangeEnd = isLastRange ? job.expirationDate : job.rangeStarts[rangeIdx + 1];
+        const long long batchSize = ttlMonitorDeleteBatchSize.load();
+
+        long long numDeleted = 0;
+        Date_t sliceStart = job.rangeStarts[rangeIdx];
+        Milliseconds sliceWidth = Seconds(ttlMonitorSleepSecs.load());
+        while (true) {
+            // The first range starts at the dawn of time, so slices are measured from the oldest
+            // expired date instead.
+            const Date_t sliceBase = std::max(sliceStart, job.oldestExpiredDate);
+            const bool isLastSlice = rangeEnd - sliceBase <= sliceWidth;
+            const Date_t sliceEnd = isLastSlice ? rangeEnd : sliceBase + sliceWidth;
+
+            auto sliceDeleted =
+                deleteExpiredSlice(opCtx, job, sliceStart, sliceEnd, isLastRange && isLastSlice);
+            if (!sliceDeleted) {
+                return numDeleted;
+            }
+            numDeleted += *sliceDeleted;
+
+            if (isLastSlice || _isShuttingDown()) {
+                return numDeleted;
+            }
+
+            sliceStart = sliceEnd;
+            if (*sliceDeleted < batchSize / 2) {
+                sliceWidth = std::min(sliceWidth * 2, rangeEnd - sliceStart);
+            } else if (*sliceDeleted > batchSize * 2 && sliceWidth > Milliseconds(1)) {
+                sliceWidth = sliceWidth / 2;
+            }
+
+            if (replicationLagExceeded(opCtx)) {
+                ttlIncompleteIndexPasses.increment();
+                return numDeleted;
+            }
+        }
+    }
+
+    /**
+     * Deletes the expired documents whose indexed date is in [sliceStart, sliceEnd), or in
+     * [sliceStart, sliceEnd] if 'includeEnd' is set. Returns boost::none if the deletion cannot
+     * proceed, for example because the collection or index was dropped or this node stepped down.
+     */
+    boost::optional<long long> deleteExpiredSlice(OperationContext* opCtx,
+                                                  const IndexDeleteJob& job,
+                                                  Date_t sliceStart,
+                                                  Date_t sliceEnd,
+                                                  bool includeEnd) {
+        AutoGetCollection coll(opCtx, job.nsOrUUID, MODE_IX);
+        if (!coll ||
+            !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, coll->ns())) {
+            return boost::none;
+        }
+
+        const auto& collection = coll.getCollection();
+        const IndexDescriptor* desc =
+            collection->getIndexCatalog()->findIndexByName(opCtx, job.indexName);
+        if (!desc) {
+            return boost::none;
+        }
+
         // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
         // queries for the expired documents correctly so that we do not delete documents that are
         // not actually expired when our snapshot changes during deletion.
-        const char* keyFieldName = key.firstElement().fieldName();
-        BSONObj query =
-            BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationDate));
+        BSONObj query = BSON(job.keyFieldName
+                             << BSON("$gte" << kDawnOfTime << "$lte" << job.expirationDate));
         auto findCommand = std::make_unique<FindCommandRequest>(collection->ns());
         findCommand->setFilter(query);
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(findCommand));
@@ -406,41 +641,59 @@ private:
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
 
-        Timer timer;
-        auto exec =
-            InternalPlanner::deleteWithIndexScan(opCtx,
-                                                 &collection,
-                                                 std::move(params),
-                                                 desc,
-                                                 startKey,
-                                                 endKey,
-                                                 BoundInclusion::kIncludeBothStartAndEndKeys,
-                                                 PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                 direction);
+        auto exec = InternalPlanner::deleteWithIndexScan(
+            opCtx,
+            &collection,
+            std::move(params),
+            desc,
+            BSON("" << sliceStart),
+            BSON("" << sliceEnd),
+            includeEnd ? BoundInclusion::kIncludeBothStartAndEndKeys
+                       : BoundInclusion::kIncludeStartKeyOnly,
+            PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+            job.direction);
 
         try {
             const auto numDeleted = exec->executeDelete();
             ttlDeletedDocuments.increment(numDeleted);
-
-            const auto duration = Milliseconds(timer.millis());
-            if (shouldLogSlowOpWithSampling(opCtx,
-                                            logv2::LogComponent::kIndex,
-                                            duration,
-                                            Milliseconds(serverGlobalParams.slowMS))
-                    .first) {
-                LOGV2(5479200,
-                      "Deleted expired documents using index",
-                      logAttrs(collection->ns()),
-                      "index"_attr = name,
-                      "numDeleted"_attr = numDeleted,
-                      "duration"_attr = duration);
-            }
+            ttlDeleteBatches.increment();
+            return numDeleted;
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor
             // is deleting an old document, so ignore this error.
+            return boost::none;
         }
     }
 
+    /**
+     * Returns true if the majority commit point lags more than ttlMonitorMaxReplicationLagSecs
+     * behind the last write applied on this node. The TTL monitor then leaves the remaining expired
+     * documents for a later pass instead of waiting, so that a stalled commit point, for example
+     * with a secondary of a PSA set down, does not hold up the monitor.
+     */
+    bool replicationLagExceeded(OperationContext* opCtx) {
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        const Seconds maxLag(ttlMonitorMaxReplicationLagSecs.load());
+        if (maxLag == Seconds(0) ||
+            replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+            return false;
+        }
+
+        const auto lag = replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime -
+            replCoord->getLastCommittedOpTimeAndWallTime().wallTime;
+        if (lag <= maxLag) {
+            return false;
+        }
+
+        ttlReplicationLagThrottles.increment();
+        LOGV2_DEBUG(6194501,
+                    1,
+                    "Replication lag is above the limit, postponing expired document deletion",
+                    "lag"_attr = lag,
+                    "maxLag"_attr = maxLag);
+        return true;
+    }
+
     /*
      * Removes expired documents from a collection clustered by _id using a bounded collection scan.
      */
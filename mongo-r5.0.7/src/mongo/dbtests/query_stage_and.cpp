@@ -1320,6 +1320,56 @@ public:
     }
 };
 
+// A child which falls far behind the target RecordId is repositioned with a seek rather than
+// stepped through every key in between.
+class QueryStageAndSortedSeeksLaggingChild : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        // Every document has foo == 1, but only every 50th has bar == 1.
+        for (int i = 0; i < 200; ++i) {
+            insert(BSON("foo" << 1 << "bar" << (i % 50 == 0 ? 1 : 2)));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto as = std::make_unique<AndSortedStage>(_expCtx.get(), &ws);
+
+        // bar == 1
+        auto params = makeIndexScanParams(&_opCtx, getIndex(BSON("bar" << 1), coll));
+        params.bounds.startKey = BSON("" << 1);
+        params.bounds.endKey = BSON("" << 1);
+        as->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+
+        // foo == 1
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("foo" << 1), coll));
+        params.bounds.startKey = BSON("" << 1);
+        params.bounds.endKey = BSON("" << 1);
+        as->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+
+        ASSERT_EQUALS(4, countResults(as.get()));
+
+        auto stats = as->getStats();
+        auto andStats = static_cast<const AndSortedStats*>(stats->specific.get());
+        ASSERT_EQUALS(3U, andStats->seeksToTarget);
+
+        // The scan over foo == 1 examines only a few keys before each seek, rather than all 200.
+        auto fooStats = static_cast<const IndexScanStats*>(stats->children[1]->specific.get());
+        ASSERT_EQUALS(4U, fooStats->seeks);
+        ASSERT_LT(fooStats->keysExamined, 30U);
+    }
+};
+
 
 class All : public OldStyleSuiteSpecification {
 public:
@@ -1345,6 +1395,7 @@ public:
         add<QueryStageAndSortedByLastChild>();
         add<QueryStageAndSortedFirstChildFetched>();
         add<QueryStageAndSortedSecondChildFetched>();
+        add<QueryStageAndSortedSeeksLaggingChild>();
     }
 };
 
@@ -48,9 +48,11 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace QueryStageCachedPlan {
 
@@ -168,6 +170,39 @@ public:
         ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
     }
 
+    /**
+     * Returns a mocked cached plan which returns the document {a: 8} to end its trial period, then
+     * does as many works without a result as a trial period of 'decisionWorks' would allow.
+     */
+    std::unique_ptr<MockStage> makeStallingPlan(const CollectionPtr& collection,
+                                                WorkingSet* ws,
+                                                size_t decisionWorks) {
+        BSONObj doc;
+        RecordId recordId;
+        auto cursor = collection->getCursor(&_opCtx);
+        while (auto record = cursor->next()) {
+            if (record->data.toBson()["a"].numberInt() == 8) {
+                doc = record->data.toBson().getOwned();
+                recordId = record->id;
+            }
+        }
+        ASSERT_FALSE(doc.isEmpty());
+
+        auto mockChild = std::make_unique<MockStage>(_expCtx.get(), ws);
+        WorkingSetID id = ws->allocate();
+        WorkingSetMember* member = ws->get(id);
+        member->recordId = recordId;
+        member->doc = {SnapshotId(), Document{doc}};
+        ws->transitionToRecordIdAndObj(id);
+        mockChild->enqueueAdvanced(id);
+        const size_t mockWorks =
+            static_cast<size_t>(internalQueryCacheEvictionRatio * decisionWorks);
+        for (size_t i = 0; i < mockWorks; i++) {
+            mockChild->enqueueStateCode(PlanStage::NEED_TIME);
+        }
+        return mockChild;
+    }
+
 protected:
     const ServiceContext::UniqueOperationContext _opCtxPtr = cc().makeOperationContext();
     OperationContext& _opCtx = *_opCtxPtr;
@@ -281,6 +316,137 @@ TEST_F(QueryStageCachedPlan, QueryStageCachedPlanHitMaxWorks) {
     ASSERT_EQ(cache->get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+/**
+ * Test that a cached plan which passes its trial period but then stops producing results is
+ * replanned mid-query, and that the new plan does not return results the old one already did.
+ */
+TEST_F(QueryStageCachedPlan, ReplansMidQueryWhenCachedPlanStopsProducingResults) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlanEvaluationMaxResults", 1);
+
+    AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+    ASSERT(collection);
+
+    // Query can be answered by either index on "a" or index on "b".
+    const std::unique_ptr<CanonicalQuery> cq =
+        canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 8}, b: 1}"));
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection.getCollection(), cq.get(), &plannerParams);
+
+    const size_t decisionWorks = 10;
+    const bool allowMidQueryReplanning = true;
+    CachedPlanStage cachedPlanStage(
+        _expCtx.get(),
+        collection.getCollection(),
+        &_ws,
+        cq.get(),
+        plannerParams,
+        decisionWorks,
+        makeStallingPlan(collection.getCollection(), &_ws, decisionWorks),
+        allowMidQueryReplanning);
+
+    NoopYieldPolicy yieldPolicy(_opCtx.getServiceContext()->getFastClockSource());
+    ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+    auto stats = static_cast<const CachedPlanStats*>(cachedPlanStage.getSpecificStats());
+    ASSERT_FALSE(stats->replanReason);
+
+    // Both matching documents are returned exactly once.
+    ASSERT_EQ(getNumResultsForStage(_ws, &cachedPlanStage, cq.get()), 2U);
+    ASSERT(stats->replanReason);
+}
+
+/**
+ * Test that a cached plan which stops producing results is not replanned mid-query unless the
+ * stage was told that it may do so.
+ */
+TEST_F(QueryStageCachedPlan, DoesNotReplanMidQueryUnlessAllowed) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlanEvaluationMaxResults", 1);
+
+    AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+    ASSERT(collection);
+
+    const std::unique_ptr<CanonicalQuery> cq =
+        canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 8}, b: 1}"));
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection.getCollection(), cq.get(), &plannerParams);
+
+    const size_t decisionWorks = 10;
+    CachedPlanStage cachedPlanStage(
+        _expCtx.get(),
+        collection.getCollection(),
+        &_ws,
+        cq.get(),
+        plannerParams,
+        decisionWorks,
+        makeStallingPlan(collection.getCollection(), &_ws, decisionWorks));
+
+    NoopYieldPolicy yieldPolicy(_opCtx.getServiceContext()->getFastClockSource());
+    ASSERT_OK(cachedPlanStage.pickBestPlan(&yieldPolicy));
+
+    // Only the mocked plan's single result is returned.
+    ASSERT_EQ(getNumResultsForStage(_ws, &cachedPlanStage, cq.get()), 1U);
+    auto stats = static_cast<const CachedPlanStats*>(cachedPlanStage.getSpecificStats());
+    ASSERT_FALSE(stats->replanReason);
+}
+
+/**
+ * Test that a query which yields while it is replanned mid-query still returns each matching
+ * document exactly once.
+ */
+TEST_F(QueryStageCachedPlan, YieldsWhileReplanningMidQuery) {
+    RAIIServerParameterControllerForTest maxResultsController(
+        "internalQueryPlanEvaluationMaxResults", 1);
+    RAIIServerParameterControllerForTest yieldIterationsController(
+        "internalQueryExecYieldIterations", 1);
+
+    AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+    ASSERT(collection);
+
+    auto cq = canonicalQueryFromFilterObj(opCtx(), nss, fromjson("{a: {$gte: 8}, b: 1}"));
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(&_opCtx, collection.getCollection(), cq.get(), &plannerParams);
+
+    auto ws = std::make_unique<WorkingSet>();
+    const size_t decisionWorks = 10;
+    const bool allowMidQueryReplanning = true;
+    auto cachedPlanStage = std::make_unique<CachedPlanStage>(
+        cq->getExpCtxRaw(),
+        collection.getCollection(),
+        ws.get(),
+        cq.get(),
+        plannerParams,
+        decisionWorks,
+        makeStallingPlan(collection.getCollection(), ws.get(), decisionWorks),
+        allowMidQueryReplanning);
+    auto cachedPlanStageRaw = cachedPlanStage.get();
+
+    // The executor runs the trial period, then yields on every work cycle, including those of
+    // the candidate plans while we replan mid-query.
+    auto statusWithPlanExecutor =
+        plan_executor_factory::make(std::move(cq),
+                                    std::move(ws),
+                                    std::move(cachedPlanStage),
+                                    &collection.getCollection(),
+                                    PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                    QueryPlannerParams::DEFAULT);
+    ASSERT_OK(statusWithPlanExecutor.getStatus());
+    auto exec = std::move(statusWithPlanExecutor.getValue());
+
+    std::vector<int> values;
+    BSONObj obj;
+    while (exec->getNext(&obj, nullptr) == PlanExecutor::ADVANCED) {
+        values.push_back(obj["a"].numberInt());
+    }
+    std::sort(values.begin(), values.end());
+    ASSERT(values == std::vector<int>({8, 9}));
+
+    auto stats = static_cast<const CachedPlanStats*>(cachedPlanStageRaw->getSpecificStats());
+    ASSERT(stats->replanReason);
+    ASSERT_GT(cachedPlanStageRaw->getCommonStats()->yields, 0U);
+}
+
 /**
  * Test the way cache entries are added (either "active" or "inactive") to the plan cache.
  */
@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
@@ -38,6 +40,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace QueryStageIxscan {
 namespace {
@@ -137,6 +140,25 @@ public:
         return new IndexScan(_expCtx.get(), _coll, params, &_ws, filter);
     }
 
+    IndexScan* createPointListIndexScan(const std::vector<int>& points, int direction) {
+        IndexCatalog* catalog = _coll->getIndexCatalog();
+        std::vector<const IndexDescriptor*> indexes;
+        catalog->findIndexesByKeyPattern(&_opCtx, BSON("x" << 1), false, &indexes);
+        ASSERT_EQ(indexes.size(), 1U);
+
+        IndexScanParams params(&_opCtx, indexes[0]);
+        params.direction = direction;
+
+        OrderedIntervalList oil("x");
+        for (int point : points) {
+            oil.intervals.push_back(Interval(BSON("" << point << "" << point), true, true));
+        }
+        params.bounds.fields.push_back(oil);
+
+        MatchExpression* filter = nullptr;
+        return new IndexScan(_expCtx.get(), _coll, params, &_ws, filter);
+    }
+
     static const char* ns() {
         return "unittest.QueryStageIxscan";
     }
@@ -317,6 +339,66 @@ public:
     }
 };
 
+// An index scan over a long list of points probes the index once per point.
+class QueryStageIxscanProbesLargePointList : public IndexScanTest {
+public:
+    void run() {
+        RAIIServerParameterControllerForTest controller("internalQueryIndexScanPointProbeThreshold",
+                                                        8);
+        setup();
+
+        for (int i = 0; i < 100; ++i) {
+            insert(BSON("_id" << i << "x" << i));
+        }
+        insert(BSON("_id" << 100 << "x" << 10));
+
+        // Look for the even values, and for a value which is not in the index.
+        std::vector<int> points;
+        for (int i = 0; i < 100; i += 2) {
+            points.push_back(i);
+        }
+        points.push_back(1000);
+
+        std::vector<int> expected;
+        for (int point : points) {
+            if (point < 100) {
+                expected.push_back(point);
+            }
+            if (point == 10) {
+                expected.push_back(point);
+            }
+        }
+
+        for (int direction : {1, -1}) {
+            std::vector<int> scanPoints = points;
+            std::vector<int> expectedKeys = expected;
+            if (direction == -1) {
+                std::reverse(scanPoints.begin(), scanPoints.end());
+                std::reverse(expectedKeys.begin(), expectedKeys.end());
+            }
+
+            std::unique_ptr<IndexScan> ixscan(createPointListIndexScan(scanPoints, direction));
+            std::vector<int> keys;
+            WorkingSetID id;
+            PlanStage::StageState state;
+            while ((state = ixscan->work(&id)) != PlanStage::IS_EOF) {
+                if (state == PlanStage::ADVANCED) {
+                    keys.push_back(_ws.get(id)->keyData[0].keyData.firstElement().numberInt());
+                    _ws.free(id);
+
+                    // The keys of the scan are not in RecordId order across points.
+                    ASSERT_FALSE(ixscan->canSeekToRecordId());
+                }
+            }
+            ASSERT(keys == expectedKeys);
+
+            const auto stats = static_cast<const IndexScanStats*>(ixscan->getSpecificStats());
+            ASSERT_EQ(stats->seeks, scanPoints.size());
+            ASSERT_EQ(stats->keysExamined, expectedKeys.size());
+        }
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_ixscan") {}
@@ -327,6 +409,7 @@ public:
         add<QueryStageIxscanInsertDuringSaveExclusive>();
         add<QueryStageIxscanInsertDuringSaveExclusive2>();
         add<QueryStageIxscanInsertDuringSaveReverse>();
+        add<QueryStageIxscanProbesLargePointList>();
     }
 };
 
@@ -543,6 +543,53 @@ TEST_F(QueryStageMultiPlanTest, MPSExplainAllPlans) {
     }
 }
 
+// Test that a candidate which is far less productive than the leading candidate stops being worked
+// before the end of the trial period, unless abandoning candidates is disabled.
+TEST_F(QueryStageMultiPlanTest, MPSAbandonsOutperformedCandidate) {
+    // Insert a document to create the collection.
+    insert(BSON("x" << 1));
+
+    auto runTrialPeriod = [&]() {
+        const int nDocs = 500;
+        auto ws = std::make_unique<WorkingSet>();
+        auto firstPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+        auto secondPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+        for (int i = 0; i < nDocs; ++i) {
+            addMember(firstPlan.get(), ws.get(), BSON("x" << 1));
+
+            // Make the second plan twenty times slower than the first.
+            addMember(secondPlan.get(), ws.get(), BSON("x" << 1));
+            for (int j = 0; j < 19; ++j) {
+                secondPlan->enqueueStateCode(PlanStage::NEED_TIME);
+            }
+        }
+
+        AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+        auto cq = makeCanonicalQuery(_opCtx.get(), nss, BSON("x" << 1));
+        auto mps = std::make_unique<MultiPlanStage>(_expCtx.get(), ctx.getCollection(), cq.get());
+        mps->addPlan(std::make_unique<QuerySolution>(), std::move(firstPlan), ws.get());
+        mps->addPlan(std::make_unique<QuerySolution>(), std::move(secondPlan), ws.get());
+
+        NoopYieldPolicy yieldPolicy(_clock);
+        ASSERT_OK(mps->pickBestPlan(&yieldPolicy));
+        ASSERT_EQ(*mps->bestPlanIdx(), 0);
+        return std::make_pair(mps->getChildren()[0]->getStats()->common.works,
+                              mps->getChildren()[1]->getStats()->common.works);
+    };
+
+    {
+        auto [winnerWorks, loserWorks] = runTrialPeriod();
+        ASSERT_LT(loserWorks, winnerWorks);
+    }
+
+    {
+        RAIIServerParameterControllerForTest controller("internalQueryPlanEvaluationAbandonRatio",
+                                                        0.0);
+        auto [winnerWorks, loserWorks] = runTrialPeriod();
+        ASSERT_EQ(loserWorks, winnerWorks);
+    }
+}
+
 // Test that the plan summary only includes stats from the winning plan.
 //
 // This is a regression test for SERVER-20111.
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#pragma once
+
 #include "mongo/bson/bsontypes.h"
 #include "mongo/idl/feature_flag.h"
 #include "mongo/idl/server_parameter.h"